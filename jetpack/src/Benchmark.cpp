@@ -4,12 +4,15 @@
 
 #include "Benchmark.h"
 #include <mutex>
+#include <map>
+#include <string>
 #include <iostream>
 #include <fmt/format.h>
 
 namespace jetpack::benchmark {
 
     static int64_t BENCH_STAT[BenchType::BENCH_END];
+    static std::map<std::string, int64_t> PASS_STAT_US;
     static std::mutex mutex_;
 
     const char* BenchTypeToCStr(BenchType t) {
@@ -44,6 +47,9 @@ namespace jetpack::benchmark {
             case BENCH_CODEGEN_STAGE:
                 return "CodeGen Stage";
 
+            case BENCH_OPTIMIZE:
+                return "Optimize";
+
             default:
                 return "Unknown";
 
@@ -55,6 +61,14 @@ namespace jetpack::benchmark {
         for (int i = 0; i < BENCH_END; i++) {
             std::cerr << fmt::format("{:<24} {}ms\n", BenchTypeToCStr(static_cast<BenchType>(i)), BENCH_STAT[i]);
         }
+        for (auto& tuple : PASS_STAT_US) {
+            std::cerr << fmt::format("  {:<22} {}ms\n", tuple.first, tuple.second / 1000);
+        }
+    }
+
+    void SubmitPass(const char* name, int64_t us) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        PASS_STAT_US[name] += us;
     }
 
     void BenchMarker::Submit() {
@@ -20,6 +20,7 @@ namespace jetpack::benchmark {
         BENCH_FINALIZE_SOURCEMAP,
         BENCH_FINALIZE_SOURCEMAP_2,
         BENCH_CODEGEN_STAGE,
+        BENCH_OPTIMIZE,
         BENCH_END,
     };
 
@@ -27,6 +28,12 @@ namespace jetpack::benchmark {
 
     void PrintReport();
 
+    /**
+     * The passes are fused into one traversal,
+     * the time of each is measured by the hooks.
+     */
+    void SubmitPass(const char* name, int64_t us);
+
     struct BenchMarker {
     public:
         inline explicit  BenchMarker(BenchType t) noexcept: type_(t) {
@@ -6,34 +6,81 @@
 
 #include <vector>
 #include <string>
+#include <optional>
 #include "tokenizer/Location.h"
+#include "utils/io/ChunkedBuffer.h"
 
 namespace jetpack {
 
+    /**
+     * A plain record, the name is an index into the names of the fragment.
+     */
     struct MappingItem {
     public:
-        inline MappingItem(const std::string& n,
-                           const SourceLocation& loc,
+        static constexpr int32_t NoName = -1;
+
+        inline MappingItem(const SourceLocation& loc,
                            int32_t dL,
-                           int32_t dC) noexcept:
-                name(n), origin(loc),
+                           int32_t dC,
+                           int32_t name = NoName) noexcept:
                 dist_line(dL),
-                dist_column(dC) {}
+                dist_column(dC),
+                file_id(loc.fileId),
+                origin_line(loc.start.line),
+                origin_column(loc.start.column),
+                name_index(name) {}
 
-        std::string        name;
-        SourceLocation origin;
-        int32_t        dist_line   = -1;
-        int32_t        dist_column = -1;
+        int32_t dist_line   = -1;
+        int32_t dist_column = -1;
+        int32_t file_id     = -1;
+        int32_t origin_line = 0;
+        int32_t origin_column = 0;
+        int32_t name_index  = NoName;
+
+    };
+
+    static_assert(sizeof(MappingItem) == 24, "fixed size");
+
+    /**
+     * The mappings of a fragment encoded to VLQ on their own,
+     * as if the fragment begins the output.
+     * The values are deltas, so only the first segment
+     * and the first one with a name are rewritten when they are spliced.
+     */
+    struct EncodedMappings {
+    public:
+        struct Segment {
+        public:
+            // the range in the vlq
+            std::size_t begin = 0;
+            std::size_t end = 0;
+            MappingItem item;
+
+        };
+
+        bool                   encoded = false;
+        std::string            vlq;
+        std::optional<Segment> first;
+        std::optional<Segment> first_named;
+
+        // valid if there is a segment
+        MappingItem last{SourceLocation::NoOrigin, -1, -1};
+        int32_t     last_name_index = MappingItem::NoName;
 
     };
 
     class CodeGenFragment {
     public:
-        std::string content;
+        io::ChunkedBuffer content;
         int32_t     line = 1;
         int32_t     column = 0;
         std::vector<MappingItem> mapping_items;
 
+        // the original names referenced by the mapping items
+        std::vector<std::string> names;
+
+        EncodedMappings encoded_mappings;
+
     };
 
 }
@@ -4,6 +4,7 @@
 
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
 #include "ModuleCompositor.h"
 #include "Benchmark.h"
 
@@ -18,16 +19,29 @@ namespace jetpack {
         }
     }
 
+    // the outputs smaller than it are written on the current thread
+    static constexpr uint64_t PARALLEL_WRITE_SIZE = 1024 * 1024;
+
+    CodeGenFragment& ModuleCompositor::SnippetFragment() {
+        if (!snippet_open_) {
+            fragments_.push_back(&owned_fragments_.emplace_back());
+            snippet_open_ = true;
+        }
+        return *fragments_.back();
+    }
+
     void ModuleCompositor::Write(const std::string& content) {
-        writer_.WriteS(content);
-        column_ += UTF16LenOfUtf8(content);
+        auto& fragment = SnippetFragment();
+        fragment.content.Append(content);
+        fragment.column += UTF16LenOfUtf8(content);
     }
 
     void ModuleCompositor::WriteLineEnd() {
         if (!config_.minify) {
-            writer_.Write(config_.line_end);
-            line_++;
-            column_ = 0;
+            auto& fragment = SnippetFragment();
+            fragment.content.Append(config_.line_end);
+            fragment.line++;
+            fragment.column = 0;
         }
     }
 
@@ -35,40 +49,104 @@ namespace jetpack {
         thread_pool_.enqueue([sg] {
             sg->WriteSources();
         });
+        sourcemap_generator_ = std::move(sg);
+        StreamFragments();
     }
 
-    ModuleCompositor& ModuleCompositor::Append(const CodeGenFragment& fragment) {
-        const auto copy_column = column_;
-        const auto copy_line = line_;
-        thread_pool_.enqueue([this, fragment, copy_column, copy_line] {
-            for (const auto& item : fragment.mapping_items) {
-                auto item_copy = item;
-                if (item_copy.dist_line == 1) {  // first line
-                    item_copy.dist_column += copy_column;
-                }
-                item_copy.dist_line += copy_line - 1;
-                mapping_items_.push_back(item_copy);
-            }
-        });
+    void ModuleCompositor::StreamFragments() {
+        if (!sourcemap_generator_) {
+            return;
+        }
+        // the open snippet is still written
+        std::size_t end = snippet_open_ ? fragments_.size() - 1 : fragments_.size();
+        // in order on the sourcemap thread, while the js is written
+        for (; streamed_count_ < end; streamed_count_++) {
+            thread_pool_.enqueue([sg = sourcemap_generator_, fragment = fragments_[streamed_count_]] {
+                sg->AppendFragment(*fragment);
+            });
+        }
+    }
+
+    ModuleCompositor& ModuleCompositor::Append(CodeGenFragment& fragment) {
+        J_ASSERT(!finished_);
+        fragments_.push_back(&fragment);
+        snippet_open_ = false;
+        // the snippets before are closed too
+        StreamFragments();
+        return *this;
+    }
 
-        line_ += fragment.line - 1;
-        writer_.Write(fragment.content);
+    ModuleCompositor& ModuleCompositor::Append(CodeGenFragment&& fragment) {
+        return Append(owned_fragments_.emplace_back(std::move(fragment)));
+    }
 
-        if (fragment.line > 1) {
-            column_ = fragment.column;
+    void ModuleCompositor::WriteFragment(CodeGenFragment& fragment, uint64_t offset, char* dest) {
+        if (dest != nullptr) {
+            fragment.content.CopyTo(dest + offset);
+        }
+    }
+
+    io::IOError ModuleCompositor::Finish() {
+        if (finished_) {
+            return finish_error_;
+        }
+        finished_ = true;
+
+        // the prefix sums of the sizes
+        std::vector<uint64_t> offsets(fragments_.size());
+        uint64_t end = 0;
+        for (std::size_t i = 0; i < fragments_.size(); i++) {
+            offsets[i] = end;
+            end += fragments_[i]->content.Size();
+        }
+
+        // nullptr if the writer can't be written at offsets
+        writer_.SizeHint(end);
+        char* dest = writer_.Extend(end);
+
+        if (end < PARALLEL_WRITE_SIZE || fragments_.size() < 2) {
+            for (std::size_t i = 0; i < fragments_.size(); i++) {
+                WriteFragment(*fragments_[i], offsets[i], dest);
+            }
         } else {
-            column_ += fragment.column;
+            // hardware_concurrency() may be 0 if it's unknown
+            ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+            std::vector<std::future<void>> futures;
+            futures.reserve(fragments_.size());
+            for (std::size_t i = 0; i < fragments_.size(); i++) {
+                futures.push_back(pool.enqueue([fragment = fragments_[i], offset = offsets[i], dest] {
+                    WriteFragment(*fragment, offset, dest);
+                }));
+            }
+            for (auto& fut : futures) {
+                fut.get();
+            }
         }
 
-        return *this;
+        if (dest == nullptr) {
+            for (auto fragment : fragments_) {
+                if (auto err = writer_.WriteChunks(fragment->content); err != io::IOError::Ok) {
+                    finish_error_ = err;
+                    break;
+                }
+            }
+        }
+
+        return finish_error_;
     }
 
     std::future<void> ModuleCompositor::DumpSourcemap(Sp<SourceMapGenerator> sg) {
-        return thread_pool_.enqueue([this, sg] {
+        Finish();
+        snippet_open_ = false;
+        if (!sourcemap_generator_) {
+            sourcemap_generator_ = sg;
+        }
+        StreamFragments();
+        return thread_pool_.enqueue([sg] {
             benchmark::BenchMarker sourcemap_marker(benchmark::BENCH_FINALIZE_SOURCEMAP);
-            sg->Finalize(make_slice(mapping_items_));
+            sg->Finalize();
             sourcemap_marker.Submit();
         });
     }
 
-}
\ No newline at end of file
+}
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cinttypes>
+#include <deque>
 #include <ThreadPool.h>
 #include "utils/io/FileIO.h"
 #include "utils/string/UString.h"
@@ -17,13 +18,22 @@ namespace jetpack {
 
     /**
      * concat modules and re-mapping symbols
+     *
+     * The fragments are not copied when appended,
+     * they are written at their offsets in parallel by Finish().
      */
     class ModuleCompositor {
     public:
         explicit ModuleCompositor(io::Writer& writer, const CodeGenConfig& config):
         thread_pool_(1), writer_(writer), config_(config) {}
 
-        ModuleCompositor& Append(const CodeGenFragment& fragment);
+        /**
+         * The fragment should be alive until the sourcemap is dumped,
+         * its mappings are relative to itself.
+         */
+        ModuleCompositor& Append(CodeGenFragment& fragment);
+
+        ModuleCompositor& Append(CodeGenFragment&& fragment);
 
         void AddSnippet(const std::string& content);
 
@@ -31,8 +41,21 @@ namespace jetpack {
 
         void WriteLineEnd();
 
+        /**
+         * Write all the fragments, it's called once.
+         */
+        io::IOError Finish();
+
+        /**
+         * The mappings of the fragments are streamed to the generator
+         * as they are appended, after the sources.
+         * It's only called when the sourcemap is enabled.
+         */
         void DumpSources(Sp<SourceMapGenerator> sg);
 
+        /**
+         * Finish() is called if it's not.
+         */
         std::future<void> DumpSourcemap(Sp<SourceMapGenerator> sg);
 
         inline const CodeGenConfig& Config() const {
@@ -40,11 +63,27 @@ namespace jetpack {
         }
 
     private:
+        static void WriteFragment(CodeGenFragment& fragment, uint64_t offset, char* dest);
+
+        /**
+         * The fragment of the written snippets after the last appended one.
+         */
+        CodeGenFragment& SnippetFragment();
+
+        /**
+         * Pass the closed fragments to the sourcemap generator.
+         */
+        void StreamFragments();
+
         ThreadPool thread_pool_;
         io::Writer& writer_;
-        int32_t     line_ = 1;
-        int32_t     column_ = 0;
-        std::vector<MappingItem> mapping_items_;
+        std::vector<CodeGenFragment*> fragments_;
+        std::deque<CodeGenFragment> owned_fragments_;
+        bool snippet_open_ = false;
+        Sp<SourceMapGenerator> sourcemap_generator_;
+        std::size_t streamed_count_ = 0;
+        bool finished_ = false;
+        io::IOError finish_error_ = io::IOError::Ok;
         const CodeGenConfig& config_;
 
     };
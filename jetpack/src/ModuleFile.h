@@ -13,6 +13,7 @@
 #include "codegen/CodeGen.h"
 #include "CodeGenFragment.h"
 #include "sourcemap/MappingCollector.h"
+#include "sourcemap/InputSourceMap.h"
 #include "UniqueNameGenerator.h"
 #include "ResolveResult.h"
 
@@ -20,19 +21,19 @@ namespace jetpack {
     class ModuleResolver;
     class ModuleProvider;
 
+    /**
+     * Every module owns a slot indexed by its id,
+     * so the renaming threads never share a lock.
+     */
     struct RenamerCollection {
     public:
         std::vector<Sp<MinifyNameGenerator>> content;
         std::shared_ptr<UnresolvedNameCollector> idLogger;
 
-        inline void PushGenerator(const Sp<MinifyNameGenerator>& generator) {
-            std::lock_guard<std::mutex> lk(mutex_);
-            content.push_back(generator);
+        inline void SetGenerator(int32_t mod_id, const Sp<MinifyNameGenerator>& generator) {
+            content[mod_id] = generator;
         }
 
-    private:
-        std::mutex mutex_;
-
     };
 
     class ModuleFile {
@@ -62,6 +63,18 @@ namespace jetpack {
 
         Module* ast;
 
+        /**
+         * Collected in the parsing thread,
+         * merged into the resolver after all modules are parsed.
+         */
+        std::vector<Identifier*> unresolved_ids;
+
+        /**
+         * The callees replacing the `require()` calls in the parsing thread,
+         * named after the cjs_call_name of the required module when it's generated.
+         */
+        std::vector<std::pair<Identifier*, std::weak_ptr<ModuleFile>>> cjs_calls;
+
         /**
          * relative path -> absolute path
          */
@@ -69,11 +82,22 @@ namespace jetpack {
 
         Sp<MemoryViewOwner> src_content;
 
-        std::string escaped_content;
-
         std::string escaped_path;
 
-        CodeGenFragment codegen_fragment;
+        /**
+         * The map of the `sourceMappingURL` comment,
+         * its sources replace the module in the sourcemap.
+         */
+        std::unique_ptr<InputSourceMap> input_sourcemap;
+
+        // the index of the first source of the module in the sourcemap
+        int32_t sources_base = 0;
+
+        /**
+         * A huge module is generated in parts,
+         * they are concatenated in order.
+         */
+        std::vector<CodeGenFragment> codegen_fragments;
 
         /**
          * For Postorder traversal
@@ -81,7 +105,6 @@ namespace jetpack {
         std::vector<std::weak_ptr<ModuleFile>> ref_mods;
 
         void RenameInnerScopes(RenamerCollection& col);
-        Sp<MinifyNameGenerator> RenameInnerScopes(Scope& scope, UnresolvedNameCollector* idLogger);
 
         bool GetSource(WorkerError& error);
 
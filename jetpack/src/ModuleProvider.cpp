@@ -84,6 +84,17 @@ namespace jetpack {
         return result;
     }
 
+    Sp<MemoryViewOwner> FileModuleProvider::ResolveSourceMap(const ModuleFile &mf, const std::string &map_path) {
+        ghc::filesystem::path abs_path(base_path_);
+        abs_path.append(map_path);
+
+        std::string content;
+        if (io::ReadFileToStdString(abs_path.string(), content) != io::IOError::Ok) {
+            return nullptr;
+        }
+        return std::make_shared<StringMemoryOwner>(std::move(content));
+    }
+
     std::optional<ghc::filesystem::path> MemoryModuleProvider::Match(const ModuleFile &mf, const std::string &path) {
         if (path == token_) {
             return { path };
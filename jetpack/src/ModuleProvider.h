@@ -30,6 +30,14 @@ namespace jetpack {
 
         virtual Sp<MemoryViewOwner> ResolveWillThrow(const ModuleFile &mf, const std::string& resolved_path) = 0;
 
+        /**
+         * The sourcemap referenced by the module,
+         * nullptr if it's not provided.
+         */
+        virtual Sp<MemoryViewOwner> ResolveSourceMap(const ModuleFile &mf, const std::string& map_path) {
+            return nullptr;
+        }
+
         ~ModuleProvider() noexcept = default;
 
     };
@@ -43,6 +51,8 @@ namespace jetpack {
 
         Sp<MemoryViewOwner> ResolveWillThrow(const ModuleFile &mf, const std::string& resolved_path) override;
 
+        Sp<MemoryViewOwner> ResolveSourceMap(const ModuleFile &mf, const std::string& map_path) override;
+
     private:
         ghc::filesystem::path base_path_;
 
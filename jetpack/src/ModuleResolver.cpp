@@ -17,6 +17,12 @@
 #include "utils/io/FileIO.h"
 #include "parser/ParserCommon.h"
 #include "parser/NodesMaker.h"
+#include "optimize/DeadCodeElimination.h"
+#include "optimize/DefineSubstitution.h"
+#include "optimize/ConstantInlining.h"
+#include "optimize/SideEffects.h"
+#include "optimize/MinifyLiterals.h"
+#include "optimize/MinifySyntax.h"
 #include "ModuleResolver.h"
 #include "ModuleCompositor.h"
 #include "Benchmark.h"
@@ -30,6 +36,9 @@ static const char* COMMON_JS_CODE =
     "  return module.exports;\n"
     "};";
 
+// the modules larger than it are generated in parts
+static constexpr std::size_t CODEGEN_PART_SIZE = 512 * 1024;
+
 static HashSet<std::string> NODE_JS_BUILTIN_MODULE = {
     "assert", "buffer", "child_process", "cluster",
     "crypto", "dgram", "dns", "events", "fs", "http",
@@ -195,7 +204,10 @@ namespace jetpack {
                         u8path
                         );
                 auto new_call = mf->ast_context.Alloc<CallExpression>();
-                new_call->callee = MakeId(mf->ast_context, SourceLocation(-2, Position(), Position()), child_mod->cjs_call_name);
+                // named after all the modules are parsed
+                auto callee = MakeId(mf->ast_context, SourceLocation(-2, Position(), Position()), "");
+                new_call->callee = callee;
+                mf->cjs_calls.emplace_back(callee, child_mod);
                 return { new_call };
             });
         }
@@ -204,15 +216,46 @@ namespace jetpack {
         mf->ast = parser.ParseModule();
         bench.Submit();
 
-        std::vector<Identifier*> unresolved_ids;
-        mf->ast->scope->ResolveAllSymbols(&unresolved_ids);
+        // the defines are looked up by the resolved bindings
+        mf->ast->scope->ResolveAllSymbols(&mf->unresolved_ids);
 
-        id_logger_->InsertByList(unresolved_ids);
+        parsing_passes_.Run(mf->ast_context, mf->ast);
 
+        // the content is escaped when the sourcemap is written
         if (escape_file_) {
-            mf->escaped_content = EscapeJSONString(mf->src_content->View());
             mf->escaped_path = EscapeJSONString(mf->Path());
+            LoadInputSourceMap(mf);
+        }
+    }
+
+    void ModuleResolver::LoadInputSourceMap(const Sp<ModuleFile>& mf) {
+        auto url = InputSourceMap::FindURL(mf->src_content->View());
+        if (!url.has_value()) {
+            return;
+        }
+
+        ghc::filesystem::path module_dir = ghc::filesystem::path(mf->Path()).parent_path();
+        std::string map_dir = module_dir.generic_string();
+        std::string content;
+        if (auto data = InputSourceMap::DecodeDataURL(*url); data.has_value()) {
+            content = std::move(*data);
+        } else {
+            ghc::filesystem::path map_path = (module_dir / std::string(*url)).lexically_normal();
+            auto map_content = mf->provider->ResolveSourceMap(*mf, map_path.string());
+            if (map_content == nullptr) {
+                std::cerr << fmt::format("warning: sourcemap {} of {} is not found", map_path.string(), mf->Path()) << std::endl;
+                return;
+            }
+            content = std::string(map_content->View());
+            map_dir = map_path.parent_path().generic_string();
         }
+
+        auto input = std::make_unique<InputSourceMap>();
+        if (!input->Parse(content, map_dir)) {
+            std::cerr << fmt::format("warning: the sourcemap of {} is invalid", mf->Path()) << std::endl;
+            return;
+        }
+        mf->input_sourcemap = std::move(input);
     }
 
     Sp<ModuleFile> ModuleResolver::HandleNewLocationAdded(const jetpack::parser::Config &config,
@@ -239,12 +282,6 @@ namespace jetpack {
         childMod->provider = match_result.first;
         if (!!(flags & LocationAddOption::LocationIsCommonJS)) {
             childMod->SetIsCommonJS(true);
-            auto name = name_generator->Next("jp_require");
-            if (name.has_value()) {
-                childMod->cjs_call_name = *name;
-            } else {
-                childMod->cjs_call_name = "jp_require";
-            }
         }
         if (childMod->IsCommonJS()) {
             has_common_js_.store(true);
@@ -313,6 +350,20 @@ namespace jetpack {
                                          const std::string &resolvedPath) {
         auto thread_pool_size = std::thread::hardware_concurrency();
         thread_pool_ = std::make_unique<ThreadPool>(thread_pool_size);
+        constant_folding_ = config.constant_folding;
+
+        parsing_passes_ = PassManager();
+        parsing_passes_.SetProfile(profile_);
+        if (config.defines && !config.defines->Empty()) {
+            parsing_passes_.AddPass([defines = config.defines](AstContext& ctx) {
+                return std::make_unique<DefineSubstitution>(ctx, *defines);
+            });
+        }
+        if (config.constant_folding) {
+            parsing_passes_.AddPass([](AstContext& ctx) {
+                return std::make_unique<DeadCodeElimination>(ctx);
+            });
+        }
 
         benchmark::BenchMarker ps(benchmark::BENCH_PARSING_STAGE);
         total_files_++;
@@ -338,6 +389,36 @@ namespace jetpack {
         ps.Submit();
 
         worker_errors_.throw_collection_if_not_empty();
+
+        CollectReservedNames();
+    }
+
+    /**
+     * Merge the names collected by parsing threads in one thread,
+     * they are read-only in the following stages.
+     */
+    void ModuleResolver::CollectReservedNames() {
+        // ordered by id
+        auto modules = modules_table_.Modules();
+        for (auto& mod : modules) {
+            id_logger_->InsertByList(mod->unresolved_ids);
+        }
+
+        // the generated names can't be taken by the globals
+        for (auto& mod : modules) {
+            if (!mod->IsCommonJS()) {
+                continue;
+            }
+            do {
+                mod->cjs_call_name = name_generator->Next("jp_require").value_or("jp_require");
+            } while (id_logger_->Contains(mod->cjs_call_name));
+        }
+
+        for (auto& mod : modules) {
+            for (auto& [callee, required] : mod->cjs_calls) {
+                callee->name = required.lock()->cjs_call_name;
+            }
+        }
     }
 
     /**
@@ -435,6 +516,23 @@ namespace jetpack {
         benchmark::BenchMarker codegen_mark(benchmark::BENCH_CODEGEN_STAGE);
         auto final_export_vars = GetAllExportVars();
 
+        if (constant_folding_) {
+            InlineConstants(make_slice(final_export_vars));
+            ShakePureDeclarations(make_slice(final_export_vars));
+        }
+
+        PassManager codegen_passes;
+        codegen_passes.SetProfile(profile_);
+        if (config.minify) {
+            codegen_passes.AddPass([](AstContext& ctx) {
+                return std::make_unique<MinifyLiterals>(ctx);
+            });
+            codegen_passes.AddPass([](AstContext& ctx) {
+                return std::make_unique<MinifySyntax>(ctx);
+            });
+        }
+        RunPasses(codegen_passes);
+
         // distribute root level var name
         if (config.minify) {
             benchmark::BenchMarker bench_minify(benchmark::BENCH_MINIFY);
@@ -450,6 +548,10 @@ namespace jetpack {
         visited_marks.resize(modules_table_.ModCount(), 0);
         TraverseRenameAllImports(entry_module, visited_marks.data());
 
+        if (config.minify && property_mangler_) {
+            MangleAllProperties();
+        }
+
         DumpAllResult(config, make_slice(final_export_vars), out_path);
         codegen_mark.Submit();
     }
@@ -463,27 +565,60 @@ namespace jetpack {
             return;
         }
 
+        // the outputs are replaced when closed, only if they are changed
         std::string sourcemap_path = out_path + ".map";
-        io::FileWriter map_writer(sourcemap_path);
+        std::unique_ptr<io::FileWriter> map_writer;
+        Sp<SourceMapGenerator> sourcemap_generator;
 
-        if (auto err = map_writer.Open(); err != io::IOError::Ok) {
-            std::cerr << fmt::format("open sourcemap {} failed", sourcemap_path) << std::endl;
-            return;
+        if (config.sourcemap) {
+            map_writer = std::make_unique<io::FileWriter>(sourcemap_path, true);
+            if (auto err = map_writer->Open(); err != io::IOError::Ok) {
+                std::cerr << fmt::format("open sourcemap {} failed", sourcemap_path) << std::endl;
+                return;
+            }
+
+            // the sources take most of the sourcemap, it grows for the mappings
+            uint64_t sources_size = 0;
+            int32_t sources_count = 0;
+            for (const auto& mod : modules_table_.Modules()) {
+                mod->sources_base = sources_count;
+                if (mod->input_sourcemap) {
+                    const auto& input = *mod->input_sourcemap;
+                    sources_count += static_cast<int32_t>(input.sources.size());
+                    for (std::size_t i = 0; i < input.sources.size(); i++) {
+                        sources_size += input.sources[i].size() + 16;
+                        const auto& content = input.decoded.sources_content[i];
+                        if (sources_content_ && content.has_value()) {
+                            sources_size += content->size();
+                        }
+                    }
+                    continue;
+                }
+                sources_count++;
+                sources_size += mod->escaped_path.size() + 16;
+                if (sources_content_ && mod->src_content) {
+                    sources_size += mod->src_content->View().size();
+                }
+            }
+            map_writer->SizeHint(sources_size * 3 / 2);
+
+            sourcemap_generator = std::make_shared<SourceMapGenerator>(
+                    shared_from_this(),
+                    *map_writer,
+                    out_path);
         }
 
         benchmark::BenchMarker codegen_marker(benchmark::BENCH_CODEGEN);
-        auto sourcemap_generator = std::make_shared<SourceMapGenerator>(
-                shared_from_this(),
-                map_writer,
-                out_path);
 
-        io::FileWriter js_writer(out_path);
+        io::FileWriter js_writer(out_path, true);
         if (auto err = js_writer.Open(); err != io::IOError::Ok) {
             std::cerr << fmt::format("open js {} failed", out_path) << std::endl;
             return;
         }
         ModuleCompositor module_compositor(js_writer, config);
-        module_compositor.DumpSources(sourcemap_generator);
+        if (sourcemap_generator) {
+            module_compositor.DumpSources(sourcemap_generator);
+        }
 
         // codegen all result begin
 //        sourcemap_generator->AddCollector(mapping_collector);
@@ -496,14 +631,57 @@ namespace jetpack {
 
         auto modules = modules_table_.Modules();
 
+        // split the huge modules on the main thread,
+        // the parts are generated by the workers independently
+        std::vector<std::vector<SyntaxNode*>> stmts(modules.size());
+        std::vector<std::vector<std::size_t>> part_ends(modules.size());
+        std::size_t parts_count = 0;
+        std::size_t i = 0;
+        for (auto& module : modules) {
+            stmts[i] = module->ast->body.to_vec();
+            part_ends[i] = CodeGen::SplitModule(stmts[i], CODEGEN_PART_SIZE);
+            if (part_ends[i].empty()) {
+                part_ends[i].push_back(0);
+            }
+            module->codegen_fragments.resize(part_ends[i].size());
+            parts_count += part_ends[i].size();
+            i++;
+        }
+
         WaitGroup group;
-        group.Add(modules.size());
+        group.Add(parts_count);
+        i = 0;
         for (auto module : modules) {
-            thread_pool_->enqueue([&config, &group, module] {
-                CodeGen codegen(config, module->codegen_fragment);
-                codegen.Traverse(*module->ast);
-                group.Done();
-            });
+            // the output is about the size of the source, smaller if minified
+            std::size_t estimate = 0;
+            if (module->src_content) {
+                estimate = module->src_content->View().size() / part_ends[i].size();
+                if (config.minify) {
+                    estimate /= 2;
+                }
+            }
+            std::size_t begin = 0;
+            for (std::size_t part = 0; part < part_ends[i].size(); part++) {
+                std::size_t end = part_ends[i][part];
+                thread_pool_->enqueue([&config, &group, &stmts, module, i, part, begin, end, estimate] {
+                    auto& fragment = module->codegen_fragments[part];
+                    fragment.content.Reserve(estimate);
+                    CodeGen codegen(config, fragment);
+                    codegen.TraverseModulePart(*module->ast, stmts[i], begin, end);
+                    if (config.sourcemap) {
+                        if (module->input_sourcemap) {
+                            module->input_sourcemap->Compose(fragment, module->id(), module->sources_base);
+                        } else if (module->sources_base != module->id()) {
+                            SourceMapGenerator::RebaseFragment(fragment, module->id(), module->sources_base);
+                        }
+                        // spliced by the generator at the end
+                        SourceMapGenerator::EncodeFragment(fragment);
+                    }
+                    group.Done();
+                });
+                begin = end;
+            }
+            i++;
         }
 
         thread_pool_ = nullptr;
@@ -514,15 +692,60 @@ namespace jetpack {
         ConcatModules(entry_module, module_compositor);
 
         CodeGenFinalExport(module_compositor, final_export_vars);
+        if (auto err = module_compositor.Finish(); err != io::IOError::Ok) {
+            std::cerr << fmt::format("write js {} failed: {}", out_path, io::IOErrorToString(err)) << std::endl;
+        }
         concat_marker.Submit();
 
-        std::future<void> src_fut;
-        if (config.sourcemap) {
-            src_fut = module_compositor.DumpSourcemap(sourcemap_generator);
+        if (sourcemap_generator) {
+            module_compositor.DumpSourcemap(sourcemap_generator).get();
         }
 
-        if (config.sourcemap) {
-            src_fut.get();
+        std::string js_path = out_path;
+        if (hash_filenames_) {
+            ghc::filesystem::path path(out_path);
+            std::string hashed_name = fmt::format("{}.{:016x}{}",
+                                                  path.stem().string(),
+                                                  js_writer.ContentHash(),
+                                                  path.extension().string());
+            js_path = path.replace_filename(hashed_name).string();
+            sourcemap_path = js_path + ".map";
+            js_writer.SetPath(js_path);
+            if (map_writer) {
+                map_writer->SetPath(sourcemap_path);
+            }
+        }
+
+        if (auto err = js_writer.Close(); err != io::IOError::Ok) {
+            std::cerr << fmt::format("write js {} failed: {}", js_path, io::IOErrorToString(err)) << std::endl;
+        }
+        if (map_writer) {
+            if (auto err = map_writer->Close(); err != io::IOError::Ok) {
+                std::cerr << fmt::format("write sourcemap {} failed: {}", sourcemap_path, io::IOErrorToString(err)) << std::endl;
+            }
+        }
+
+        if (hash_filenames_) {
+            WriteManifest(out_path, js_path, map_writer ? sourcemap_path : "");
+        }
+    }
+
+    void ModuleResolver::WriteManifest(const std::string& out_path,
+                                       const std::string& js_path,
+                                       const std::string& sourcemap_path) {
+        ghc::filesystem::path path(out_path);
+        std::string name = path.filename().string();
+
+        nlohmann::json manifest = nlohmann::json::object();
+        manifest[name] = ghc::filesystem::path(js_path).filename().string();
+        if (!sourcemap_path.empty()) {
+            manifest[name + ".map"] = ghc::filesystem::path(sourcemap_path).filename().string();
+        }
+
+        std::string manifest_path = path.replace_filename("manifest.json").string();
+        std::string content = manifest.dump(2);
+        if (auto err = io::WriteBufferToPath(manifest_path, content.c_str(), content.size()); err != io::IOError::Ok) {
+            std::cerr << fmt::format("write manifest {} failed: {}", manifest_path, io::IOErrorToString(err)) << std::endl;
         }
     }
 
@@ -530,7 +753,7 @@ namespace jetpack {
         CodeGenFragment fragment;
         CodeGen codegen(mc.Config(), fragment);
         global_import_handler_.GenCode(codegen);
-        mc.Append(fragment);
+        mc.Append(std::move(fragment));
     }
 
     void ModuleResolver::CodeGenFinalExport(ModuleCompositor& mc, Slice<const ExportVariable> final_export_vars) {
@@ -539,7 +762,7 @@ namespace jetpack {
             CodeGenFragment fragment;
             CodeGen codegen(mc.Config(), fragment);
             codegen.Traverse(*final_export);
-            mc.Append(fragment);
+            mc.Append(std::move(fragment));
         }
     }
 
@@ -583,7 +806,9 @@ namespace jetpack {
                         mod->cjs_call_name,
                         "__commonJS");
             }
-            mc.Append(mod->codegen_fragment);
+            for (auto& fragment : mod->codegen_fragments) {
+                mc.Append(fragment);
+            }
 
             spare_stack.pop();
         }
@@ -594,6 +819,7 @@ namespace jetpack {
         collection.idLogger = id_logger_;
 
         auto modules = modules_table_.Modules();
+        collection.content.resize(modules_table_.ModCount());
         WaitGroup group;
 
         group.Add(modules.size());
@@ -610,6 +836,764 @@ namespace jetpack {
         name_generator = MinifyNameGenerator::Merge(collection.content, id_logger_);
     }
 
+    /**
+     * Collect property names of all modules in parallel,
+     * then distribute names in one thread to keep them consistent in the bundle.
+     */
+    void ModuleResolver::MangleAllProperties() {
+        auto modules = modules_table_.Modules();
+
+        // names of the final exports can be accessed by the importers
+        for (auto& mod : modules) {
+            for (auto& tuple : mod->GetExportManager().local_exports_name) {
+                property_mangler_->AddReserved(tuple.first);
+            }
+            for (auto& tuple : mod->GetExportManager().external_exports_map) {
+                for (auto& alias : tuple.second.names) {
+                    property_mangler_->AddReserved(alias.export_name);
+                }
+            }
+        }
+
+        std::vector<PropertyNames> modules_names;
+        modules_names.resize(modules_table_.ModCount());
+
+        WaitGroup collect_group;
+        collect_group.Add(modules.size());
+        for (auto mod : modules) {
+            thread_pool_->enqueue([mod, &modules_names, &collect_group] {
+                PropertyMangler::CollectNames(*mod->ast, modules_names[mod->id()]);
+                collect_group.Done();
+            });
+        }
+        collect_group.Wait();
+
+        property_mangler_->DistributeNames(modules_names);
+
+        WaitGroup apply_group;
+        apply_group.Add(modules.size());
+        for (auto mod : modules) {
+            thread_pool_->enqueue([this, mod, &apply_group] {
+                property_mangler_->Apply(*mod->ast);
+                apply_group.Done();
+            });
+        }
+        apply_group.Wait();
+    }
+
+    /**
+     * A `const` variable at the root level initialized by a literal.
+     */
+    struct ConstantDeclaration {
+    public:
+        VariableDeclaration* decl = nullptr;
+        VariableDeclarator* declarator = nullptr;
+        ConstantValue value;
+
+        // the import variables bound to it: (module id, variable)
+        std::vector<std::tuple<int32_t, Variable*>> importers;
+
+    };
+
+    static VariableDeclaration* RootLevelDeclaration(SyntaxNode* stmt) {
+        if (stmt->type == SyntaxNodeType::ExportNamedDeclaration) {
+            auto export_decl = dynamic_cast<ExportNamedDeclaration*>(stmt);
+            if (!export_decl->declaration.has_value()) {
+                return nullptr;
+            }
+            stmt = *export_decl->declaration;
+        }
+
+        if (stmt->type != SyntaxNodeType::VariableDeclaration) {
+            return nullptr;
+        }
+
+        return dynamic_cast<VariableDeclaration*>(stmt);
+    }
+
+    static VariableDeclaration* RootLevelConstDeclaration(SyntaxNode* stmt) {
+        auto decl = RootLevelDeclaration(stmt);
+        return decl != nullptr && decl->kind == VarKind::Const ? decl : nullptr;
+    }
+
+    /**
+     * Drop the declarations whose declarators are all removed.
+     */
+    static void RemoveEmptyDeclarations(const Sp<ModuleFile>& mf) {
+        NodeList<SyntaxNode> new_body;
+        for (auto stmt : mf->ast->body.to_vec()) {
+            auto decl = RootLevelDeclaration(stmt);
+            if (decl != nullptr && decl->declarations.empty()) {
+                continue;
+            }
+            new_body.push_back(stmt);
+        }
+        mf->ast->body = new_body;
+    }
+
+    /**
+     * The source of import, `export ... from` and `export * from`.
+     */
+    static std::optional<std::string> ModuleSourceOf(SyntaxNode* stmt) {
+        switch (stmt->type) {
+            case SyntaxNodeType::ImportDeclaration:
+                return dynamic_cast<ImportDeclaration*>(stmt)->source->str_;
+
+            case SyntaxNodeType::ExportAllDeclaration:
+                return dynamic_cast<ExportAllDeclaration*>(stmt)->source->str_;
+
+            case SyntaxNodeType::ExportNamedDeclaration: {
+                auto export_decl = dynamic_cast<ExportNamedDeclaration*>(stmt);
+                if (!export_decl->source.has_value()) {
+                    return std::nullopt;
+                }
+                return (*export_decl->source)->str_;
+            }
+
+            default:
+                return std::nullopt;
+
+        }
+    }
+
+    Sp<ModuleFile> ModuleResolver::FindModuleBySource(const Sp<ModuleFile>& mf, const std::string& source) {
+        auto path_iter = mf->resolved_map.find(source);
+        if (path_iter == mf->resolved_map.end()) {
+            return nullptr;
+        }
+        return modules_table_.FindModuleByPath(path_iter->second);
+    }
+
+    void ModuleResolver::MarkDynamicallyAccessed(const Sp<ModuleFile>& mf, std::vector<uint8_t>& marks) {
+        if (marks[mf->id()]) {
+            return;
+        }
+        marks[mf->id()] = 1;
+
+        // the re-exported variables are accessed too
+        for (auto stmt : mf->ast->body) {
+            if (stmt->type == SyntaxNodeType::ImportDeclaration) {
+                continue;
+            }
+            auto source = ModuleSourceOf(stmt);
+            if (!source.has_value()) {
+                continue;
+            }
+            auto target = FindModuleBySource(mf, *source);
+            if (target != nullptr) {
+                MarkDynamicallyAccessed(target, marks);
+            }
+        }
+    }
+
+    void ModuleResolver::ForEachImportedVariable(
+            const Sp<ModuleFile>& mf,
+            const std::function<void(const Sp<ModuleFile>&, Variable*, Variable*)>& on_variable,
+            const std::function<void(const Sp<ModuleFile>&)>& on_namespace) {
+        for (auto stmt : mf->ast->body) {
+            if (stmt->type != SyntaxNodeType::ImportDeclaration) {
+                continue;
+            }
+            auto import_decl = dynamic_cast<ImportDeclaration*>(stmt);
+            if (global_import_handler_.IsImportExternal(import_decl)) {
+                continue;
+            }
+
+            auto path_iter = mf->resolved_map.find(import_decl->source->str_);
+            if (path_iter == mf->resolved_map.end()) {
+                continue;
+            }
+            const auto& absolute_path = path_iter->second;
+
+            for (auto spec : import_decl->specifiers) {
+                std::string export_name;
+                std::string local_name;
+                switch (spec->type) {
+                    case SyntaxNodeType::ImportNamespaceSpecifier: {
+                        auto target = modules_table_.FindModuleByPath(absolute_path);
+                        if (target != nullptr) {
+                            on_namespace(target);
+                        }
+                        continue;
+                    }
+
+                    case SyntaxNodeType::ImportDefaultSpecifier:
+                        export_name = "default";
+                        local_name = dynamic_cast<ImportDefaultSpecifier*>(spec)->local->name;
+                        break;
+
+                    case SyntaxNodeType::ImportSpecifier: {
+                        auto import_spec = dynamic_cast<ImportSpecifier*>(spec);
+                        export_name = import_spec->imported->name;
+                        local_name = import_spec->local->name;
+                        break;
+                    }
+
+                    default:
+                        continue;
+
+                }
+
+                Sp<ModuleFile> owner;
+                std::set<int32_t> visited_mods;
+                auto export_info = FindLocalExportByPath(absolute_path, export_name, visited_mods, &owner);
+                if (!export_info.has_value() || owner == nullptr) {
+                    continue;
+                }
+
+                // the owner may re-export an import
+                auto owner_var = FindOwnerVariable(owner, (*export_info)->local_name, &owner);
+                if (owner_var == nullptr) {
+                    continue;
+                }
+
+                auto local_var_iter = mf->ast->scope->own_variables.find(local_name);
+                if (local_var_iter == mf->ast->scope->own_variables.end()) {
+                    continue;
+                }
+
+                on_variable(owner, owner_var, local_var_iter->second.get());
+            }
+        }
+    }
+
+    /**
+     * The import declaration binding the name,
+     * export_name is "default" for the default specifier.
+     */
+    static ImportDeclaration* FindImportDeclaration(const Sp<ModuleFile>& mf,
+                                                    const std::string& local_name,
+                                                    std::string& export_name) {
+        for (auto stmt : mf->ast->body) {
+            if (stmt->type != SyntaxNodeType::ImportDeclaration) {
+                continue;
+            }
+            auto import_decl = dynamic_cast<ImportDeclaration*>(stmt);
+            for (auto spec : import_decl->specifiers) {
+                if (spec->type == SyntaxNodeType::ImportSpecifier) {
+                    auto import_spec = dynamic_cast<ImportSpecifier*>(spec);
+                    if (import_spec->local->name == local_name) {
+                        export_name = import_spec->imported->name;
+                        return import_decl;
+                    }
+                } else if (spec->type == SyntaxNodeType::ImportDefaultSpecifier) {
+                    if (dynamic_cast<ImportDefaultSpecifier*>(spec)->local->name == local_name) {
+                        export_name = "default";
+                        return import_decl;
+                    }
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    Variable* ModuleResolver::FindOwnerVariable(Sp<ModuleFile> mf, std::string local_name, Sp<ModuleFile>* owner) {
+        std::set<int32_t> visited_mods;
+        while (visited_mods.insert(mf->id()).second) {
+            auto& own_variables = mf->ast->scope->own_variables;
+            auto var_iter = own_variables.find(local_name);
+            if (var_iter == own_variables.end()) {
+                return nullptr;
+            }
+
+            auto& imports = mf->ast->scope->import_manager.id_map;
+            auto import_iter = imports.find(local_name);
+            if (import_iter == imports.end()) {  // declared by the module
+                *owner = mf;
+                return var_iter->second.get();
+            }
+            if (import_iter->second.is_namespace) {
+                return nullptr;
+            }
+
+            std::string export_name;
+            auto import_decl = FindImportDeclaration(mf, local_name, export_name);
+            if (import_decl == nullptr || global_import_handler_.IsImportExternal(import_decl)) {
+                return nullptr;
+            }
+
+            auto path_iter = mf->resolved_map.find(import_decl->source->str_);
+            if (path_iter == mf->resolved_map.end()) {
+                return nullptr;
+            }
+
+            Sp<ModuleFile> next;
+            std::set<int32_t> visited_exports;
+            auto export_info = FindLocalExportByPath(path_iter->second, export_name, visited_exports, &next);
+            if (!export_info.has_value() || next == nullptr) {
+                return nullptr;
+            }
+            mf = next;
+            local_name = (*export_info)->local_name;
+        }
+        return nullptr;
+    }
+
+    HashSet<Variable*> ModuleResolver::FinalExportVariables(Slice<const ExportVariable> final_export_vars) {
+        HashSet<Variable*> result;
+        for (auto& tuple : final_export_vars) {
+            const auto& mf = std::get<0>(tuple);
+            auto info_iter = mf->GetExportManager().local_exports_name.find(std::get<1>(tuple));
+            if (info_iter == mf->GetExportManager().local_exports_name.end()) {
+                continue;
+            }
+            // `import { a } from './a'; export { a }` exports the variable of './a'
+            Sp<ModuleFile> owner;
+            auto var = FindOwnerVariable(mf, info_iter->second->local_name, &owner);
+            if (var != nullptr) {
+                result.insert(var);
+            }
+        }
+        return result;
+    }
+
+    static void CollectConstantDeclarations(const Sp<ModuleFile>& mf,
+                                            HashMap<Variable*, ConstantDeclaration>& result) {
+        auto& own_variables = mf->ast->scope->own_variables;
+        for (auto stmt : mf->ast->body) {
+            auto decl = RootLevelConstDeclaration(stmt);
+            if (decl == nullptr) {
+                continue;
+            }
+
+            for (auto declarator : decl->declarations) {
+                if (declarator->id->type != SyntaxNodeType::Identifier || !declarator->init.has_value()) {
+                    continue;
+                }
+
+                auto value = ContantFolding::Evaluate(*declarator->init);
+                if (!value.has_value() || !ConstantInliner::IsInlinable(*value)) {
+                    continue;
+                }
+
+                auto var_iter = own_variables.find(dynamic_cast<Identifier*>(declarator->id)->name);
+                if (var_iter == own_variables.end()) {
+                    continue;
+                }
+
+                ConstantDeclaration item;
+                item.decl = decl;
+                item.declarator = declarator;
+                item.value = std::move(*value);
+                result[var_iter->second.get()] = std::move(item);
+            }
+        }
+    }
+
+    /**
+     * Inline in parallel, then drop the declarations whose references
+     * are all replaced in every module.
+     *
+     * The declarations are kept if they can be accessed dynamically:
+     * - the module is imported by namespace, or it's CommonJS
+     * - the variable is exported by the bundle
+     */
+    void ModuleResolver::InlineConstants(Slice<const ExportVariable> final_export_vars) {
+        auto modules = modules_table_.Modules();
+        auto mod_count = modules_table_.ModCount();
+
+        std::vector<HashMap<Variable*, ConstantDeclaration>> declarations;
+        declarations.resize(mod_count);
+
+        std::vector<uint8_t> kept_mods;
+        kept_mods.resize(mod_count, 0);
+
+        for (auto& mod : modules) {
+            if (mod->IsCommonJS()) {
+                kept_mods[mod->id()] = 1;
+                continue;
+            }
+            CollectConstantDeclarations(mod, declarations[mod->id()]);
+        }
+
+        std::vector<HashMap<Variable*, ConstantValue>> constants;
+        constants.resize(mod_count);
+
+        for (auto& mod : modules) {
+            auto& mod_constants = constants[mod->id()];
+            for (auto& tuple : declarations[mod->id()]) {
+                mod_constants[tuple.first] = tuple.second.value;
+            }
+
+            ForEachImportedVariable(
+                    mod,
+                    [&](const Sp<ModuleFile>& owner, Variable* owner_var, Variable* local_var) {
+                        auto decl_iter = declarations[owner->id()].find(owner_var);
+                        if (decl_iter == declarations[owner->id()].end()) {
+                            return;
+                        }
+                        mod_constants[local_var] = decl_iter->second.value;
+                        decl_iter->second.importers.emplace_back(mod->id(), local_var);
+                    },
+                    [&](const Sp<ModuleFile>& target) {
+                        MarkDynamicallyAccessed(target, kept_mods);
+                    });
+        }
+
+        std::vector<std::unique_ptr<ConstantInliner>> inliners;
+        inliners.resize(mod_count);
+
+        WaitGroup group;
+        for (auto mod : modules) {
+            if (constants[mod->id()].empty()) {
+                continue;
+            }
+
+            group.Add();
+            thread_pool_->enqueue([mod, &constants, &inliners, &group] {
+                auto inliner = std::make_unique<ConstantInliner>(mod->ast_context, constants[mod->id()]);
+                inliner->TraverseNode(mod->ast);
+
+                // the tests may be constants now
+                if (inliner->ReplacedCount() > 0) {
+                    DeadCodeElimination dce(mod->ast_context);
+                    dce.TraverseNode(mod->ast);
+                }
+
+                inliners[mod->id()] = std::move(inliner);
+                group.Done();
+            });
+        }
+        group.Wait();
+
+        auto exported_vars = FinalExportVariables(final_export_vars);
+
+        for (auto& mod : modules) {
+            if (kept_mods[mod->id()]) {
+                continue;
+            }
+
+            bool changed = false;
+            for (auto& tuple : declarations[mod->id()]) {
+                auto var = tuple.first;
+                auto& item = tuple.second;
+                if (exported_vars.find(var) != exported_vars.end()) {
+                    continue;
+                }
+
+                bool used = inliners[mod->id()]->RemainingReferences(var) > 0;
+                for (auto& importer : item.importers) {
+                    auto& importer_inliner = inliners[std::get<0>(importer)];
+                    used = used || importer_inliner->RemainingReferences(std::get<1>(importer)) > 0;
+                }
+                if (used) {
+                    continue;
+                }
+
+                auto& declarators = item.decl->declarations;
+                declarators.erase(std::remove(std::begin(declarators), std::end(declarators), item.declarator), std::end(declarators));
+                changed = true;
+            }
+
+            if (changed) {
+                RemoveEmptyDeclarations(mod);
+            }
+        }
+    }
+
+    /**
+     * A root level variable initialized by a call annotated by `#__PURE__`,
+     * e.g. the classes compiled by Babel.
+     */
+    struct PureDeclaration {
+    public:
+        VariableDeclaration* decl = nullptr;
+        VariableDeclarator* declarator = nullptr;
+
+        // the import variables bound to it: (module id, variable)
+        std::vector<std::tuple<int32_t, Variable*>> importers;
+
+    };
+
+    static void CollectPureDeclarations(const Sp<ModuleFile>& mf,
+                                        HashMap<Variable*, PureDeclaration>& result) {
+        auto& own_variables = mf->ast->scope->own_variables;
+        for (auto stmt : mf->ast->body) {
+            auto decl = RootLevelDeclaration(stmt);
+            if (decl == nullptr) {
+                continue;
+            }
+
+            for (auto declarator : decl->declarations) {
+                if (declarator->id->type != SyntaxNodeType::Identifier ||
+                    !declarator->init.has_value() ||
+                    !SideEffects::IsPureCall(*declarator->init)) {
+                    continue;
+                }
+
+                auto var_iter = own_variables.find(dynamic_cast<Identifier*>(declarator->id)->name);
+                if (var_iter == own_variables.end()) {
+                    continue;
+                }
+
+                PureDeclaration item;
+                item.decl = decl;
+                item.declarator = declarator;
+                result[var_iter->second.get()] = std::move(item);
+            }
+        }
+    }
+
+    void ModuleResolver::CountAllReferences(std::vector<std::unique_ptr<ReferenceCounter>>& counters) {
+        auto modules = modules_table_.Modules();
+        counters.clear();
+        counters.resize(modules_table_.ModCount());
+
+        WaitGroup group;
+        for (auto mod : modules) {
+            group.Add();
+            thread_pool_->enqueue([mod, &counters, &group] {
+                auto counter = std::make_unique<ReferenceCounter>();
+                counter->TraverseNode(mod->ast);
+                counters[mod->id()] = std::move(counter);
+                group.Done();
+            });
+        }
+        group.Wait();
+    }
+
+    /**
+     * Drop the unused pure declarations until nothing changes,
+     * removing one may make the others unused.
+     *
+     * Then drop the imports whose bindings are all unused,
+     * if the imported modules have no side effects.
+     * A module is not bundled if all the imports of it are dropped.
+     */
+    void ModuleResolver::ShakePureDeclarations(Slice<const ExportVariable> final_export_vars) {
+        auto modules = modules_table_.Modules();
+        auto mod_count = modules_table_.ModCount();
+
+        std::vector<HashMap<Variable*, PureDeclaration>> declarations;
+        declarations.resize(mod_count);
+
+        std::vector<uint8_t> kept_mods;
+        kept_mods.resize(mod_count, 0);
+
+        for (auto& mod : modules) {
+            if (mod->IsCommonJS()) {
+                kept_mods[mod->id()] = 1;
+                continue;
+            }
+            CollectPureDeclarations(mod, declarations[mod->id()]);
+        }
+
+        for (auto& mod : modules) {
+            ForEachImportedVariable(
+                    mod,
+                    [&](const Sp<ModuleFile>& owner, Variable* owner_var, Variable* local_var) {
+                        auto decl_iter = declarations[owner->id()].find(owner_var);
+                        if (decl_iter == declarations[owner->id()].end()) {
+                            return;
+                        }
+                        decl_iter->second.importers.emplace_back(mod->id(), local_var);
+                    },
+                    [&](const Sp<ModuleFile>& target) {
+                        MarkDynamicallyAccessed(target, kept_mods);
+                    });
+        }
+
+        auto exported_vars = FinalExportVariables(final_export_vars);
+
+        std::vector<std::unique_ptr<ReferenceCounter>> counters;
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            CountAllReferences(counters);
+
+            for (auto& mod : modules) {
+                if (kept_mods[mod->id()]) {
+                    continue;
+                }
+
+                std::vector<Variable*> removed;
+                for (auto& tuple : declarations[mod->id()]) {
+                    auto var = tuple.first;
+                    auto& item = tuple.second;
+                    if (exported_vars.find(var) != exported_vars.end()) {
+                        continue;
+                    }
+
+                    bool used = counters[mod->id()]->Count(var) > 0;
+                    for (auto& importer : item.importers) {
+                        used = used || counters[std::get<0>(importer)]->Count(std::get<1>(importer)) > 0;
+                    }
+                    if (used) {
+                        continue;
+                    }
+
+                    auto& declarators = item.decl->declarations;
+                    declarators.erase(std::remove(std::begin(declarators), std::end(declarators), item.declarator), std::end(declarators));
+                    removed.push_back(var);
+                }
+
+                if (removed.empty()) {
+                    continue;
+                }
+
+                for (auto var : removed) {
+                    declarations[mod->id()].erase(var);
+                }
+                RemoveEmptyDeclarations(mod);
+                changed = true;
+            }
+        }
+
+        // the counters are up-to-date, nothing is removed in the last round
+        std::vector<int8_t> side_effect_marks;
+        side_effect_marks.resize(mod_count, -1);
+
+        for (auto& mod : modules) {
+            if (mod->IsCommonJS()) {
+                continue;
+            }
+
+            auto& counter = counters[mod->id()];
+            std::vector<Sp<ModuleFile>> dropped_mods;
+            NodeList<SyntaxNode> new_body;
+            for (auto stmt : mod->ast->body.to_vec()) {
+                if (stmt->type != SyntaxNodeType::ImportDeclaration) {
+                    new_body.push_back(stmt);
+                    continue;
+                }
+
+                auto import_decl = dynamic_cast<ImportDeclaration*>(stmt);
+                bool used = import_decl->specifiers.empty() || global_import_handler_.IsImportExternal(import_decl);
+                for (auto spec : import_decl->specifiers) {
+                    Identifier* local = nullptr;
+                    switch (spec->type) {
+                        case SyntaxNodeType::ImportSpecifier:
+                            local = dynamic_cast<ImportSpecifier*>(spec)->local;
+                            break;
+
+                        case SyntaxNodeType::ImportDefaultSpecifier:
+                            local = dynamic_cast<ImportDefaultSpecifier*>(spec)->local;
+                            break;
+
+                        case SyntaxNodeType::ImportNamespaceSpecifier:
+                            local = dynamic_cast<ImportNamespaceSpecifier*>(spec)->local;
+                            break;
+
+                        default:
+                            break;
+
+                    }
+
+                    auto& own_variables = mod->ast->scope->own_variables;
+                    auto var_iter = local == nullptr ? own_variables.end() : own_variables.find(local->name);
+                    used = used || var_iter == own_variables.end() || counter->Count(var_iter->second.get()) > 0;
+                    // re-exported by `export { a }`
+                    used = used || (local != nullptr && mod->GetExportManager().local_exports_by_local_name.count(local->name) > 0);
+                }
+
+                auto target = used ? nullptr : FindModuleBySource(mod, import_decl->source->str_);
+                if (target == nullptr || !IsSideEffectFree(target, side_effect_marks)) {
+                    new_body.push_back(stmt);
+                    continue;
+                }
+
+                dropped_mods.push_back(target);
+            }
+
+            if (dropped_mods.empty()) {
+                continue;
+            }
+            mod->ast->body = new_body;
+
+            for (auto& target : dropped_mods) {
+                bool still_referenced = false;
+                for (auto stmt : mod->ast->body) {
+                    auto source = ModuleSourceOf(stmt);
+                    still_referenced = still_referenced ||
+                            (source.has_value() && FindModuleBySource(mod, *source) == target);
+                }
+                if (still_referenced) {
+                    continue;
+                }
+
+                auto& refs = mod->ref_mods;
+                refs.erase(std::remove_if(std::begin(refs), std::end(refs), [&target](const std::weak_ptr<ModuleFile>& ref) {
+                    return ref.lock() == target;
+                }), std::end(refs));
+            }
+        }
+    }
+
+    /**
+     * The module and all the modules imported by it
+     * have no side effects when they are evaluated.
+     *
+     * @param marks the cache, 1 if free, 0 if not, -1 if unknown
+     */
+    bool ModuleResolver::IsSideEffectFree(const Sp<ModuleFile>& root, std::vector<int8_t>& marks) {
+        std::set<int32_t> visited;
+        std::stack<Sp<ModuleFile>> stack;
+        stack.push(root);
+
+        while (!stack.empty()) {
+            auto mod = stack.top();
+            stack.pop();
+
+            if (!visited.insert(mod->id()).second || marks[mod->id()] == 1) {
+                continue;
+            }
+
+            bool free = marks[mod->id()] != 0 && !mod->IsCommonJS();
+            for (auto stmt : mod->ast->body) {
+                if (!free) {
+                    break;
+                }
+                if (!SideEffects::IsPureStatement(stmt)) {
+                    free = false;
+                    break;
+                }
+
+                auto source = ModuleSourceOf(stmt);
+                if (!source.has_value()) {
+                    continue;
+                }
+
+                // the external modules are unknown
+                auto target = FindModuleBySource(mod, *source);
+                if (target == nullptr) {
+                    free = false;
+                    break;
+                }
+                stack.push(target);
+            }
+
+            if (!free) {
+                marks[mod->id()] = 0;
+                marks[root->id()] = 0;
+                return false;
+            }
+        }
+
+        // all the modules reachable from it are free, including the cycles
+        for (auto id : visited) {
+            marks[id] = 1;
+        }
+        return true;
+    }
+
+    void ModuleResolver::RunPasses(const PassManager& passes) {
+        if (passes.Empty()) {
+            return;
+        }
+
+        benchmark::BenchMarker bench(benchmark::BENCH_OPTIMIZE);
+        WaitGroup group;
+        for (auto mod : modules_table_.Modules()) {
+            group.Add();
+            thread_pool_->enqueue([mod, &passes, &group] {
+                passes.Run(mod->ast_context, mod->ast);
+                group.Done();
+            });
+        }
+        group.Wait();
+        bench.Submit();
+    }
+
     void ModuleResolver::RenameAllRootLevelVariable() {
         std::vector<uint8_t> visited_marks;
         visited_marks.resize(modules_table_.ModCount(), 0);
@@ -765,7 +1749,7 @@ namespace jetpack {
                                     dector->id = new_id;
 
 
-                                    auto right_id = MakeId(module_ast_ctx_, SourceLocation::NoOrigin, (*fun_decl->id)->name);
+                                    auto right_id = MakeId(module_ast_ctx_, SourceLocation::NoOrigin, (*fun_decl->id)->GetName());
                                     mf->ast->scope->CreateVariable(right_id, VarKind::Var);
 
                                     dector->init = { right_id };
@@ -802,7 +1786,7 @@ namespace jetpack {
                                     dector->id = new_id;
 
                                     auto right_id = module_ast_ctx_.Alloc<Identifier>();
-                                    right_id->name = (*cls_decl->id)->name;
+                                    right_id->name = (*cls_decl->id)->GetName();
 
                                     dector->init = { right_id };
 
@@ -905,7 +1889,7 @@ namespace jetpack {
             switch (spec->type) {
                 case SyntaxNodeType::ImportDefaultSpecifier: {
                     auto import_default = spec->As<ImportDefaultSpecifier>();
-                    auto& local_name = import_default->local->name;
+                    auto& local_name = import_default->local->GetName();
 
                     if (local_name != info.default_local_name) {
                         renames.emplace_back(local_name, info.default_local_name);
@@ -916,15 +1900,15 @@ namespace jetpack {
                 case SyntaxNodeType::ImportSpecifier: {
                     auto import_spec = spec->As<ImportSpecifier>();
 
-                    if (auto iter = info.alias_map.find(import_spec->local->name); iter != info.alias_map.end()) {
-                        renames.emplace_back(import_spec->local->name, iter->second);
+                    if (auto iter = info.alias_map.find(import_spec->local->GetName()); iter != info.alias_map.end()) {
+                        renames.emplace_back(import_spec->local->GetName(), iter->second);
                     }
                     break;
                 }
 
                 case SyntaxNodeType::ImportNamespaceSpecifier: {
                     auto import_ns = spec->As<ImportNamespaceSpecifier>();
-                    auto& local_name = import_ns->local->name;
+                    auto& local_name = import_ns->local->GetName();
 
                     if (local_name != info.ns_import_name) {
                         renames.emplace_back(local_name, info.ns_import_name);
@@ -979,16 +1963,16 @@ namespace jetpack {
 
             auto declarator = module_ast_ctx_.Alloc<VariableDeclarator>(std::make_unique<Scope>(module_ast_ctx_));
 
-            auto new_id = MakeId(module_ast_ctx_, import_ns->local->location, import_ns->local->name);
+            auto new_id = MakeId(module_ast_ctx_, import_ns->local->location, import_ns->local->GetName());
 
             // debug
 //            std::cout << utils::To_UTF8(ast->scope->own_variables[import_ns->local->name].name) << std::endl;
 
-            auto pvar = mf->ast->scope->own_variables[import_ns->local->name];
+            auto pvar = mf->ast->scope->own_variables[import_ns->local->GetName()];
             if (pvar == nullptr) {
                 return;
             }
-            pvar->identifiers.push_back(new_id);
+            pvar->AddIdentifier(new_id);
 
             declarator->id = new_id;  // try not to use old ast
 
@@ -1047,7 +2031,7 @@ namespace jetpack {
                         const auto& relative_path = import_decl->source->str_;
                         absolute_path = mf->resolved_map[relative_path];
                         target_export_name = "default";
-                        import_local_name = default_spec->local->name;
+                        import_local_name = default_spec->local->GetName();
                         break;
                     }
 
@@ -1055,8 +2039,8 @@ namespace jetpack {
                         auto import_spec = dynamic_cast<ImportSpecifier*>(spec);
                         const auto& relative_path = import_decl->source->str_;
                         absolute_path = mf->resolved_map[relative_path];
-                        target_export_name = import_spec->imported->name;
-                        import_local_name = import_spec->local->name;
+                        target_export_name = import_spec->imported->GetName();
+                        import_local_name = import_spec->local->GetName();
                         break;
                     }
 
@@ -1095,7 +2079,8 @@ namespace jetpack {
     std::optional<Sp<LocalExportInfo>>
     ModuleResolver::FindLocalExportByPath(const std::string &path,
                                           const std::string& export_name,
-                                          std::set<int32_t>& visited) {
+                                          std::set<int32_t>& visited,
+                                          Sp<ModuleFile>* owner) {
         auto mod = modules_table_.FindModuleByPath(path);
         if (mod == nullptr) {
             return std::nullopt;
@@ -1108,6 +2093,9 @@ namespace jetpack {
 
         auto local_iter = mod->GetExportManager().local_exports_name.find(export_name);
         if (local_iter != mod->GetExportManager().local_exports_name.end()) {  // found
+            if (owner != nullptr) {
+                *owner = mod;
+            }
             return { local_iter->second };
         }
 
@@ -1117,14 +2105,14 @@ namespace jetpack {
             auto absolute_path = mod->resolved_map[relative_path];
 
             if (tuple.second.is_export_all) {
-                auto tmp_result = FindLocalExportByPath(absolute_path, export_name, visited);
+                auto tmp_result = FindLocalExportByPath(absolute_path, export_name, visited, owner);
                 if (tmp_result.has_value()) {  // the variable you find is in this opt
                     return tmp_result;
                 }
             } else {
                 for (auto& alias : tuple.second.names) {
                     if (alias.export_name == export_name) {  // eventually find you!
-                        return FindLocalExportByPath(absolute_path, alias.source_name, visited);
+                        return FindLocalExportByPath(absolute_path, alias.source_name, visited, owner);
                     }
                 }
             }
@@ -21,8 +21,11 @@
 #include "ModuleFile.h"
 #include "ModulesTable.h"
 #include "GlobalImportHandler.h"
+#include "PropertyMangler.h"
 #include "WorkerError.h"
 #include "sourcemap/SourceMapGenerator.h"
+#include "optimize/ReferenceCounter.h"
+#include "optimize/PassManager.h"
 #include "utils/JetFlags.h"
 #include "utils/WaitGroup.h"
 
@@ -115,6 +118,13 @@ namespace jetpack {
             return trace_file;
         }
 
+        /**
+         * Measure the optimization passes one by one.
+         */
+        inline void SetProfile(bool v) {
+            profile_ = v;
+        }
+
         void PrintStatistic();
 
         void PrintErrors(const Vec<WorkerError>& errors);
@@ -123,6 +133,36 @@ namespace jetpack {
 
         void RenameAllInnerScopes();
 
+        void MangleAllProperties();
+
+        /**
+         * Replace the imported `const` variables initialized by literals,
+         * and drop the declarations no longer used.
+         */
+        void InlineConstants(Slice<const ExportVariable> final_export_vars);
+
+        /**
+         * Drop the unused variables initialized by pure calls,
+         * and the side-effect free modules no longer imported.
+         */
+        void ShakePureDeclarations(Slice<const ExportVariable> final_export_vars);
+
+        /**
+         * Run the fused passes on all the modules in parallel.
+         */
+        void RunPasses(const PassManager& passes);
+
+        /**
+         * nullable, properties are not mangled by default
+         */
+        inline void SetPropertyMangler(Sp<PropertyMangler> mangler) {
+            property_mangler_ = std::move(mangler);
+        }
+
+        inline Sp<PropertyMangler> GetPropertyMangler() {
+            return property_mangler_;
+        }
+
         inline void SetNameGenerator(std::shared_ptr<UniqueNameGenerator> generator) {
             name_generator = std::move(generator);
         }
@@ -156,6 +196,8 @@ namespace jetpack {
     private:
         void pBeginFromEntry(const Sp<ModuleProvider>& rootProvider, const parser::Config& config, const std::string& resolvedPath);
 
+        void CollectReservedNames();
+
         void TraverseModulePushExportVars(
                 std::vector<std::tuple<Sp<ModuleFile>, std::string>>& arr,
                 const Sp<ModuleFile>&,
@@ -171,10 +213,20 @@ namespace jetpack {
                                     LocationAddOptions flags,
                                     const std::string& path);
 
+        /**
+         * Load the map of the module compiled by another tool,
+         * the module is kept as the source if it's broken.
+         */
+        void LoadInputSourceMap(const Sp<ModuleFile>& mf);
+
         void DumpAllResult(const CodeGenConfig& config,
                            Slice<const ExportVariable> final_export_vars,
                            const std::string& outPath);
 
+        void WriteManifest(const std::string& out_path,
+                           const std::string& js_path,
+                           const std::string& sourcemap_path);
+
         void CodeGenGlobalImport(ModuleCompositor& mc);
 
         void CodeGenFinalExport(
@@ -190,6 +242,26 @@ namespace jetpack {
             escape_file_ = v;
         }
 
+        /**
+         * Embed the sources in the sourcemap,
+         * their contents are escaped when they are parsed.
+         */
+        inline void SetSourcesContent(bool v) {
+            sources_content_ = v;
+        }
+
+        inline bool GetSourcesContent() const {
+            return sources_content_;
+        }
+
+        /**
+         * Name the outputs by the content hash, e.g. `index.<hash>.js`,
+         * the names are written to `manifest.json` beside them.
+         */
+        inline void SetHashFilenames(bool v) {
+            hash_filenames_ = v;
+        }
+
     private:
         void TraverseRenameAllImports(const Sp<ModuleFile>& mf, uint8_t* visited_marks);
 
@@ -203,11 +275,54 @@ namespace jetpack {
 
         bool IsExternalImportModulePath(const std::string& path);
 
+        /**
+         * @param owner optional, receive the module declaring the variable
+         */
         std::optional<Sp<LocalExportInfo>>
-        FindLocalExportByPath(const std::string& path, const std::string& export_name, std::set<int32_t>& visited);
+        FindLocalExportByPath(const std::string& path,
+                              const std::string& export_name,
+                              std::set<int32_t>& visited,
+                              Sp<ModuleFile>* owner = nullptr);
 
         Sp<ExportNamedDeclaration> GenFinalExportDecl(Slice<const ExportVariable> export_names);
 
+        /**
+         * nullptr if it's external or not resolved
+         */
+        Sp<ModuleFile> FindModuleBySource(const Sp<ModuleFile>& mf, const std::string& source);
+
+        /**
+         * The module is imported by namespace,
+         * all the variables exported by it should be kept.
+         */
+        void MarkDynamicallyAccessed(const Sp<ModuleFile>& mf, std::vector<uint8_t>& marks);
+
+        /**
+         * @param on_variable (owner module, variable in owner, local variable)
+         * @param on_namespace the module imported by namespace
+         */
+        void ForEachImportedVariable(
+                const Sp<ModuleFile>& mf,
+                const std::function<void(const Sp<ModuleFile>&, Variable*, Variable*)>& on_variable,
+                const std::function<void(const Sp<ModuleFile>&)>& on_namespace);
+
+        /**
+         * Follow the imports to the module declaring the variable,
+         * e.g. `import { a } from './a'; export { a }` is resolved to `a` of './a'.
+         *
+         * @return nullptr if it's imported by namespace, external or not resolved
+         */
+        Variable* FindOwnerVariable(Sp<ModuleFile> mf, std::string local_name, Sp<ModuleFile>* owner);
+
+        /**
+         * The variables exported by the bundle, resolved to their owners.
+         */
+        HashSet<Variable*> FinalExportVariables(Slice<const ExportVariable> final_export_vars);
+
+        void CountAllReferences(std::vector<std::unique_ptr<ReferenceCounter>>& counters);
+
+        bool IsSideEffectFree(const Sp<ModuleFile>& root, std::vector<int8_t>& marks);
+
         // return nullable
         std::pair<Sp<ModuleProvider>, ghc::filesystem::path> FindProviderByPath(const Sp<ModuleFile>& parent, const std::string& path);
 
@@ -219,6 +334,8 @@ namespace jetpack {
 
         Sp<UnresolvedNameCollector> id_logger_;
 
+        Sp<PropertyMangler> property_mangler_;
+
         Sp<ModuleFile> entry_module;
 
         std::unique_ptr<ThreadPool> thread_pool_;
@@ -234,6 +351,13 @@ namespace jetpack {
 
         bool trace_file = true;
         bool escape_file_ = false;
+        bool sources_content_ = true;
+        bool constant_folding_ = false;
+        bool profile_ = false;
+        bool hash_filenames_ = false;
+
+        // run on every module after it's parsed
+        PassManager parsing_passes_;
 
     };
 
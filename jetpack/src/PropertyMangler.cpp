@@ -0,0 +1,258 @@
+//
+// Created by Duzhong Chen on 2021/11/22.
+//
+
+#include <algorithm>
+#include <iostream>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include "PropertyMangler.h"
+#include "codegen/StaticAutoNodeTraverser.h"
+
+namespace jetpack {
+
+    static const char* NameCacheKey = "props";
+
+    class PropertyNamesCollector : public StaticAutoNodeTraverser<PropertyNamesCollector> {
+    public:
+        using StaticAutoNodeTraverser<PropertyNamesCollector>::TraverseBefore;
+
+        explicit PropertyNamesCollector(PropertyNames& names): names_(names) {}
+
+        bool TraverseBefore(MemberExpression* node) {
+            Count(node->property, node->computed);
+            return true;
+        }
+
+        bool TraverseBefore(Property* node) {
+            Count(node->key, node->computed);
+            return true;
+        }
+
+        bool TraverseBefore(MethodDefinition* node) {
+            if (node->key.has_value()) {
+                Count(*node->key, node->computed);
+            }
+            return true;
+        }
+
+    private:
+        void Count(SyntaxNode* node, bool computed) {
+            if (node->type == SyntaxNodeType::Literal) {
+                auto lit = dynamic_cast<Literal*>(node);
+                if (lit->ty == Literal::Ty::String) {
+                    names_.quoted.insert(lit->str_);
+                }
+                return;
+            }
+
+            if (computed || node->type != SyntaxNodeType::Identifier) {
+                return;
+            }
+
+            names_.counts[dynamic_cast<Identifier*>(node)->name]++;
+        }
+
+        PropertyNames& names_;
+
+    };
+
+    class PropertyNamesReplacer : public StaticAutoNodeTraverser<PropertyNamesReplacer> {
+    public:
+        using StaticAutoNodeTraverser<PropertyNamesReplacer>::TraverseBefore;
+
+        explicit PropertyNamesReplacer(const HashMap<std::string, std::string>& mangled_names):
+        mangled_names_(mangled_names) {}
+
+        bool TraverseBefore(MemberExpression* node) {
+            if (!node->computed) {
+                Replace(node->property);
+            }
+            return true;
+        }
+
+        bool TraverseBefore(Property* node) {
+            if (!node->computed && Replace(node->key)) {
+                // { _a } => { q: _a }
+                node->shorthand = false;
+            }
+            return true;
+        }
+
+        bool TraverseBefore(MethodDefinition* node) {
+            if (!node->computed && node->key.has_value()) {
+                Replace(*node->key);
+            }
+            return true;
+        }
+
+    private:
+        bool Replace(SyntaxNode* node) {
+            if (node->type != SyntaxNodeType::Identifier) {
+                return false;
+            }
+
+            auto id = dynamic_cast<Identifier*>(node);
+            if (id->var != nullptr) {  // a binding, not a property name
+                return false;
+            }
+
+            auto iter = mangled_names_.find(id->name);
+            if (iter == mangled_names_.end()) {
+                return false;
+            }
+
+            id->name = iter->second;
+            return true;
+        }
+
+        const HashMap<std::string, std::string>& mangled_names_;
+
+    };
+
+    PropertyMangler::PropertyMangler(const std::string& pattern):
+    pattern_(pattern, std::regex::ECMAScript | std::regex::optimize) {
+        AddReserved("constructor");
+        AddReserved("prototype");
+        AddReserved("__proto__");
+    }
+
+    void PropertyMangler::AddReserved(const std::string& name) {
+        reserved_.insert(name);
+    }
+
+    io::IOError PropertyMangler::LoadNameCache(const std::string& path) {
+        std::string content;
+        auto err = io::ReadFileToStdString(path, content);
+        if (err != io::IOError::Ok) {
+            return err;
+        }
+
+        try {
+            auto cache = nlohmann::json::parse(content);
+            auto iter = cache.find(NameCacheKey);
+            if (iter == cache.end() || !iter->is_object()) {
+                return io::IOError::Ok;
+            }
+            for (auto& item : iter->items()) {
+                if (item.value().is_string()) {
+                    name_cache_[item.key()] = item.value().get<std::string>();
+                }
+            }
+        } catch (nlohmann::json::exception& ex) {
+            std::cerr << fmt::format("invalid name cache {}: {}", path, ex.what()) << std::endl;
+            return io::IOError::ReadFailed;
+        }
+
+        return io::IOError::Ok;
+    }
+
+    io::IOError PropertyMangler::SaveNameCache(const std::string& path) {
+        nlohmann::json props = nlohmann::json::object();
+        for (auto& tuple : name_cache_) {
+            props[tuple.first] = tuple.second;
+        }
+
+        nlohmann::json cache = nlohmann::json::object();
+        cache[NameCacheKey] = std::move(props);
+
+        std::string content = cache.dump(2);
+        return io::WriteBufferToPath(path, content.c_str(), content.size());
+    }
+
+    void PropertyMangler::CollectNames(Module& module, PropertyNames& names) {
+        PropertyNamesCollector collector(names);
+        collector.TraverseNode(&module);
+    }
+
+    bool PropertyMangler::ShouldMangle(const std::string& name) const {
+        if (reserved_.find(name) != reserved_.end()) {
+            return false;
+        }
+        return std::regex_search(name, pattern_);
+    }
+
+    /**
+     * The most used property gets the shortest name.
+     *
+     * Properties not mangled are reserved, a mangled name
+     * never collides with them.
+     */
+    void PropertyMangler::DistributeNames(const std::vector<PropertyNames>& modules_names) {
+        HashMap<std::string, int32_t> counts;
+        HashSet<std::string> quoted;
+        for (const auto& names : modules_names) {
+            for (const auto& tuple : names.counts) {
+                counts[tuple.first] += tuple.second;
+            }
+            quoted.insert(std::begin(names.quoted), std::end(names.quoted));
+        }
+
+        auto used_names = std::make_shared<UnresolvedNameCollector>();
+        for (const auto& name : reserved_) {
+            used_names->Insert(name);
+        }
+        for (const auto& name : quoted) {
+            used_names->Insert(name);
+        }
+
+        std::vector<std::tuple<std::string, int32_t>> candidates;
+        for (const auto& tuple : counts) {
+            if (quoted.find(tuple.first) == quoted.end() && ShouldMangle(tuple.first)) {
+                candidates.emplace_back(tuple.first, tuple.second);
+            } else {
+                used_names->Insert(tuple.first);
+            }
+        }
+
+        // counts is unordered, sort it to make the result stable
+        std::sort(std::begin(candidates), std::end(candidates), [] (const auto& a, const auto& b) {
+            if (std::get<1>(a) != std::get<1>(b)) {
+                return std::get<1>(a) > std::get<1>(b);
+            }
+            return std::get<0>(a) < std::get<0>(b);
+        });
+
+        mangled_names_.clear();
+
+        // reuse the cached names first, unless it collides with a property not mangled
+        HashSet<std::string> taken;
+        for (const auto& tuple : candidates) {
+            const auto& name = std::get<0>(tuple);
+            auto iter = name_cache_.find(name);
+            if (iter == name_cache_.end()) {
+                continue;
+            }
+            if (used_names->Contains(iter->second) || taken.find(iter->second) != taken.end()) {
+                name_cache_.erase(iter);
+                continue;
+            }
+            taken.insert(iter->second);
+            mangled_names_[name] = iter->second;
+        }
+
+        for (const auto& tuple : name_cache_) {
+            used_names->Insert(tuple.second);
+        }
+
+        auto generator = MinifyNameGenerator::Make(used_names);
+        for (const auto& tuple : candidates) {
+            const auto& name = std::get<0>(tuple);
+            if (mangled_names_.find(name) != mangled_names_.end()) {
+                continue;
+            }
+            auto new_name = *generator->Next(name);
+            mangled_names_[name] = new_name;
+            name_cache_[name] = new_name;
+        }
+    }
+
+    void PropertyMangler::Apply(Module& module) const {
+        if (mangled_names_.empty()) {
+            return;
+        }
+        PropertyNamesReplacer replacer(mangled_names_);
+        replacer.TraverseNode(&module);
+    }
+
+}
@@ -0,0 +1,88 @@
+//
+// Created by Duzhong Chen on 2021/11/22.
+//
+
+#pragma once
+
+#include <map>
+#include <regex>
+#include <string>
+#include <vector>
+#include "utils/Common.h"
+#include "utils/io/FileIO.h"
+#include "parser/SyntaxNodes.h"
+#include "UniqueNameGenerator.h"
+
+namespace jetpack {
+
+    /**
+     * Property names of one module,
+     * collected in the worker thread.
+     */
+    struct PropertyNames {
+    public:
+        HashMap<std::string, int32_t> counts;
+
+        /**
+         * Quoted keys and string member access, e.g. `{ "_a": 1 }` and `obj["_a"]`.
+         * They are never mangled.
+         */
+        HashSet<std::string> quoted;
+
+    };
+
+    /**
+     * Mangle the names of properties which match the pattern,
+     * e.g. `_private` and `$$internal`.
+     *
+     * Names are collected from all the modules first,
+     * so a property gets the same name in the whole bundle.
+     */
+    class PropertyMangler {
+    public:
+        /**
+         * @param pattern ECMAScript regex, properties matched are mangled
+         */
+        explicit PropertyMangler(const std::string& pattern);
+
+        void AddReserved(const std::string& name);
+
+        /**
+         * Names in the cache are reused, so they are stable between builds.
+         */
+        io::IOError LoadNameCache(const std::string& path);
+
+        io::IOError SaveNameCache(const std::string& path);
+
+        static void CollectNames(Module& module, PropertyNames& names);
+
+        /**
+         * Run in one thread after all the modules are collected.
+         */
+        void DistributeNames(const std::vector<PropertyNames>& modules_names);
+
+        /**
+         * Read-only, can be run in parallel.
+         */
+        void Apply(Module& module) const;
+
+        [[nodiscard]]
+        inline const HashMap<std::string, std::string>& MangledNames() const {
+            return mangled_names_;
+        }
+
+    private:
+        bool ShouldMangle(const std::string& name) const;
+
+        std::regex pattern_;
+
+        HashSet<std::string> reserved_;
+
+        // ordered, make the cache file stable
+        std::map<std::string, std::string> name_cache_;
+
+        HashMap<std::string, std::string> mangled_names_;
+
+    };
+
+}
@@ -3,6 +3,7 @@
 //
 
 #include <cxxopts.hpp>
+#include <filesystem.hpp>
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
 #else
@@ -14,6 +15,12 @@
 #include "ModuleResolver.h"
 #include "Benchmark.h"
 #include "dumper/AstToJson.h"
+#include "scope/SlotAllocator.h"
+#include "optimize/DeadCodeElimination.h"
+#include "optimize/MinifyLiterals.h"
+#include "optimize/MinifySyntax.h"
+#include "optimize/PassManager.h"
+#include "optimize/Defines.h"
 
 #define OPT_HELP "help"
 #define OPT_ENTRY "entry"
@@ -27,6 +34,11 @@
 #define OPT_SOURCEMAP "sourcemap"
 #define OPT_PROFILE "profile"
 #define OPT_PROFILE_MALLOC "profile-malloc"
+#define OPT_MANGLE_PROPS "mangle-props"
+#define OPT_RESERVED_PROPS "reserved-props"
+#define OPT_NAME_CACHE "name-cache"
+#define OPT_DEFINE "define"
+#define OPT_HASH_FILENAMES "hash-filenames"
 
 using namespace jetpack;
 
@@ -34,29 +46,6 @@ using namespace jetpack;
 
 static char error_buffer[ERROR_BUFFER_SIZE];
 
-static Sp<MinifyNameGenerator> RenameInnerScopes(Scope &scope, UnresolvedNameCollector* idLogger) {
-    std::vector<Sp<MinifyNameGenerator>> temp;
-    temp.reserve(scope.children.size());
-
-    for (auto child : scope.children) {
-        temp.push_back(RenameInnerScopes(*child, idLogger));
-    }
-
-    std::vector<std::tuple<std::string, std::string>> renames;
-    auto renamer = MinifyNameGenerator::Merge(temp);
-
-    for (auto& variable : scope.own_variables) {
-        auto new_opt = renamer->Next(variable.first);
-        if (new_opt.has_value()) {
-            renames.emplace_back(variable.first, *new_opt);
-        }
-    }
-
-    scope.BatchRenameSymbols(renames);
-
-    return renamer;
-}
-
 EMSCRIPTEN_KEEPALIVE
 int jetpack_analyze_module(const char *path, JetpackFlags flags, const char *basePath) {
     parser::Config parser_config = parser::Config::Default();
@@ -80,6 +69,14 @@ int jetpack_analyze_module(const char *path, JetpackFlags flags, const char *bas
 
 EMSCRIPTEN_KEEPALIVE
 int jetpack_bundle_module(const char *path, const char *out_path, int flags, const char *base_path_c) {
+    return jetpack::BundleModule(path, out_path, flags, base_path_c, BundleOptions());
+}
+
+int jetpack::BundleModule(const char *path,
+                          const char *out_path,
+                          int flags,
+                          const char *base_path_c,
+                          const BundleOptions& options) {
     auto start = time::GetCurrentMs();
     std::string base_path;
     if (base_path_c) {
@@ -101,15 +98,63 @@ int jetpack_bundle_module(const char *path, const char *out_path, int flags, con
             codegen_config.minify = true;
             codegen_config.comments = false;
             resolver->SetNameGenerator(MinifyNameGenerator::Make());
+
+            if (!options.mangle_props.empty()) {
+                Sp<PropertyMangler> mangler;
+                try {
+                    mangler = std::make_shared<PropertyMangler>(options.mangle_props);
+                } catch (std::regex_error& err) {
+                    std::cerr << "invalid mangle-props regex: " << options.mangle_props
+                              << ", " << err.what() << std::endl;
+                    return 3;
+                }
+                for (auto& name : options.reserved_props) {
+                    mangler->AddReserved(name);
+                }
+                if (!options.name_cache.empty()) {
+                    if (!ghc::filesystem::exists(options.name_cache)) {
+                        // the first build, it's written after the bundle
+                        std::cerr << "name cache not found, create: " << options.name_cache << std::endl;
+                    } else if (auto err = mangler->LoadNameCache(options.name_cache); err != io::IOError::Ok) {
+                        std::cerr << "read name cache failed: " << options.name_cache
+                                  << ", " << io::IOErrorToString(err) << std::endl;
+                        return 3;
+                    }
+                }
+                resolver->SetPropertyMangler(mangler);
+            }
         }
 
-        codegen_config.sourcemap = !!(flags & JETPACK_SOURCEMAP);
+        if (!options.defines.empty()) {
+            auto defines = std::make_shared<Defines>();
+            for (auto& define : options.defines) {
+                if (!defines->AddFromString(define)) {
+                    std::cerr << "invalid define: " << define << std::endl;
+                    return 3;
+                }
+            }
+            // fold the replaced constants to eliminate the dead branches
+            parser_config.constant_folding = true;
+            parser_config.defines = std::move(defines);
+        }
 
-        resolver->SetEscapeFile(!!(flags & JETPACK_SOURCEMAP));
+        codegen_config.sourcemap = !!(flags & (JETPACK_SOURCEMAP | JETPACK_SOURCEMAP_LINES));
+        codegen_config.sourcemap_lines = !!(flags & JETPACK_SOURCEMAP_LINES);
+
+        resolver->SetEscapeFile(codegen_config.sourcemap);
+        resolver->SetSourcesContent(codegen_config.sourcemap && !codegen_config.sourcemap_lines);
+        resolver->SetProfile(!!(flags & JETPACK_PROFILE));
+        resolver->SetHashFilenames(options.hash_filenames);
         resolver->SetTraceFile(!!(flags & JETPACK_TRACE_FILE));
         resolver->BeginFromEntry(parser_config, path, base_path);
         resolver->CodeGenAllModules(codegen_config, out_path);
 
+        if (auto mangler = resolver->GetPropertyMangler(); mangler && !options.name_cache.empty()) {
+            if (auto err = mangler->SaveNameCache(options.name_cache); err != io::IOError::Ok) {
+                std::cerr << "write name cache failed: " << io::IOErrorToString(err) << std::endl;
+            }
+        }
+
         std::cout << "Finished." << std::endl;
         std::cout << "Totally " << resolver->ModCount() << " file(s) in " << jetpack::time::GetCurrentMs() - start
                   << " ms." << std::endl;
@@ -140,9 +185,31 @@ char* jetpack_parse_and_codegen_will_throw(const char* content, int flags) {
     parser::Parser parser(ast_context, content, config);
 
     auto mod = parser.ParseModule();
-    mod->scope->ResolveAllSymbols(nullptr);
 
+    std::vector<Identifier*> unresolved_ids;
+    mod->scope->ResolveAllSymbols(&unresolved_ids);
+
+    // fused into one traversal
+    PassManager passes;
+    if (config.constant_folding) {
+        passes.AddPass([](AstContext& ctx) {
+            return std::make_unique<DeadCodeElimination>(ctx);
+        });
+    }
     if (code_gen_config.minify) {
+        passes.AddPass([](AstContext& ctx) {
+            return std::make_unique<MinifyLiterals>(ctx);
+        });
+        passes.AddPass([](AstContext& ctx) {
+            return std::make_unique<MinifySyntax>(ctx);
+        });
+    }
+    passes.Run(ast_context, mod);
+
+    if (code_gen_config.minify) {
+        auto id_logger = std::make_shared<UnresolvedNameCollector>();
+        id_logger->InsertByList(unresolved_ids);
+
         std::vector<Scope::PVar> variables;
         for (auto &tuple : mod->scope->own_variables) {
             variables.push_back(tuple.second);
@@ -152,12 +219,10 @@ char* jetpack_parse_and_codegen_will_throw(const char* content, int flags) {
             return p1->identifiers.size() > p2->identifiers.size();
         });
 
-        std::vector<Sp<MinifyNameGenerator>> result;
-        for (auto child : mod->scope->children) {
-            result.push_back(RenameInnerScopes(*child, nullptr));
-        }
+        SlotAllocator allocator(id_logger);
+        std::vector<Sp<MinifyNameGenerator>> result { allocator.RenameInnerScopes(*mod->scope) };
 
-        auto name_generator = MinifyNameGenerator::Merge(result);
+        auto name_generator = MinifyNameGenerator::Merge(result, id_logger);
 
         // RenameSymbol() will change iterator, call it later
         std::vector<std::tuple<std::string, std::string>> rename_vec;
@@ -177,9 +242,10 @@ char* jetpack_parse_and_codegen_will_throw(const char* content, int flags) {
     CodeGenFragment fragment;
     CodeGen codegen(code_gen_config, fragment);
     codegen.Traverse(*mod);
-    char* str_result = reinterpret_cast<char*>(::malloc(fragment.content.size() + 1));
-    ::memcpy(str_result, fragment.content.c_str(), fragment.content.size());
-    str_result[fragment.content.size()] = 0;
+    auto size = fragment.content.Size();
+    char* str_result = reinterpret_cast<char*>(::malloc(size + 1));
+    fragment.content.CopyTo(str_result);
+    str_result[size] = 0;
     return str_result;
 }
 
@@ -249,13 +315,19 @@ int jetpack_handle_command_line(int argc, char **argv) {
                 (OPT_NO_TRACE, "do not trace ref file when analyze module")
                 (OPT_MINIFY, "minify the code")
                 (OPT_OUT, "output filename of bundle", cxxopts::value<std::string>())
-                (OPT_SOURCEMAP, "generate sourcemaps")
+                (OPT_SOURCEMAP, "generate sourcemaps, --sourcemap=lines maps the lines only", cxxopts::value<std::string>()->implicit_value("full"))
                 (OPT_PROFILE, "print profile information")
-                (OPT_PROFILE_MALLOC, "print profile of malloc");
+                (OPT_PROFILE_MALLOC, "print profile of malloc")
+                (OPT_MANGLE_PROPS, "mangle properties matched by the regex, work with --minify", cxxopts::value<std::string>())
+                (OPT_RESERVED_PROPS, "properties never mangled, separated by comma", cxxopts::value<std::string>())
+                (OPT_NAME_CACHE, "file to keep mangled names between builds", cxxopts::value<std::string>())
+                (OPT_DEFINE, "replace a global constant, e.g. process.env.NODE_ENV='\"production\"'", cxxopts::value<std::vector<std::string>>())
+                (OPT_HASH_FILENAMES, "name the outputs by the content hash, with a manifest.json");
 
         options.parse_positional(OPT_ENTRY);
 
         JetpackFlags flags;
+        BundleOptions bundle_options;
         auto result = options.parse(argc, argv);
         flags |= JETPACK_TRACE_FILE;
 
@@ -282,13 +354,52 @@ int jetpack_handle_command_line(int argc, char **argv) {
         }
 
         if (result[OPT_SOURCEMAP].count()) {
-            flags |= JETPACK_SOURCEMAP;
+            std::string mode = result[OPT_SOURCEMAP].as<std::string>();
+            if (mode == "lines") {
+                flags |= JETPACK_SOURCEMAP_LINES;
+            } else if (mode == "full") {
+                flags |= JETPACK_SOURCEMAP;
+            } else {
+                std::cerr << "unknown sourcemap mode: " << mode << std::endl;
+                return 3;
+            }
         }
 
         if (result[OPT_PROFILE].count()) {
             flags |= JETPACK_PROFILE;
         }
 
+        if (result[OPT_MANGLE_PROPS].count()) {
+            bundle_options.mangle_props = result[OPT_MANGLE_PROPS].as<std::string>();
+        }
+
+        if (result[OPT_RESERVED_PROPS].count()) {
+            std::string reserved = result[OPT_RESERVED_PROPS].as<std::string>();
+            std::size_t begin = 0;
+            while (begin <= reserved.size()) {
+                std::size_t end = reserved.find(',', begin);
+                if (end == std::string::npos) {
+                    end = reserved.size();
+                }
+                if (end > begin) {
+                    bundle_options.reserved_props.push_back(reserved.substr(begin, end - begin));
+                }
+                begin = end + 1;
+            }
+        }
+
+        if (result[OPT_NAME_CACHE].count()) {
+            bundle_options.name_cache = result[OPT_NAME_CACHE].as<std::string>();
+        }
+
+        if (result[OPT_DEFINE].count()) {
+            bundle_options.defines = result[OPT_DEFINE].as<std::vector<std::string>>();
+        }
+
+        if (result[OPT_HASH_FILENAMES].count()) {
+            bundle_options.hash_filenames = true;
+        }
+
         if (result[OPT_ANALYZE_MODULE].count()) {
             std::string path = result[OPT_ANALYZE_MODULE].as<std::string>();
             return jetpack_analyze_module(path.c_str(), flags, nullptr);
@@ -298,7 +409,7 @@ int jetpack_handle_command_line(int argc, char **argv) {
             std::string entry_path = result[OPT_ENTRY].as<std::string>();
             std::string out_path = result[OPT_OUT].as<std::string>();
 
-            return jetpack_bundle_module(entry_path.c_str(), out_path.c_str(), flags, nullptr);
+            return jetpack::BundleModule(entry_path.c_str(), out_path.c_str(), flags, nullptr, bundle_options);
         }
 
         std::cout << options.help() << std::endl;
@@ -17,6 +17,7 @@ typedef enum {
     JETPACK_TRACE_FILE = 0x10000,
     JETPACK_SOURCEMAP = 0x20000,
     JETPACK_LIBRARY = 0x40000,
+    JETPACK_SOURCEMAP_LINES = 0x80000,
     JETPACK_PROFILE = 0x1000000,
 } JetpackFlag;
 
@@ -26,6 +27,49 @@ typedef enum {
 
 JET_DECLARE_FLAGS(JetpackFlags, JetpackFlag)
 
+#include <vector>
+
+namespace jetpack {
+
+    /**
+     * Options of bundling which can not be represented by flags.
+     */
+    struct BundleOptions {
+    public:
+        /**
+         * Regex of the property names to mangle, empty to disable.
+         * Only works with JETPACK_MINIFY.
+         */
+        std::string mangle_props;
+
+        std::vector<std::string> reserved_props;
+
+        /**
+         * Optional, keep the mangled names stable between builds.
+         */
+        std::string name_cache;
+
+        /**
+         * `KEY=VALUE`, e.g. `process.env.NODE_ENV="production"`,
+         * the value must be a constant.
+         */
+        std::vector<std::string> defines;
+
+        /**
+         * Name the outputs by the content hash, with a `manifest.json`.
+         */
+        bool hash_filenames = false;
+
+    };
+
+    int BundleModule(const char* path,
+                     const char* out_path,
+                     int flags,
+                     const char* base_path,
+                     const BundleOptions& options);
+
+}
+
 extern "C" {
 
 #endif
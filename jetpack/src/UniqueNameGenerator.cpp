@@ -78,19 +78,15 @@ namespace jetpack {
         }
     }
 
-    std::mutex UniqueNameGeneratorWithUsedName::used_name_mutex_;
     std::once_flag UniqueNameGeneratorWithUsedName::init_once_;
     HashSet<std::string> UniqueNameGeneratorWithUsedName::long_keywords_set;
 
     std::shared_ptr<ReadableNameGenerator> ReadableNameGenerator::Make() {
-        std::shared_ptr<ReadableNameGenerator> result(new ReadableNameGenerator);
-        result->weak_self = result;
-        return result;
+        return std::shared_ptr<ReadableNameGenerator>(new ReadableNameGenerator);
     }
 
     std::optional<std::string>
     ReadableNameGenerator::Next(const std::string &original_name) {
-        std::lock_guard<std::mutex> guard(used_name_mutex_);
         if (!IsNameUsed(original_name)) {  // not exist
             used_name.insert(original_name);
             return std::nullopt;
@@ -107,21 +103,16 @@ namespace jetpack {
             return true;
         }
 
-        std::shared_ptr<ReadableNameGenerator> self = weak_self.lock();
-
-        while (self != nullptr) {
-            if (self->used_name.find(name) != self->used_name.end()) {  // found
-                return true;
-            }
-            self = self->prev;
-        }
-
-        return false;
+        return used_name.find(name) != used_name.end();
     }
 
     std::shared_ptr<MinifyNameGenerator> MinifyNameGenerator::Make() {
-        std::shared_ptr<MinifyNameGenerator> result(new MinifyNameGenerator);
-        result->weak_self = result;
+        return std::shared_ptr<MinifyNameGenerator>(new MinifyNameGenerator);
+    }
+
+    std::shared_ptr<MinifyNameGenerator> MinifyNameGenerator::Make(const std::shared_ptr<UnresolvedNameCollector>& reserved) {
+        auto result = Make();
+        result->reserved = reserved;
         return result;
     }
 
@@ -130,6 +121,9 @@ namespace jetpack {
         auto result = Make();
 
         for (auto& ptr : vec) {
+            if (ptr == nullptr) {
+                continue;
+            }
             if (ptr->counter > result->counter) {
                 result->counter = ptr->counter;
             }
@@ -142,10 +136,10 @@ namespace jetpack {
 
     std::shared_ptr<MinifyNameGenerator>
     MinifyNameGenerator::Merge(std::vector<std::shared_ptr<MinifyNameGenerator>>& vec,
-                               const std::shared_ptr<UniqueNameGenerator>& prev) {
+                               const std::shared_ptr<UnresolvedNameCollector>& reserved) {
         auto result = Merge(vec);
 
-        result->prev = prev;
+        result->reserved = reserved;
 
         return result;
     }
@@ -170,7 +164,7 @@ namespace jetpack {
             return true;
         }
 
-        return prev != nullptr && prev->IsNameUsed(name);
+        return reserved != nullptr && reserved->Contains(name);
     }
 
     std::string MinifyNameGenerator::GenAName() {
@@ -214,15 +208,19 @@ namespace jetpack {
         return result;
     }
 
-    void UnresolvedNameCollector::InsertByList(std::vector<Identifier*> list) {
-        std::lock_guard<std::mutex> lk(logger_mutex);
-        for (auto& id : list){
-            used_name.insert(id->name);
+    void UnresolvedNameCollector::Insert(const std::string& name) {
+        if (name.empty()) {
+            return;
         }
+        std::size_t index = FilterIndex(name);
+        filter_[index / 64] |= uint64_t(1) << (index % 64);
+        used_name.insert(name);
     }
 
-    bool UnresolvedNameCollector::IsNameUsed(const std::string& name) {
-        return used_name.find(name) != used_name.end();
+    void UnresolvedNameCollector::InsertByList(const std::vector<Identifier*>& list) {
+        for (auto id : list) {
+            Insert(id->name);
+        }
     }
 
 }
@@ -8,8 +8,8 @@
 #include <memory>
 #include <string>
 #include <optional>
+#include <array>
 #include <mutex>
-#include <robin_hood.h>
 #include <parser/SyntaxNodes.h>
 
 namespace jetpack {
@@ -30,7 +30,6 @@ namespace jetpack {
         UniqueNameGeneratorWithUsedName();
 
         HashSet<std::string> used_name;
-        static std::mutex used_name_mutex_;
 
         bool IsJsKeyword(const std::string& name);
 
@@ -40,6 +39,11 @@ namespace jetpack {
 
     };
 
+    /**
+     * Not thread-safe.
+     * Only used in the single thread stages,
+     * the names of the CommonJS calls are generated after all the modules are parsed.
+     */
     class ReadableNameGenerator : public UniqueNameGeneratorWithUsedName {
     public:
         static std::shared_ptr<ReadableNameGenerator> Make();
@@ -53,30 +57,61 @@ namespace jetpack {
 
         int32_t counter = 0;
 
-        Sp<ReadableNameGenerator> prev;
-
-        std::weak_ptr<ReadableNameGenerator> weak_self;
-
     };
 
     /**
-     * As base prevous generator of MinifyNameGenerator;
+     * As the reserved names of MinifyNameGenerator.
+     *
+     * Filled once in one thread after all the modules are parsed,
+     * then it's immutable and shared by all the renaming threads without lock.
      */
-    class UnresolvedNameCollector : public UniqueNameGenerator {
+    class UnresolvedNameCollector final : public UniqueNameGenerator {
     public:
+        static constexpr std::size_t FILTER_BITS = 1024;
+
         UnresolvedNameCollector() = default;
 
-        bool IsNameUsed(const std::string& name) override;
+        bool IsNameUsed(const std::string& name) override {
+            return Contains(name);
+        }
 
         std::optional<std::string> Next(const std::string& original_name) override {
             return std::nullopt;
         }
 
-        HashSet<std::string> used_name;
+        /**
+         * Most of the minified names are not reserved,
+         * the filter rejects them without hashing the whole string.
+         */
+        inline bool Contains(const std::string& name) const {
+            if (name.empty()) {
+                return false;
+            }
+            std::size_t index = FilterIndex(name);
+            if ((filter_[index / 64] & (uint64_t(1) << (index % 64))) == 0) {
+                return false;
+            }
+            return used_name.find(name) != used_name.end();
+        }
 
-        std::mutex logger_mutex;
+        void Insert(const std::string& name);
 
-        void InsertByList(std::vector<Identifier*> list);
+        void InsertByList(const std::vector<Identifier*>& list);
+
+        inline std::size_t Size() const {
+            return used_name.size();
+        }
+
+    private:
+        static inline std::size_t FilterIndex(const std::string& name) {
+            auto first = static_cast<unsigned char>(name.front());
+            auto last = static_cast<unsigned char>(name.back());
+            return (name.size() * 131 + first * 31 + last) % FILTER_BITS;
+        }
+
+        HashSet<std::string> used_name;
+
+        std::array<uint64_t, FILTER_BITS / 64> filter_ {};
 
     };
 
@@ -86,6 +121,11 @@ namespace jetpack {
 
         static std::shared_ptr<MinifyNameGenerator> Make();
 
+        /**
+         * @param reserved names in it would be skipped, nullable
+         */
+        static std::shared_ptr<MinifyNameGenerator> Make(const std::shared_ptr<UnresolvedNameCollector>& reserved);
+
         static
         std::shared_ptr<MinifyNameGenerator>
         Merge(std::vector<std::shared_ptr<MinifyNameGenerator>>& vec);
@@ -93,7 +133,7 @@ namespace jetpack {
         static
         std::shared_ptr<MinifyNameGenerator>
         Merge(std::vector<std::shared_ptr<MinifyNameGenerator>>& vec,
-              const std::shared_ptr<UniqueNameGenerator>& prev);
+              const std::shared_ptr<UnresolvedNameCollector>& reserved);
 
         std::optional<std::string> Next(const std::string& original_name) override;
 
@@ -106,9 +146,7 @@ namespace jetpack {
 
         int32_t counter = 0;
 
-        Sp<UniqueNameGenerator> prev;
-
-        std::weak_ptr<MinifyNameGenerator> weak_self;
+        Sp<UnresolvedNameCollector> reserved;
 
     };
 
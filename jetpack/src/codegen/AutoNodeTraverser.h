@@ -4,16 +4,18 @@
 
 #pragma once
 #include "parser/SyntaxNodes.h"
+#include "StaticAutoNodeTraverser.h"
 
 namespace jetpack {
 
-    class AutoNodeTraverser {
+    /**
+     * The virtual adapter of StaticAutoNodeTraverser.
+     */
+    class AutoNodeTraverser: public StaticAutoNodeTraverser<AutoNodeTraverser> {
     public:
 
         AutoNodeTraverser() = default;
 
-        void TraverseNode(SyntaxNode* node);
-
         virtual bool TraverseBefore(ArrayExpression* node) { return true; }
         virtual void TraverseAfter(ArrayExpression* node) {}
         virtual bool TraverseBefore(ArrayPattern* node) { return true; }
@@ -303,5 +305,6 @@ namespace jetpack {
 
     };
 
+    extern template class StaticAutoNodeTraverser<AutoNodeTraverser>;
 
 }
@@ -5,12 +5,13 @@
 #include <iostream>
 #include <algorithm>
 #include "CodeGen.h"
+#include "StaticAutoNodeTraverser.h"
 #include "scope/Variable.h"
 #include "sourcemap/MappingCollector.h"
 
 using namespace std;
 
-#define S_COMMA (config_.minify ? "," : ", ")
+#define S_COMMA (Policy::minify ? "," : ", ")
 
 namespace jetpack {
 
@@ -56,42 +57,171 @@ namespace jetpack {
         return 0;
     }
 
-    CodeGen::CodeGen(
+    inline bool StartsWithSign(SyntaxNode& node, char sign) {
+        if (sign != '+' && sign != '-') {
+            return false;
+        }
+        if (node.type == SyntaxNodeType::UnaryExpression) {
+            auto unary = dynamic_cast<UnaryExpression*>(&node);
+            return unary->prefix && unary->operator_[0] == sign;
+        }
+        if (node.type == SyntaxNodeType::UpdateExpression) {
+            auto update = dynamic_cast<UpdateExpression*>(&node);
+            return update->prefix && update->operator_[0] == sign;
+        }
+        return false;
+    }
+
+    /**
+     * The statement ends with the `;` written by itself,
+     * it can be omitted before `}`.
+     * The `;` of an empty statement can't, e.g. `{while(a);}`
+     */
+    static bool EndsWithOwnSemicolon(SyntaxNode& node) {
+        switch (node.type) {
+            case SyntaxNodeType::ExpressionStatement:
+            case SyntaxNodeType::VariableDeclaration:
+            case SyntaxNodeType::ReturnStatement:
+            case SyntaxNodeType::ThrowStatement:
+            case SyntaxNodeType::BreakStatement:
+            case SyntaxNodeType::ContinueStatement:
+            case SyntaxNodeType::DoWhileStatement:
+                return true;
+
+            case SyntaxNodeType::IfStatement: {
+                auto if_stmt = dynamic_cast<IfStatement*>(&node);
+                if (if_stmt->alternate.has_value()) {
+                    return EndsWithOwnSemicolon(**if_stmt->alternate);
+                }
+                return EndsWithOwnSemicolon(*if_stmt->consequent);
+            }
+
+            case SyntaxNodeType::WhileStatement:
+                return EndsWithOwnSemicolon(*dynamic_cast<WhileStatement*>(&node)->body);
+
+            case SyntaxNodeType::ForStatement:
+                return EndsWithOwnSemicolon(*dynamic_cast<ForStatement*>(&node)->body);
+
+            case SyntaxNodeType::ForInStatement:
+                return EndsWithOwnSemicolon(*dynamic_cast<ForInStatement*>(&node)->body);
+
+            case SyntaxNodeType::ForOfStatement:
+                return EndsWithOwnSemicolon(*dynamic_cast<ForOfStatement*>(&node)->body);
+
+            case SyntaxNodeType::LabeledStatement:
+                return EndsWithOwnSemicolon(*dynamic_cast<LabeledStatement*>(&node)->body);
+
+            default:
+                return false;
+
+        }
+    }
+
+    /**
+     * The string can be a property name without quotes, e.g. `{ "a": 1 }`
+     */
+    static bool IsIdentifierName(const std::string& str) {
+        if (str.empty() || (str[0] >= '0' && str[0] <= '9')) {
+            return false;
+        }
+        for (char ch : str) {
+            if (!((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '_' || ch == '$')) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * `{ "1": 1 }`, but not `{ "01": 1 }` or `{ "1e3": 1 }`
+     */
+    static bool IsIndexName(const std::string& str) {
+        if (str.empty() || str.size() > 15 || (str.size() > 1 && str[0] == '0')) {
+            return false;
+        }
+        return std::all_of(std::begin(str), std::end(str), [](char ch) {
+            return ch >= '0' && ch <= '9';
+        });
+    }
+
+    /**
+     * Generated by the bundler, e.g. the declarations replacing the imports,
+     * it has no range in the source.
+     */
+    static inline bool IsSynthesized(const SyntaxNode& node) {
+        return node.range.second == 0;
+    }
+
+    /**
+     * The end of the nearest statement with a range before `index`,
+     * the comments before it belong to the previous part.
+     */
+    static std::uint32_t PartBoundary(const std::vector<SyntaxNode*>& stmts, std::size_t index) {
+        while (index > 0) {
+            index--;
+            if (!IsSynthesized(*stmts[index])) {
+                return stmts[index]->range.second;
+            }
+        }
+        return 0;
+    }
+
+    class HasCallExpressionTraverser: public StaticAutoNodeTraverser<HasCallExpressionTraverser> {
+    public:
+        using StaticAutoNodeTraverser<HasCallExpressionTraverser>::TraverseBefore;
+
+        bool has_call = false;
+
+        inline bool TraverseBefore(CallExpression* node) {
+            has_call = true;
+            return false;
+        }
+
+    };
+
+    template <typename Policy>
+    CodeGenImpl<Policy>::CodeGenImpl(
             const CodeGenConfig& config,
             CodeGenFragment& d):
-            config_(config), d_(d), mapping_collector_(d) {}
+            config_(config), d_(d), mapping_collector_(d, config.sourcemap_lines) {}
 
-    void CodeGen::Write(const std::string& str) {
-        d_.content += str;
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Write(std::string_view str) {
+        d_.content.Append(str);
         d_.column += UTF16LenOfUtf8(str);
     }
 
-    void CodeGen::Write(const std::string& str, SyntaxNode& node) {
-        if (config_.sourcemap) {
-            mapping_collector_.AddMapping(str, node.location, d_.column);
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Write(const std::string& str, SyntaxNode& node) {
+        if constexpr (Policy::sourcemap) {
+            mapping_collector_.AddMapping(node.location, d_.column);
         }
         Write(str);
     }
 
-    void CodeGen::WriteLineEnd() {
-        if (config_.sourcemap) {
-            mapping_collector_.EndLine();
-        }
-        if (!config_.minify) {
-            d_.content += config_.line_end;
+    template <typename Policy>
+    void CodeGenImpl<Policy>::WriteLineEnd() {
+        // no line is ended in the minified output
+        if constexpr (!Policy::minify) {
+            if constexpr (Policy::sourcemap) {
+                mapping_collector_.EndLine();
+            }
+            d_.content.Append(config_.line_end);
             d_.line++;
             d_.column = 0;
         }
     }
 
-    void CodeGen::WriteIndent() {
-        if (config_.minify) return;
+    template <typename Policy>
+    void CodeGenImpl<Policy>::WriteIndent() {
+        if constexpr (Policy::minify) return;
         for (std::uint32_t i = 0; i < indent_level_; i++) {
             Write(config_.indent);
         }
     }
 
-    int CodeGen::ExpressionPrecedence(SyntaxNode& node) {
+    template <typename Policy>
+    int CodeGenImpl<Policy>::ExpressionPrecedence(SyntaxNode& node) {
         switch (node.type) {
             case SyntaxNodeType::ArrayExpression:
             case SyntaxNodeType::TaggedTemplateExpression:
@@ -157,7 +287,8 @@ namespace jetpack {
         }
     }
 
-    void CodeGen::FormatVariableDeclaration(VariableDeclaration& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::FormatVariableDeclaration(VariableDeclaration& node) {
         switch (node.kind) {
             case VarKind::Var:
                 Write("var ");
@@ -186,7 +317,8 @@ namespace jetpack {
         }
     }
 
-    void CodeGen::FormatBinaryExpression(Expression &expr, BinaryExpression& parent, bool is_right) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::FormatBinaryExpression(Expression &expr, BinaryExpression& parent, bool is_right) {
         if (ExpressionNeedsParenthesis(expr, parent, is_right)) {
             Write("(");
             TraverseNode(expr);
@@ -196,13 +328,15 @@ namespace jetpack {
         }
     }
 
-    bool CodeGen::HasCallExpression(SyntaxNode* node) {
+    template <typename Policy>
+    bool CodeGenImpl<Policy>::HasCallExpression(SyntaxNode* node) {
         HasCallExpressionTraverser traverser;
         traverser.TraverseNode(node);
         return traverser.has_call;
     }
 
-    void CodeGen::FormatSequence(NodeList<SyntaxNode> &params) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::FormatSequence(NodeList<SyntaxNode> &params) {
         Write("(");
         size_t i = 0;
         for (auto param : params) {
@@ -215,7 +349,46 @@ namespace jetpack {
         Write(")");
     }
 
-    bool CodeGen::ExpressionNeedsParenthesis(Expression& node, BinaryExpression &parent,
+    template <typename Policy>
+    void CodeGenImpl<Policy>::FormatExpressionList(SyntaxNode& node) {
+        if (node.type != SyntaxNodeType::SequenceExpression) {
+            TraverseNode(node);
+            return;
+        }
+        auto seq = dynamic_cast<SequenceExpression*>(&node);
+        for (std::size_t i = 0; i < seq->expressions.size(); i++) {
+            TraverseNode(*seq->expressions[i]);
+            if (i < seq->expressions.size() - 1) {
+                Write(S_COMMA);
+            }
+        }
+    }
+
+    template <typename Policy>
+    void CodeGenImpl<Policy>::FormatPropertyKey(SyntaxNode& key) {
+        if (Policy::minify && key.type == SyntaxNodeType::Literal) {
+            auto lit = dynamic_cast<Literal*>(&key);
+            if (lit->ty == Literal::Ty::String && (IsIdentifierName(lit->str_) || IsIndexName(lit->str_))) {
+                Write(lit->str_, *lit);
+                return;
+            }
+        }
+        TraverseNode(key);
+    }
+
+    template <typename Policy>
+    void CodeGenImpl<Policy>::OmitSemicolonBefore(SyntaxNode& last) {
+        if (!Policy::minify || !EndsWithOwnSemicolon(last)) {
+            return;
+        }
+        if (!d_.content.Empty() && d_.content.Back() == ';') {
+            d_.content.PopBack();
+            d_.column -= 1;
+        }
+    }
+
+    template <typename Policy>
+    bool CodeGenImpl<Policy>::ExpressionNeedsParenthesis(Expression& node, BinaryExpression &parent,
                                              bool is_right) {
         int prec = ExpressionPrecedence(node);
         if (prec == needs_parentheses) {
@@ -247,7 +420,8 @@ namespace jetpack {
         return BinaryStrPrecedence(cb->operator_) < BinaryStrPrecedence(parent.operator_);
     }
 
-    void CodeGen::Traverse(Script& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(Script& node) {
         SortComments(node.comments);
 
         for (auto stmt : node.body) {
@@ -260,21 +434,50 @@ namespace jetpack {
         ordered_comments_.shrink_to_fit();
     }
 
-    void CodeGen::Traverse(Module& node) {
-        auto module_scope = node.scope->CastToModule();
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(Module& node) {
+        auto stmts = node.body.to_vec();
+        TraverseModulePart(node, stmts, 0, stmts.size());
+    }
+
+    template <typename Policy>
+    void CodeGenImpl<Policy>::TraverseModulePart(Module& node, const std::vector<SyntaxNode*>& stmts, std::size_t begin, std::size_t end) {
         SortComments(node.comments);
 
-        for (auto stmt : node.body) {
+        // the comments before it are written by the previous parts
+        if (begin > 0) {
+            auto part_begin = PartBoundary(stmts, begin);
+            while (!ordered_comments_.empty() && ordered_comments_.front()->range_.first < part_begin) {
+                ordered_comments_.pop_front();
+            }
+        }
+        // the comments after it are written by the next parts
+        if (end < stmts.size()) {
+            auto part_end = PartBoundary(stmts, end);
+            while (!ordered_comments_.empty() && ordered_comments_.back()->range_.first >= part_end) {
+                ordered_comments_.pop_back();
+            }
+        }
+
+        for (std::size_t i = begin; i < end; i++) {
+            auto stmt = stmts[i];
+            WriteCommentBefore(*stmt);
             WriteIndent();
             TraverseNode(*stmt);
             WriteLineEnd();
+
+            // the comments in it which are not followed by a nested statement
+            if constexpr (Policy::comments) {
+                WriteTopCommentBefore_(stmt->range.second + 1);
+            }
         }
 
         ordered_comments_.clear();
         ordered_comments_.shrink_to_fit();
     }
 
-    void CodeGen::Traverse(ArrayExpression& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ArrayExpression& node) {
         Write("[");
         std::size_t count = 0;
         for (auto& elem : node.elements) {
@@ -290,14 +493,16 @@ namespace jetpack {
         Write("]");
     }
 
-    void CodeGen::Traverse(BlockStatement& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(BlockStatement& node) {
         Write("{");
         indent_level_++;
 
         if (!node.body.empty()) {
-            if (!config_.minify) {
+            if constexpr (!Policy::minify) {
                 WriteLineEnd();
             }
+            SyntaxNode* last = nullptr;
             for (auto elem : node.body) {
                 WriteCommentBefore(*elem);
 
@@ -305,50 +510,68 @@ namespace jetpack {
 
                 TraverseNode(*elem);
                 WriteLineEnd();
+                last = elem;
             }
+            OmitSemicolonBefore(*last);
         }
 
         indent_level_--;
         WriteIndentWith("}");
     }
 
-    void CodeGen::Traverse(EmptyStatement& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(EmptyStatement& node) {
         Write(';');
     }
 
-    void CodeGen::Traverse(ExpressionStatement& node) {
-        int precedence = ExpressionPrecedence(node);
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ExpressionStatement& node) {
+        // the first one of a sequence starts the statement
+        Expression* first = node.expression;
+        if (first->type == SyntaxNodeType::SequenceExpression) {
+            first = dynamic_cast<SequenceExpression*>(first)->expressions.front();
+        }
+        int precedence = ExpressionPrecedence(*first);
         if (
                 (precedence == needs_parentheses) ||
-                (precedence == 3 && node.expression->type == SyntaxNodeType::ObjectPattern)) {
+                (precedence == 3 && dynamic_cast<AssignmentExpression*>(first)->left->type == SyntaxNodeType::ObjectPattern)) {
             Write('(');
-            TraverseNode(*node.expression);
+            FormatExpressionList(*node.expression);
             Write(')');
         } else {
-            TraverseNode(*node.expression);
+            FormatExpressionList(*node.expression);
         }
         Write(u';');
     }
 
-    void CodeGen::Traverse(IfStatement& node) {
-        Write(config_.minify ? "if(" : "if (");
-        TraverseNode(*node.test);
-        Write(config_.minify ? ")" : ") ");
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(IfStatement& node) {
+        Write(Policy::minify ? "if(" : "if (");
+        FormatExpressionList(*node.test);
+        Write(Policy::minify ? ")" : ") ");
         TraverseNode(*node.consequent);
         if (node.alternate.has_value()) {
-//            Write(config_.minify ? "else" : " else ");
-            Write(" else ");
+            if constexpr (!Policy::minify) {
+                Write(" else ");
+            } else if ((*node.alternate)->type == SyntaxNodeType::BlockStatement) {
+                // the consequent ends with `;` or `}`
+                Write("else");
+            } else {
+                Write("else ");
+            }
             TraverseNode(**node.alternate);
         }
     }
 
-    void CodeGen::Traverse(LabeledStatement& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(LabeledStatement& node) {
         TraverseNode(*node.label);
         Write(": ");
         TraverseNode(*node.body);
     }
 
-    void CodeGen::Traverse(BreakStatement& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(BreakStatement& node) {
         Write("break");
         if (node.label.has_value()) {
             Write(" ");
@@ -357,7 +580,8 @@ namespace jetpack {
         Write(";");
     }
 
-    void CodeGen::Traverse(ContinueStatement& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ContinueStatement& node) {
         Write("continue");
         if (node.label.has_value()) {
             Write(" ");
@@ -366,17 +590,19 @@ namespace jetpack {
         Write(";");
     }
 
-    void CodeGen::Traverse(WithStatement& node) {
-        Write(config_.minify ? "with(" : "with (");
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(WithStatement& node) {
+        Write(Policy::minify ? "with(" : "with (");
         TraverseNode(*node.object);
-        Write(config_.minify ? ")" : ") ");
+        Write(Policy::minify ? ")" : ") ");
         TraverseNode(*node.body);
     }
 
-    void CodeGen::Traverse(SwitchStatement& node) {
-        Write(config_.minify ? "switch(" : "switch (");
-        TraverseNode(*node.discrimiant);
-        Write(config_.minify ? "){" : ") {");
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(SwitchStatement& node) {
+        Write(Policy::minify ? "switch(" : "switch (");
+        FormatExpressionList(*node.discrimiant);
+        Write(Policy::minify ? "){" : ") {");
         WriteLineEnd();
         indent_level_++;
 
@@ -401,60 +627,70 @@ namespace jetpack {
 
         }
 
+        if (!node.cases.empty() && !node.cases.back()->consequent.empty()) {
+            OmitSemicolonBefore(*node.cases.back()->consequent.back());
+        }
+
         indent_level_--;
         WriteIndentWith("}");
     }
 
-    void CodeGen::Traverse(ReturnStatement& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ReturnStatement& node) {
         Write("return");
         if (node.argument.has_value()) {
             Write(" ");
-            TraverseNode(**node.argument);
+            FormatExpressionList(**node.argument);
         }
         Write(";");
     }
 
-    void CodeGen::Traverse(ThrowStatement& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ThrowStatement& node) {
         Write("throw ");
-        TraverseNode(*node.argument);
+        FormatExpressionList(*node.argument);
         Write(";");
     }
 
-    void CodeGen::Traverse(TryStatement& node) {
-        Write(config_.minify ? "try" : "try ");
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(TryStatement& node) {
+        Write(Policy::minify ? "try" : "try ");
         TraverseNode(*node.block);
 
         if (node.handler.has_value()) {
             auto handler = *node.handler;
-            Write(config_.minify ? "catch(" : " catch (");
+            Write(Policy::minify ? "catch(" : " catch (");
             TraverseNode(*handler->param);
             Write(")");
             TraverseNode(*handler->body);
         }
 
         if (node.finalizer.has_value()) {
-            Write(config_.minify ? "finally" : " finally ");
+            Write(Policy::minify ? "finally" : " finally ");
             TraverseNode(**node.finalizer);
         }
     }
 
-    void CodeGen::Traverse(WhileStatement& node) {
-        Write(config_.minify ? "while(" : "while (");
-        TraverseNode(*node.test);
-        Write(config_.minify ? ")" : ") ");
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(WhileStatement& node) {
+        Write(Policy::minify ? "while(" : "while (");
+        FormatExpressionList(*node.test);
+        Write(Policy::minify ? ")" : ") ");
         TraverseNode(*node.body);
     }
 
-    void CodeGen::Traverse(DoWhileStatement& node) {
-        Write(config_.minify ? "do" : "do ");
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(DoWhileStatement& node) {
+        Write(Policy::minify ? "do" : "do ");
         TraverseNode(*node.body);
-        Write(config_.minify ? "while(" : " while (");
-        TraverseNode(*node.test);
+        Write(Policy::minify ? "while(" : " while (");
+        FormatExpressionList(*node.test);
         Write(");");
     }
 
-    void CodeGen::Traverse(ForStatement& node) {
-        Write(config_.minify ? "for(" : "for (");
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ForStatement& node) {
+        Write(Policy::minify ? "for(" : "for (");
         if (node.init.has_value()) {
             auto init = *node.init;
             if (init->type == SyntaxNodeType::VariableDeclaration) {
@@ -464,20 +700,21 @@ namespace jetpack {
                 TraverseNode(*init);
             }
         }
-        Write(config_.minify ? ";" : "; ");
+        Write(Policy::minify ? ";" : "; ");
         if (node.test.has_value()) {
-            TraverseNode(**node.test);
+            FormatExpressionList(**node.test);
         }
-        Write(config_.minify ? ";" : "; ");
+        Write(Policy::minify ? ";" : "; ");
         if (node.update.has_value()) {
-            TraverseNode(**node.update);
+            FormatExpressionList(**node.update);
         }
-        Write(config_.minify ? ")" : ") ");
+        Write(Policy::minify ? ")" : ") ");
         TraverseNode(*node.body);
     }
 
-    void CodeGen::Traverse(ForInStatement& node) {
-        Write(config_.minify ? "for(" : "for (");
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ForInStatement& node) {
+        Write(Policy::minify ? "for(" : "for (");
         if (node.left->type == SyntaxNodeType::VariableDeclaration) {
             auto decl = dynamic_cast<VariableDeclaration*>(node.left);
             FormatVariableDeclaration(*decl);
@@ -486,12 +723,13 @@ namespace jetpack {
         }
         Write(" in ");
         TraverseNode(*node.right);
-        Write(config_.minify ? ")" : ") ");
+        Write(Policy::minify ? ")" : ") ");
         TraverseNode(*node.body);
     }
 
-    void CodeGen::Traverse(ForOfStatement & node) {
-        Write(config_.minify ? "for(" : "for (");
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ForOfStatement & node) {
+        Write(Policy::minify ? "for(" : "for (");
         if (node.left->type == SyntaxNodeType::VariableDeclaration) {
             auto decl = dynamic_cast<VariableDeclaration*>(node.left);
             FormatVariableDeclaration(*decl);
@@ -500,16 +738,18 @@ namespace jetpack {
         }
         Write(" of ");
         TraverseNode(*node.right);
-        Write(config_.minify ? ")" : ") ");
+        Write(Policy::minify ? ")" : ") ");
         TraverseNode(*node.body);
     }
 
-    void CodeGen::Traverse(DebuggerStatement& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(DebuggerStatement& node) {
         Write("debugger;");
         WriteLineEnd();
     }
 
-    void CodeGen::Traverse(FunctionDeclaration& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(FunctionDeclaration& node) {
         if (node.async) {
             Write("async ");
         }
@@ -521,17 +761,18 @@ namespace jetpack {
         }
 
         if (node.id.has_value()) {
-            Write((*node.id)->name);
+            Write((*node.id)->GetName());
         }
 
         FormatSequence(node.params);
-        if (!config_.minify) {
+        if constexpr (!Policy::minify) {
             Write(" ");
         }
         TraverseNode(*node.body);
     }
 
-    void CodeGen::Traverse(FunctionExpression& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(FunctionExpression& node) {
         if (node.async) {
             Write("async ");
         }
@@ -544,46 +785,50 @@ namespace jetpack {
 
         if (node.id.has_value()) {
             Write(" ");
-            Write((*node.id)->name);
+            Write((*node.id)->GetName());
         }
 
         FormatSequence(node.params);
-        if (!config_.minify) {
+        if constexpr (!Policy::minify) {
             Write(" ");
         }
         TraverseNode(*node.body);
     }
 
-    void CodeGen::Traverse(VariableDeclaration& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(VariableDeclaration& node) {
         FormatVariableDeclaration(node);
         Write(";");
     }
 
-    void CodeGen::Traverse(VariableDeclarator& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(VariableDeclarator& node) {
         TraverseNode(*node.id);
         if (node.init.has_value()) {
-            Write(config_.minify ? "=" : " = ");
+            Write(Policy::minify ? "=" : " = ");
             TraverseNode(**node.init);
         }
     }
 
-    void CodeGen::Traverse(ClassDeclaration& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ClassDeclaration& node) {
         Write("class ");
         if (node.id.has_value()) {
-            Write((*node.id)->name);
+            Write((*node.id)->GetName());
             Write(" ");
         }
         if (node.super_class.has_value()) {
             Write("extends ");
             TraverseNode(**node.super_class);
-            if (!config_.minify) {
+            if constexpr (!Policy::minify) {
                 Write(" ");
             }
         }
         TraverseNode(*node.body);
     }
 
-    void CodeGen::Traverse(ClassBody& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ClassBody& node) {
         Write("{");
         indent_level_++;
 
@@ -601,22 +846,23 @@ namespace jetpack {
         WriteIndentWith("}");
     }
 
-    void CodeGen::Traverse(ImportDeclaration& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ImportDeclaration& node) {
         Write("import ");
 
         std::uint32_t i = 0;
         if (node.specifiers.size() > 0) {
             for (auto& spec : node.specifiers) {
                 if (i > 0) {
-                    Write(config_.minify ? "," : ", ");
+                    Write(Policy::minify ? "," : ", ");
                 }
                 if (spec->type == SyntaxNodeType::ImportDefaultSpecifier) {
                     auto default_ = dynamic_cast<ImportDefaultSpecifier*>(spec);
-                    Write(default_->local->name, *default_);
+                    Write(default_->local->GetName(), *default_);
                     i++;
                 } else if (spec->type == SyntaxNodeType::ImportNamespaceSpecifier) {
                     auto namespace_ = dynamic_cast<ImportNamespaceSpecifier*>(spec);
-                    std::string temp = "* as " + namespace_->local->name;
+                    std::string temp = "* as " + namespace_->local->GetName();
                     Write(temp, *namespace_);
                     i++;
                 } else {
@@ -624,13 +870,13 @@ namespace jetpack {
                 }
             }
             if (i < node.specifiers.size()) {
-                Write(config_.minify ? "{" : "{ ");
+                Write(Policy::minify ? "{" : "{ ");
                 while (true) {
                     auto spec = node.specifiers[i];
                     auto import_ = dynamic_cast<ImportSpecifier*>(spec);
-                    Write(import_->imported->name, *spec);
-                    if (import_->imported->name != import_->local->name) {
-                        std::string temp = " as " + import_->local->name;
+                    Write(import_->imported->GetName(), *spec);
+                    if (import_->imported->GetName() != import_->local->GetName()) {
+                        std::string temp = " as " + import_->local->GetName();
                         Write(temp);
                     }
                     if (++i < node.specifiers.size()) {
@@ -639,7 +885,7 @@ namespace jetpack {
                         break;
                     }
                 }
-                Write(config_.minify ? "}" : " }");
+                Write(Policy::minify ? "}" : " }");
             }
             Write(" from ");
         }
@@ -648,7 +894,8 @@ namespace jetpack {
         Write(";");
     }
 
-    void CodeGen::Traverse(ExportDefaultDeclaration& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ExportDefaultDeclaration& node) {
         Write("export default ");
         TraverseNode(*node.declaration);
         if (ExpressionPrecedence(*node.declaration) > 0 &&
@@ -657,18 +904,19 @@ namespace jetpack {
         }
     }
 
-    void CodeGen::Traverse(ExportNamedDeclaration& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ExportNamedDeclaration& node) {
         Write("export ");
         if (node.declaration.has_value()) {
             TraverseNode(**node.declaration);
         } else {
-            Write(config_.minify ? "{" : "{ ");
+            Write(Policy::minify ? "{" : "{ ");
             if (node.specifiers.size() > 0) {
                 std::uint32_t i = 0;
                 for (auto& spec : node.specifiers) {
-                    Write(spec->local->name, *spec);
-                    if (spec->local->name != spec->exported->name) {
-                        std::string temp = " as " + spec->exported->name;
+                    Write(spec->local->GetName(), *spec);
+                    if (spec->local->GetName() != spec->exported->GetName()) {
+                        std::string temp = " as " + spec->exported->GetName();
                         Write(temp);
                     }
                     if (++i < node.specifiers.size()) {
@@ -678,7 +926,7 @@ namespace jetpack {
                     }
                 }
             }
-            Write(config_.minify ? "}" : " }");
+            Write(Policy::minify ? "}" : " }");
             if (node.source.has_value()) {
                 Write(" from ");
                 this->Traverse(**node.source);
@@ -687,13 +935,15 @@ namespace jetpack {
         }
     }
 
-    void CodeGen::Traverse(ExportAllDeclaration& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ExportAllDeclaration& node) {
         Write("export * from ");
         this->Traverse(*node.source);
         Write(";");
     }
 
-    void CodeGen::Traverse(MethodDefinition& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(MethodDefinition& node) {
         if (node.static_) {
             Write("static ");
         }
@@ -731,14 +981,15 @@ namespace jetpack {
                 TraverseNode(**node.key);
             }
             FormatSequence(fun_expr->params);
-            if (!config_.minify) {
+            if constexpr (!Policy::minify) {
                 Write(" ");
             }
             TraverseNode(*fun_expr->body);
         }
     }
 
-    void CodeGen::Traverse(ArrowFunctionExpression& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ArrowFunctionExpression& node) {
         if (node.async) {
             Write("async ", node);
         }
@@ -746,14 +997,14 @@ namespace jetpack {
         if (!params.empty()) {
             if (params.size() == 1 && (*params.begin())->type == SyntaxNodeType::Identifier) {
                 auto id = dynamic_cast<Identifier*>(*params.begin());
-                Write(id->name, *id);
+                Write(id->GetName(), *id);
             } else {
                 FormatSequence(params);
             }
         } else {
             Write("()");
         }
-        Write(config_.minify ? "=>" : " => ");
+        Write(Policy::minify ? "=>" : " => ");
         if (node.body->type == SyntaxNodeType::ObjectExpression) {
             Write("(");
             auto oe = dynamic_cast<ObjectExpression*>(node.body);
@@ -764,25 +1015,30 @@ namespace jetpack {
         }
     }
 
-    void CodeGen::Traverse(ThisExpression& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ThisExpression& node) {
         Write("this", node);
     }
 
-    void CodeGen::Traverse(Super& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(Super& node) {
         Write("super", node);
     }
 
-    void CodeGen::Traverse(RestElement& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(RestElement& node) {
         Write("...");
         TraverseNode(*node.argument);
     }
 
-    void CodeGen::Traverse(SpreadElement& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(SpreadElement& node) {
         Write("...");
         TraverseNode(*node.argument);
     }
 
-    void CodeGen::Traverse(YieldExpression& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(YieldExpression& node) {
         if (node.delegate) {
             Write("yield*");
         } else {
@@ -795,35 +1051,39 @@ namespace jetpack {
         }
     }
 
-    void CodeGen::Traverse(AwaitExpression& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(AwaitExpression& node) {
         Write("await ");
         TraverseNode(*node.argument);
     }
 
-    void CodeGen::Traverse(TemplateLiteral& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(TemplateLiteral& node) {
         Write("`");
         for (std::size_t i = 0; i < node.expressions.size(); i++) {
             auto expr = node.expressions[i];
-            Write(node.quasis[i]->cooked);
+            Write(node.quasis[i]->raw);
             Write("${");
             TraverseNode(*expr);
             Write("}");
         }
-        Write(node.quasis[node.quasis.size() - 1]->cooked);
+        Write(node.quasis[node.quasis.size() - 1]->raw);
         Write("`");
     }
 
-    void CodeGen::Traverse(TaggedTemplateExpression& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(TaggedTemplateExpression& node) {
         TraverseNode(*node.tag);
         TraverseNode(*node.quasi);
     }
 
-    void CodeGen::Traverse(ObjectExpression& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ObjectExpression& node) {
         indent_level_++;
         Write("{");
         if (!node.properties.empty()) {
             WriteLineEnd();
-            std::string comma = "," + config_.line_end;
+            std::string comma = Policy::minify ? "," : "," + config_.line_end;
             std::size_t i = 0;
             while (true) {
                 auto prop = node.properties[i];
@@ -841,17 +1101,18 @@ namespace jetpack {
         WriteIndentWith("}");
     }
 
-    void CodeGen::Traverse(Property& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(Property& node) {
         switch (node.kind) {
             case VarKind::Get: {
                 Write("get ");
-                TraverseNode(*node.key);
+                FormatPropertyKey(*node.key);
                 if (!node.value.has_value()) return;
                 auto fun = dynamic_cast<FunctionExpression*>(*node.value);
                 if (fun == nullptr) return;
 
                 FormatSequence(fun->params);
-                if (!config_.minify) {
+                if constexpr (!Policy::minify) {
                     Write(" ");
                 }
                 TraverseNode(*fun->body);
@@ -860,13 +1121,13 @@ namespace jetpack {
 
             case VarKind::Set: {
                 Write("set ");
-                TraverseNode(*node.key);
+                FormatPropertyKey(*node.key);
                 if (!node.value.has_value()) return;
                 auto fun = dynamic_cast<FunctionExpression*>(*node.value);
                 if (fun == nullptr) return;
 
                 FormatSequence(fun->params);
-                if (!config_.minify) {
+                if constexpr (!Policy::minify) {
                     Write(" ");
                 }
                 TraverseNode(*fun->body);
@@ -880,7 +1141,7 @@ namespace jetpack {
                     && (*node.value)->type == SyntaxNodeType::Identifier) {
                     auto key_id = dynamic_cast<Identifier*>(node.key);
                     auto val_id = dynamic_cast<Identifier*>(*node.value);
-                    shorthand = key_id->name == val_id->name;
+                    shorthand = key_id->GetName() == val_id->GetName();
                 }
                 if (!shorthand) {
                     if (node.computed) {
@@ -888,12 +1149,12 @@ namespace jetpack {
                         TraverseNode(*node.key);
                         Write("]");
                     } else {
-                        TraverseNode(*node.key);
+                        FormatPropertyKey(*node.key);
                     }
                 }
                 if (node.value.has_value()) {
                     if (!shorthand) {
-                        Write(config_.minify ? ":" : ": ");
+                        Write(Policy::minify ? ":" : ": ");
                     }
                     TraverseNode(**node.value);
                 }
@@ -902,7 +1163,8 @@ namespace jetpack {
         }
     }
 
-    void CodeGen::Traverse(SequenceExpression& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(SequenceExpression& node) {
         NodeList<SyntaxNode> nodes;
         for (auto& i : node.expressions) {
             nodes.push_back(i);
@@ -910,10 +1172,11 @@ namespace jetpack {
         FormatSequence(nodes);
     }
 
-    void CodeGen::Traverse(UnaryExpression& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(UnaryExpression& node) {
         if (node.prefix) {
             Write(node.operator_);
-            if (node.operator_.size() > 1) {
+            if (node.operator_.size() > 1 || StartsWithSign(*node.argument, node.operator_[0])) {
                 Write(" ");
             }
             UnaryExpression unaryExpression;
@@ -932,9 +1195,10 @@ namespace jetpack {
         }
     }
 
-    void CodeGen::Traverse(AssignmentExpression& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(AssignmentExpression& node) {
         TraverseNode(*node.left);
-        if (config_.minify) {
+        if constexpr (Policy::minify) {
             Write(node.operator_);
         } else {
             Write(std::string(" ") + node.operator_ + " ");
@@ -942,20 +1206,26 @@ namespace jetpack {
         TraverseNode(*node.right);
     }
 
-    void CodeGen::Traverse(AssignmentPattern& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(AssignmentPattern& node) {
         TraverseNode(*node.left);
-        Write(config_.minify ? "=" : " = ");
+        Write(Policy::minify ? "=" : " = ");
         TraverseNode(*node.right);
     }
 
-    void CodeGen::Traverse(BinaryExpression& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(BinaryExpression& node) {
         bool is_in = node.operator_ == "in";
         if (is_in) {
             Write("(");
         }
         FormatBinaryExpression(*node.left, node, false);
-        if (config_.minify && node.operator_ != "in" && node.operator_ != "instanceof") {
+        if (Policy::minify && node.operator_ != "in" && node.operator_ != "instanceof") {
             Write(node.operator_);
+            // `a - -1` should not be `a--1`
+            if (StartsWithSign(*node.right, node.operator_.back())) {
+                Write(" ");
+            }
         } else {
             Write(" " + node.operator_ + " ");
         }
@@ -965,23 +1235,28 @@ namespace jetpack {
         }
     }
 
-    void CodeGen::Traverse(ConditionalExpression& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ConditionalExpression& node) {
         ConditionalExpression conditionalExpression;
-        if (ExpressionPrecedence(*node.test) >
-            ExpressionPrecedence(conditionalExpression)) {
+        int test_precedence = ExpressionPrecedence(*node.test);
+        if (test_precedence > ExpressionPrecedence(conditionalExpression) && test_precedence != needs_parentheses) {
             TraverseNode(*node.test);
         } else {
             Write("(");
             TraverseNode(*node.test);
             Write(")");
         }
-        Write(config_.minify ? "?" : " ? ");
+        Write(Policy::minify ? "?" : " ? ");
         TraverseNode(*node.consequent);
-        Write(config_.minify ? ":" : " : ");
+        Write(Policy::minify ? ":" : " : ");
         TraverseNode(*node.alternate);
     }
 
-    void CodeGen::Traverse(NewExpression& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(NewExpression& node) {
+        if (node.pure && !Policy::minify) {
+            Write("/*#__PURE__*/ ");
+        }
         Write("new ");
         CallExpression callExpression;
         if (ExpressionPrecedence(*node.callee) <
@@ -996,7 +1271,8 @@ namespace jetpack {
         FormatSequence(node.arguments);
     }
 
-    void CodeGen::Traverse(MemberExpression& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(MemberExpression& node) {
         MemberExpression memberExpression;
         if (ExpressionPrecedence(*node.object) < ExpressionPrecedence(memberExpression)) {
             Write('(');
@@ -1005,6 +1281,22 @@ namespace jetpack {
         } else {
             TraverseNode(*node.object);
         }
+        if (node.computed && Policy::minify && node.property->type == SyntaxNodeType::Literal) {
+            auto lit = dynamic_cast<Literal*>(node.property);
+            // a["b"] -> a.b
+            if (lit->ty == Literal::Ty::String && IsIdentifierName(lit->str_)) {
+                Write('.');
+                Write(lit->str_, *lit);
+                return;
+            }
+            // a["1"] -> a[1]
+            if (lit->ty == Literal::Ty::String && IsIndexName(lit->str_)) {
+                Write('[');
+                Write(lit->str_, *lit);
+                Write(']');
+                return;
+            }
+        }
         if (node.computed) {
             Write('[');
             TraverseNode(*node.property);
@@ -1015,7 +1307,12 @@ namespace jetpack {
         }
     }
 
-    void CodeGen::Traverse(CallExpression& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(CallExpression& node) {
+        // keep the annotation for the minifiers after us
+        if (node.pure && !Policy::minify) {
+            Write("/*#__PURE__*/ ");
+        }
         CallExpression callExpression;
         if (ExpressionPrecedence(*node.callee) <
             ExpressionPrecedence(callExpression)) {
@@ -1028,31 +1325,32 @@ namespace jetpack {
         FormatSequence(node.arguments);
     }
 
-    void CodeGen::Traverse(Identifier& node) {
-        if (config_.minify && node.name == "undefined") {
-            Write("void 0");
-        } else {
-            Write(node.name, node);
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(Identifier& node) {
+        const std::string& name = node.GetName();
+        if constexpr (Policy::sourcemap) {
+            // the renamed variables are mapped back to the original names
+            if (name != node.name) {
+                mapping_collector_.AddMapping(node.name, node.location, d_.column);
+                Write(name);
+                return;
+            }
         }
+        Write(name, node);
     }
 
-    void CodeGen::Traverse(Literal& lit) {
-        if (config_.minify && lit.ty == Literal::Ty::Boolean) {
-            if (lit.raw == "true") {
-                Write("!0");
-            } else {
-                Write("!1");
-            }
-        } else {
-            Write(lit.raw, lit);
-        }
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(Literal& lit) {
+        Write(lit.raw, lit);
     }
 
-    void CodeGen::Traverse(RegexLiteral &lit) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(RegexLiteral &lit) {
         Write(lit.value, lit);
     }
 
-    void CodeGen::Traverse(UpdateExpression& update) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(UpdateExpression& update) {
         if (update.prefix) {
             Write(update.operator_);
             TraverseNode(*update.argument);
@@ -1062,8 +1360,9 @@ namespace jetpack {
         }
     }
 
-    void CodeGen::Traverse(ObjectPattern& node) {
-        Write(config_.minify ? "{" : "{ ");
+    template <typename Policy>
+    void CodeGenImpl<Policy>::Traverse(ObjectPattern& node) {
+        Write(Policy::minify ? "{" : "{ ");
         for (std::size_t i = 0; ;) {
             TraverseNode(*node.properties[i]);
             if (++i < node.properties.size()) {
@@ -1072,10 +1371,11 @@ namespace jetpack {
                 break;
             }
         }
-        Write(config_.minify ? "}" : " }");
+        Write(Policy::minify ? "}" : " }");
     }
 
-    void CodeGen::SortComments(std::vector<Sp<Comment>> comments) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::SortComments(std::vector<Sp<Comment>> comments) {
         std::sort(comments.begin(), comments.end(), [](const Sp<Comment>& a, const Sp<Comment>& b) {
             return a->range_.first < b->range_.first;
         });
@@ -1085,14 +1385,24 @@ namespace jetpack {
 //    }
 
         for (auto& i : comments) {
+            // the scanner may collect a comment again when it looks ahead
+            if (!ordered_comments_.empty() && ordered_comments_.back()->range_ == i->range_) {
+                continue;
+            }
+            // written by the annotated call
+            if (i->value_.find("#__PURE__") != std::string::npos ||
+                i->value_.find("@__PURE__") != std::string::npos) {
+                continue;
+            }
             ordered_comments_.push_back(i);
         }
     }
 
-    void CodeGen::WriteTopCommentBefore_(SyntaxNode& node) {
+    template <typename Policy>
+    void CodeGenImpl<Policy>::WriteTopCommentBefore_(std::uint32_t offset) {
         while (!ordered_comments_.empty()) {
             auto& top = ordered_comments_.front();
-            if (top->range_.second < node.range.first) {
+            if (top->range_.second < offset) {
                 if (top->multi_line_) {
                     Write("/*");
                     Write(top->value_);
@@ -1109,5 +1419,48 @@ namespace jetpack {
         }
     }
 
+
+    template <bool Minify, bool Sourcemap>
+    static std::unique_ptr<CodeGenBase> MakeCodeGen(const CodeGenConfig& config, CodeGenFragment& d) {
+        if (config.comments) {
+            return std::make_unique<CodeGenImpl<CodeGenPolicy<Minify, Sourcemap, true>>>(config, d);
+        }
+        return std::make_unique<CodeGenImpl<CodeGenPolicy<Minify, Sourcemap, false>>>(config, d);
+    }
+
+    CodeGen::CodeGen(
+            const CodeGenConfig& config,
+            CodeGenFragment& d) {
+        if (config.minify) {
+            impl_ = config.sourcemap ? MakeCodeGen<true, true>(config, d) : MakeCodeGen<true, false>(config, d);
+        } else {
+            impl_ = config.sourcemap ? MakeCodeGen<false, true>(config, d) : MakeCodeGen<false, false>(config, d);
+        }
+    }
+
+    std::vector<std::size_t> CodeGen::SplitModule(const std::vector<SyntaxNode*>& stmts, std::size_t part_size) {
+        std::vector<std::size_t> ends;
+        if (stmts.empty()) {
+            return ends;
+        }
+
+        std::optional<std::uint32_t> part_begin;
+        for (std::size_t i = 0; i < stmts.size(); i++) {
+            // a synthesized statement never begins a part
+            if (IsSynthesized(*stmts[i])) {
+                continue;
+            }
+            auto first = stmts[i]->range.first;
+            if (!part_begin.has_value()) {
+                part_begin = first;
+            } else if (first > *part_begin && first - *part_begin >= part_size) {
+                ends.push_back(i);
+                part_begin = first;
+            }
+        }
+        ends.push_back(stmts.size());
+        return ends;
+    }
+
 }
 
@@ -6,11 +6,12 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <cinttypes>
 #include <deque>
-#include "NodeTraverser.h"
-#include "AutoNodeTraverser.h"
+#include <vector>
+#include "StaticNodeTraverser.h"
 #include "CodeGenFragment.h"
 #include "utils/string/UString.h"
 #include "utils/Common.h"
@@ -20,33 +21,51 @@
 namespace jetpack {
 
     /**
-     * Reference: https://github.com/davidbonnet/astring/blob/master/src/astring.js
+     * The options known at compile time,
+     * the branches of the others are dropped.
      */
-    class CodeGen: public NodeTraverser {
-    private:
-        class HasCallExpressionTraverser: public AutoNodeTraverser {
-        public:
-            bool has_call = false;
+    template <bool Minify, bool Sourcemap, bool Comments>
+    struct CodeGenPolicy {
+        static constexpr bool minify = Minify;
+        static constexpr bool sourcemap = Sourcemap;
+        static constexpr bool comments = Comments;
+    };
+
+    class CodeGenBase {
+    public:
+        virtual ~CodeGenBase() = default;
 
-            bool TraverseBefore(CallExpression* node) override  {
-                has_call = true;
-                return false;
-            }
+        virtual void TraverseNode(SyntaxNode& node) = 0;
 
-        };
+        virtual void TraverseModulePart(Module& node, const std::vector<SyntaxNode*>& stmts, std::size_t begin, std::size_t end) = 0;
 
+    };
+
+    /**
+     * Reference: https://github.com/davidbonnet/astring/blob/master/src/astring.js
+     */
+    template <typename Policy>
+    class CodeGenImpl final: public CodeGenBase, public StaticNodeTraverser<CodeGenImpl<Policy>> {
     public:
-        explicit CodeGen(
+        explicit CodeGenImpl(
                  const CodeGenConfig& config,
                  CodeGenFragment& d);
 
+        using StaticNodeTraverser<CodeGenImpl<Policy>>::Traverse;
+
+        inline void TraverseNode(SyntaxNode& node) override {
+            StaticNodeTraverser<CodeGenImpl<Policy>>::TraverseNode(node);
+        }
+
+        void TraverseModulePart(Module& node, const std::vector<SyntaxNode*>& stmts, std::size_t begin, std::size_t end) override;
+
     private:
         inline void Write(char ch) {
-            d_.content += ch;
+            d_.content.Append(ch);
             d_.column += 1;
         }
 
-        void Write(const std::string& str);
+        void Write(std::string_view str);
 
         void Write(const std::string& str, SyntaxNode& node);
 
@@ -65,68 +84,84 @@ namespace jetpack {
 
         void FormatVariableDeclaration(VariableDeclaration& node);
         void FormatSequence(NodeList<SyntaxNode>& params);
+
+        /**
+         * The sequence is not parenthesized,
+         * e.g. the expression of statement, `return` and the test of `if`
+         */
+        void FormatExpressionList(SyntaxNode& node);
+
+        /**
+         * The quotes are removed if it's minified
+         */
+        void FormatPropertyKey(SyntaxNode& key);
+
+        /**
+         * Remove the `;` of the last statement in a block when minifying
+         */
+        void OmitSemicolonBefore(SyntaxNode& last);
         void FormatBinaryExpression(Expression& expr, BinaryExpression& parent, bool is_right);
         bool HasCallExpression(SyntaxNode* node);
         bool ExpressionNeedsParenthesis(Expression& node, BinaryExpression& parent, bool is_right);
 
     public:
-        void Traverse(Script& node) override;
-        void Traverse(Module& node) override;
-        void Traverse(Literal& lit) override;
-        void Traverse(RegexLiteral& lit) override;
-        void Traverse(ArrayExpression& node) override;
-        void Traverse(BlockStatement& node) override;
-        void Traverse(EmptyStatement& node) override;
-        void Traverse(ExpressionStatement& node) override;
-        void Traverse(IfStatement& node) override;
-        void Traverse(LabeledStatement& node) override;
-        void Traverse(BreakStatement& node) override;
-        void Traverse(ContinueStatement& node) override;
-        void Traverse(WithStatement& node) override;
-        void Traverse(SwitchStatement& node) override;
-        void Traverse(ReturnStatement& node) override;
-        void Traverse(ThrowStatement& node) override;
-        void Traverse(TryStatement& node) override;
-        void Traverse(WhileStatement& node) override;
-        void Traverse(DoWhileStatement& node) override;
-        void Traverse(ForStatement& node) override;
-        void Traverse(ForInStatement& node) override;
-        void Traverse(ForOfStatement& node) override;
-        void Traverse(DebuggerStatement& node) override;
-        void Traverse(FunctionDeclaration& node) override;
-        void Traverse(FunctionExpression& node) override;
-        void Traverse(VariableDeclaration& node) override;
-        void Traverse(VariableDeclarator& node) override;
-        void Traverse(ClassDeclaration& node) override;
-        void Traverse(ClassBody& node) override;
-        void Traverse(ImportDeclaration& node) override;
-        void Traverse(ExportDefaultDeclaration& node) override;
-        void Traverse(ExportNamedDeclaration& node) override;
-        void Traverse(ExportAllDeclaration& node) override;
-        void Traverse(MethodDefinition& node) override;
-        void Traverse(ArrowFunctionExpression& node) override;
-        void Traverse(ObjectExpression& node) override;
-        void Traverse(ThisExpression& node) override;
-        void Traverse(Super& node) override;
-        void Traverse(RestElement& node) override;
-        void Traverse(SpreadElement& node) override;
-        void Traverse(YieldExpression& node) override;
-        void Traverse(AwaitExpression& node) override;
-        void Traverse(TemplateLiteral& node) override;
-        void Traverse(TaggedTemplateExpression& node) override;
-        void Traverse(Property& node) override;
-        void Traverse(SequenceExpression& node) override;
-        void Traverse(UnaryExpression& node) override;
-        void Traverse(AssignmentExpression& node) override;
-        void Traverse(AssignmentPattern& node) override;
-        void Traverse(BinaryExpression& node) override;
-        void Traverse(ConditionalExpression& node) override;
-        void Traverse(NewExpression& node) override;
-        void Traverse(CallExpression& node) override;
-        void Traverse(MemberExpression& node) override;
-        void Traverse(Identifier& node) override;
-        void Traverse(UpdateExpression& node) override;
-        void Traverse(ObjectPattern& node) override;
+        void Traverse(Script& node);
+        void Traverse(Module& node);
+        void Traverse(Literal& lit);
+        void Traverse(RegexLiteral& lit);
+        void Traverse(ArrayExpression& node);
+        void Traverse(BlockStatement& node);
+        void Traverse(EmptyStatement& node);
+        void Traverse(ExpressionStatement& node);
+        void Traverse(IfStatement& node);
+        void Traverse(LabeledStatement& node);
+        void Traverse(BreakStatement& node);
+        void Traverse(ContinueStatement& node);
+        void Traverse(WithStatement& node);
+        void Traverse(SwitchStatement& node);
+        void Traverse(ReturnStatement& node);
+        void Traverse(ThrowStatement& node);
+        void Traverse(TryStatement& node);
+        void Traverse(WhileStatement& node);
+        void Traverse(DoWhileStatement& node);
+        void Traverse(ForStatement& node);
+        void Traverse(ForInStatement& node);
+        void Traverse(ForOfStatement& node);
+        void Traverse(DebuggerStatement& node);
+        void Traverse(FunctionDeclaration& node);
+        void Traverse(FunctionExpression& node);
+        void Traverse(VariableDeclaration& node);
+        void Traverse(VariableDeclarator& node);
+        void Traverse(ClassDeclaration& node);
+        void Traverse(ClassBody& node);
+        void Traverse(ImportDeclaration& node);
+        void Traverse(ExportDefaultDeclaration& node);
+        void Traverse(ExportNamedDeclaration& node);
+        void Traverse(ExportAllDeclaration& node);
+        void Traverse(MethodDefinition& node);
+        void Traverse(ArrowFunctionExpression& node);
+        void Traverse(ObjectExpression& node);
+        void Traverse(ThisExpression& node);
+        void Traverse(Super& node);
+        void Traverse(RestElement& node);
+        void Traverse(SpreadElement& node);
+        void Traverse(YieldExpression& node);
+        void Traverse(AwaitExpression& node);
+        void Traverse(TemplateLiteral& node);
+        void Traverse(TaggedTemplateExpression& node);
+        void Traverse(Property& node);
+        void Traverse(SequenceExpression& node);
+        void Traverse(UnaryExpression& node);
+        void Traverse(AssignmentExpression& node);
+        void Traverse(AssignmentPattern& node);
+        void Traverse(BinaryExpression& node);
+        void Traverse(ConditionalExpression& node);
+        void Traverse(NewExpression& node);
+        void Traverse(CallExpression& node);
+        void Traverse(MemberExpression& node);
+        void Traverse(Identifier& node);
+        void Traverse(UpdateExpression& node);
+        void Traverse(ObjectPattern& node);
 
 //        [[nodiscard]]
 //        inline MappingCollector* SourcemapCollector() {
@@ -136,12 +171,15 @@ namespace jetpack {
     private:
 
         inline void WriteCommentBefore(SyntaxNode& node) {
-            if (!config_.comments) return;
+            if constexpr (!Policy::comments) return;
 
-            WriteTopCommentBefore_(node);
+            WriteTopCommentBefore_(node.range.first);
         }
 
-        void WriteTopCommentBefore_(SyntaxNode& node);
+        /**
+         * Write the comments which end before the offset.
+         */
+        void WriteTopCommentBefore_(std::uint32_t offset);
 
         std::deque<Sp<Comment>> ordered_comments_;
         void SortComments(std::vector<Sp<Comment>> comments);
@@ -155,4 +193,43 @@ namespace jetpack {
 
     };
 
+    /**
+     * Generate the code by the generator specialized for the config.
+     */
+    class CodeGen {
+    public:
+        explicit CodeGen(
+                 const CodeGenConfig& config,
+                 CodeGenFragment& d);
+
+        /**
+         * Split the top-level statements of a huge module,
+         * each part has about `part_size` bytes of source.
+         *
+         * @return the end index of each part
+         */
+        static std::vector<std::size_t> SplitModule(const std::vector<SyntaxNode*>& stmts, std::size_t part_size);
+
+        inline void Traverse(SyntaxNode& node) {
+            impl_->TraverseNode(node);
+        }
+
+        inline void TraverseNode(SyntaxNode& node) {
+            impl_->TraverseNode(node);
+        }
+
+        /**
+         * Generate the top-level statements in [begin, end) of the module.
+         * The parts are independent, they can be generated in parallel,
+         * and concatenated in order, e.g. by ModuleCompositor::Append().
+         */
+        inline void TraverseModulePart(Module& node, const std::vector<SyntaxNode*>& stmts, std::size_t begin, std::size_t end) {
+            impl_->TraverseModulePart(node, stmts, begin, end);
+        }
+
+    private:
+        std::unique_ptr<CodeGenBase> impl_;
+
+    };
+
 }
@@ -15,6 +15,12 @@ namespace jetpack {
         std::string  indent = "  ";
         std::string  line_end = "\n";
         bool     sourcemap = false;
+
+        /**
+         * Only the first mapping of each generated line is recorded,
+         * without names. Cheaper for the development builds.
+         */
+        bool     sourcemap_lines = false;
         bool     comments = true;
 
     };
@@ -3,17 +3,19 @@
 
 #pragma once
 #include "parser/SyntaxNodes.h"
+#include "StaticNodeTraverser.h"
 
 namespace jetpack {
 
 
-    class NodeTraverser {
+    /**
+     * The virtual adapter of StaticNodeTraverser.
+     */
+    class NodeTraverser: public StaticNodeTraverser<NodeTraverser> {
     public:
 
         NodeTraverser() = default;
 
-        void TraverseNode(SyntaxNode& node);
-
         virtual void Traverse(ArrayExpression& node) {}
         virtual void Traverse(ArrayPattern& node) {}
         virtual void Traverse(ArrowFunctionExpression& node) {}
@@ -161,5 +163,7 @@ namespace jetpack {
 
     };
 
+    extern template class StaticNodeTraverser<NodeTraverser>;
+
 }
 
@@ -0,0 +1,1723 @@
+//
+// Created by Duzhong Chen on 2021/12/2.
+//
+
+#pragma once
+#include "parser/SyntaxNodes.h"
+
+namespace jetpack {
+
+    /**
+     * The static version of AutoNodeTraverser.
+     * The hooks of `Derived` are called directly,
+     * the ones not defined by it are empty and inlined away.
+     *
+     * `Derived` should declare
+     * `using StaticAutoNodeTraverser<Derived>::TraverseBefore;` and
+     * `using StaticAutoNodeTraverser<Derived>::TraverseAfter;`,
+     * otherwise its hooks hide the default ones.
+     */
+    template <typename Derived>
+    class StaticAutoNodeTraverser {
+    public:
+
+        StaticAutoNodeTraverser() = default;
+
+        void TraverseNode(SyntaxNode* node) {
+            switch (node->type) {
+
+                case SyntaxNodeType::ArrayExpression: {
+                    auto child = dynamic_cast<ArrayExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    for (auto& i : child->elements) {
+                        if (i.has_value()) {
+                            TraverseNode(*i);
+                        }
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ArrayPattern: {
+                    auto child = dynamic_cast<ArrayPattern*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    for (auto& i : child->elements) {
+                        if (i.has_value()) {
+                            TraverseNode(*i);
+                        }
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ArrowFunctionExpression: {
+                    auto child = dynamic_cast<ArrowFunctionExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    if (child->id) {
+                        TraverseNode(*child->id);
+                    }
+
+                    for (auto i : child->params) {
+                        TraverseNode(i);
+                    }
+                    TraverseNode(child->body);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::AssignmentExpression: {
+                    auto child = dynamic_cast<AssignmentExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->left);
+                    TraverseNode(child->right);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::AssignmentPattern: {
+                    auto child = dynamic_cast<AssignmentPattern*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->left);
+                    TraverseNode(child->right);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::AwaitExpression: {
+                    auto child = dynamic_cast<AwaitExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->argument);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::BinaryExpression: {
+                    auto child = dynamic_cast<BinaryExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->left);
+                    TraverseNode(child->right);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::BlockStatement: {
+                    auto child = dynamic_cast<BlockStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    for (auto i : child->body) {
+                        TraverseNode(i);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::BreakStatement: {
+                    auto child = dynamic_cast<BreakStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    if (child->label) {
+                        TraverseNode(*child->label);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::CallExpression: {
+                    auto child = dynamic_cast<CallExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->callee);
+
+                    for (auto i : child->arguments) {
+                        TraverseNode(i);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::CatchClause: {
+                    auto child = dynamic_cast<CatchClause*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->param);
+                    TraverseNode(child->body);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ClassBody: {
+                    auto child = dynamic_cast<ClassBody*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    for (auto& i : child->body) {
+                        TraverseNode(i);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ClassDeclaration: {
+                    auto child = dynamic_cast<ClassDeclaration*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    if (child->id) {
+                        TraverseNode(*child->id);
+                    }
+                    if (child->super_class) {
+                        TraverseNode(*child->super_class);
+                    }
+                    TraverseNode(child->body);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ClassExpression: {
+                    auto child = dynamic_cast<ClassExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    if (child->id) {
+                        TraverseNode(*child->id);
+                    }
+                    if (child->super_class) {
+                        TraverseNode(*child->super_class);
+                    }
+                    if (child->body) {
+                        TraverseNode(*child->body);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ConditionalExpression: {
+                    auto child = dynamic_cast<ConditionalExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->test);
+                    TraverseNode(child->consequent);
+                    TraverseNode(child->alternate);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ContinueStatement: {
+                    auto child = dynamic_cast<ContinueStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    if (child->label) {
+                        TraverseNode(*child->label);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::DebuggerStatement: {
+                    auto child = dynamic_cast<DebuggerStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::Directive: {
+                    auto child = dynamic_cast<Directive*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->expression);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::DoWhileStatement: {
+                    auto child = dynamic_cast<DoWhileStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->body);
+                    TraverseNode(child->test);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::EmptyStatement: {
+                    auto child = dynamic_cast<EmptyStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ExportAllDeclaration: {
+                    auto child = dynamic_cast<ExportAllDeclaration*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->source);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ExportDefaultDeclaration: {
+                    auto child = dynamic_cast<ExportDefaultDeclaration*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->declaration);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ExportNamedDeclaration: {
+                    auto child = dynamic_cast<ExportNamedDeclaration*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    if (child->declaration) {
+                        TraverseNode(*child->declaration);
+                    }
+
+                    for (auto& i : child->specifiers) {
+                        TraverseNode(i);
+                    }
+                    if (child->source) {
+                        TraverseNode(*child->source);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ExportSpecifier: {
+                    auto child = dynamic_cast<ExportSpecifier*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->exported);
+                    TraverseNode(child->local);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ExpressionStatement: {
+                    auto child = dynamic_cast<ExpressionStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->expression);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ForInStatement: {
+                    auto child = dynamic_cast<ForInStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->left);
+                    TraverseNode(child->right);
+                    TraverseNode(child->body);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ForOfStatement: {
+                    auto child = dynamic_cast<ForOfStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->left);
+                    TraverseNode(child->right);
+                    TraverseNode(child->body);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ForStatement: {
+                    auto child = dynamic_cast<ForStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    if (child->init) {
+                        TraverseNode(*child->init);
+                    }
+                    if (child->test) {
+                        TraverseNode(*child->test);
+                    }
+                    if (child->update) {
+                        TraverseNode(*child->update);
+                    }
+                    TraverseNode(child->body);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::FunctionDeclaration: {
+                    auto child = dynamic_cast<FunctionDeclaration*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    if (child->id) {
+                        TraverseNode(*child->id);
+                    }
+
+                    for (auto i : child->params) {
+                        TraverseNode(i);
+                    }
+                    TraverseNode(child->body);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::FunctionExpression: {
+                    auto child = dynamic_cast<FunctionExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    if (child->id) {
+                        TraverseNode(*child->id);
+                    }
+
+                    for (auto i : child->params) {
+                        TraverseNode(i);
+                    }
+                    TraverseNode(child->body);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::Identifier: {
+                    auto child = dynamic_cast<Identifier*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::IfStatement: {
+                    auto child = dynamic_cast<IfStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->test);
+                    TraverseNode(child->consequent);
+                    if (child->alternate) {
+                        TraverseNode(*child->alternate);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::Import: {
+                    auto child = dynamic_cast<Import*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ImportDeclaration: {
+                    auto child = dynamic_cast<ImportDeclaration*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    for (auto& i : child->specifiers) {
+                        TraverseNode(i);
+                    }
+                    TraverseNode(child->source);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ImportDefaultSpecifier: {
+                    auto child = dynamic_cast<ImportDefaultSpecifier*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->local);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ImportNamespaceSpecifier: {
+                    auto child = dynamic_cast<ImportNamespaceSpecifier*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->local);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ImportSpecifier: {
+                    auto child = dynamic_cast<ImportSpecifier*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->local);
+                    TraverseNode(child->imported);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::LabeledStatement: {
+                    auto child = dynamic_cast<LabeledStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->label);
+                    TraverseNode(child->body);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::Literal: {
+                    auto child = dynamic_cast<Literal*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::MetaProperty: {
+                    auto child = dynamic_cast<MetaProperty*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->meta);
+                    TraverseNode(child->property);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::MethodDefinition: {
+                    auto child = dynamic_cast<MethodDefinition*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    if (child->key) {
+                        TraverseNode(*child->key);
+                    }
+                    if (child->value) {
+                        TraverseNode(*child->value);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::Module: {
+                    auto child = dynamic_cast<Module*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    for (auto i : child->body) {
+                        TraverseNode(i);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::NewExpression: {
+                    auto child = dynamic_cast<NewExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->callee);
+
+                    for (auto i : child->arguments) {
+                        TraverseNode(i);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ObjectExpression: {
+                    auto child = dynamic_cast<ObjectExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    for (auto& i : child->properties) {
+                        TraverseNode(i);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ObjectPattern: {
+                    auto child = dynamic_cast<ObjectPattern*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    for (auto& i : child->properties) {
+                        TraverseNode(i);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::Property: {
+                    auto child = dynamic_cast<Property*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->key);
+                    if (child->value) {
+                        TraverseNode(*child->value);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::RegexLiteral: {
+                    auto child = dynamic_cast<RegexLiteral*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::RestElement: {
+                    auto child = dynamic_cast<RestElement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->argument);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ReturnStatement: {
+                    auto child = dynamic_cast<ReturnStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    if (child->argument) {
+                        TraverseNode(*child->argument);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::Script: {
+                    auto child = dynamic_cast<Script*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    for (auto i : child->body) {
+                        TraverseNode(i);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::SequenceExpression: {
+                    auto child = dynamic_cast<SequenceExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    for (auto& i : child->expressions) {
+                        TraverseNode(i);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::SpreadElement: {
+                    auto child = dynamic_cast<SpreadElement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->argument);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::MemberExpression: {
+                    auto child = dynamic_cast<MemberExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->object);
+                    TraverseNode(child->property);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::Super: {
+                    auto child = dynamic_cast<Super*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::SwitchCase: {
+                    auto child = dynamic_cast<SwitchCase*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    if (child->test) {
+                        TraverseNode(*child->test);
+                    }
+
+                    for (auto& i : child->consequent) {
+                        TraverseNode(i);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::SwitchStatement: {
+                    auto child = dynamic_cast<SwitchStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->discrimiant);
+
+                    for (auto& i : child->cases) {
+                        TraverseNode(i);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TaggedTemplateExpression: {
+                    auto child = dynamic_cast<TaggedTemplateExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->tag);
+                    TraverseNode(child->quasi);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TemplateElement: {
+                    auto child = dynamic_cast<TemplateElement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TemplateLiteral: {
+                    auto child = dynamic_cast<TemplateLiteral*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    for (auto& i : child->quasis) {
+                        TraverseNode(i);
+                    }
+
+                    for (auto& i : child->expressions) {
+                        TraverseNode(i);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ThisExpression: {
+                    auto child = dynamic_cast<ThisExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ThrowStatement: {
+                    auto child = dynamic_cast<ThrowStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->argument);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TryStatement: {
+                    auto child = dynamic_cast<TryStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->block);
+                    if (child->handler) {
+                        TraverseNode(*child->handler);
+                    }
+                    if (child->finalizer) {
+                        TraverseNode(*child->finalizer);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::UnaryExpression: {
+                    auto child = dynamic_cast<UnaryExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->argument);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::UpdateExpression: {
+                    auto child = dynamic_cast<UpdateExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->argument);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::VariableDeclaration: {
+                    auto child = dynamic_cast<VariableDeclaration*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    for (auto& i : child->declarations) {
+                        TraverseNode(i);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::VariableDeclarator: {
+                    auto child = dynamic_cast<VariableDeclarator*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->id);
+                    if (child->init) {
+                        TraverseNode(*child->init);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::WhileStatement: {
+                    auto child = dynamic_cast<WhileStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->test);
+                    TraverseNode(child->body);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::WithStatement: {
+                    auto child = dynamic_cast<WithStatement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->object);
+                    TraverseNode(child->body);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::YieldExpression: {
+                    auto child = dynamic_cast<YieldExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    if (child->argument) {
+                        TraverseNode(*child->argument);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::ArrowParameterPlaceHolder: {
+                    auto child = dynamic_cast<ArrowParameterPlaceHolder*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    for (auto i : child->params) {
+                        TraverseNode(i);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::JSXClosingElement: {
+                    auto child = dynamic_cast<JSXClosingElement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->name);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::JSXElement: {
+                    auto child = dynamic_cast<JSXElement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->opening_element);
+
+                    for (auto& i : child->children) {
+                        TraverseNode(i);
+                    }
+                    if (child->closing_element) {
+                        TraverseNode(*child->closing_element);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::JSXEmptyExpression: {
+                    auto child = dynamic_cast<JSXEmptyExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::JSXExpressionContainer: {
+                    auto child = dynamic_cast<JSXExpressionContainer*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->expression);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::JSXIdentifier: {
+                    auto child = dynamic_cast<JSXIdentifier*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::JSXMemberExpression: {
+                    auto child = dynamic_cast<JSXMemberExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->object);
+                    TraverseNode(child->property);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::JSXAttribute: {
+                    auto child = dynamic_cast<JSXAttribute*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->name);
+                    if (child->value) {
+                        TraverseNode(*child->value);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::JSXNamespacedName: {
+                    auto child = dynamic_cast<JSXNamespacedName*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->namespace_);
+                    TraverseNode(child->name);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::JSXOpeningElement: {
+                    auto child = dynamic_cast<JSXOpeningElement*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->name);
+
+                    for (auto& i : child->attributes) {
+                        TraverseNode(i);
+                    }
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::JSXSpreadAttribute: {
+                    auto child = dynamic_cast<JSXSpreadAttribute*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->argument);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::JSXText: {
+                    auto child = dynamic_cast<JSXText*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSParameterProperty: {
+                    auto child = dynamic_cast<TSParameterProperty*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->parameter);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSDeclareFunction: {
+                    auto child = dynamic_cast<TSDeclareFunction*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->id);
+                    TraverseNode(child->return_type);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSDeclareMethod: {
+                    auto child = dynamic_cast<TSDeclareMethod*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSQualifiedName: {
+                    auto child = dynamic_cast<TSQualifiedName*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSCallSignatureDeclaration: {
+                    auto child = dynamic_cast<TSCallSignatureDeclaration*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSConstructSignatureDeclaration: {
+                    auto child = dynamic_cast<TSConstructSignatureDeclaration*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSPropertySignature: {
+                    auto child = dynamic_cast<TSPropertySignature*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSMethodSignature: {
+                    auto child = dynamic_cast<TSMethodSignature*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSIndexSignature: {
+                    auto child = dynamic_cast<TSIndexSignature*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSAnyKeyword: {
+                    auto child = dynamic_cast<TSAnyKeyword*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSBooleanKeyword: {
+                    auto child = dynamic_cast<TSBooleanKeyword*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSBigIntKeyword: {
+                    auto child = dynamic_cast<TSBigIntKeyword*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSNeverKeyword: {
+                    auto child = dynamic_cast<TSNeverKeyword*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSNullKeyword: {
+                    auto child = dynamic_cast<TSNullKeyword*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSNumberKeyword: {
+                    auto child = dynamic_cast<TSNumberKeyword*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSObjectKeyword: {
+                    auto child = dynamic_cast<TSObjectKeyword*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSStringKeyword: {
+                    auto child = dynamic_cast<TSStringKeyword*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSSymbolKeyword: {
+                    auto child = dynamic_cast<TSSymbolKeyword*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSUndefinedKeyword: {
+                    auto child = dynamic_cast<TSUndefinedKeyword*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSUnknownKeyword: {
+                    auto child = dynamic_cast<TSUnknownKeyword*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSVoidKeyword: {
+                    auto child = dynamic_cast<TSVoidKeyword*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSThisType: {
+                    auto child = dynamic_cast<TSThisType*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSFunctionType: {
+                    auto child = dynamic_cast<TSFunctionType*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSConstructorType: {
+                    auto child = dynamic_cast<TSConstructorType*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeReference: {
+                    auto child = dynamic_cast<TSTypeReference*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypePredicate: {
+                    auto child = dynamic_cast<TSTypePredicate*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeQuery: {
+                    auto child = dynamic_cast<TSTypeQuery*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeLiteral: {
+                    auto child = dynamic_cast<TSTypeLiteral*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSArrayType: {
+                    auto child = dynamic_cast<TSArrayType*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSTupleType: {
+                    auto child = dynamic_cast<TSTupleType*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSOptionalType: {
+                    auto child = dynamic_cast<TSOptionalType*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSRestType: {
+                    auto child = dynamic_cast<TSRestType*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSUnionType: {
+                    auto child = dynamic_cast<TSUnionType*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSIntersectionType: {
+                    auto child = dynamic_cast<TSIntersectionType*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSConditionalType: {
+                    auto child = dynamic_cast<TSConditionalType*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSInferType: {
+                    auto child = dynamic_cast<TSInferType*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSParenthesizedType: {
+                    auto child = dynamic_cast<TSParenthesizedType*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeOperator: {
+                    auto child = dynamic_cast<TSTypeOperator*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSIndexedAccessType: {
+                    auto child = dynamic_cast<TSIndexedAccessType*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSMappedType: {
+                    auto child = dynamic_cast<TSMappedType*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSLiteralType: {
+                    auto child = dynamic_cast<TSLiteralType*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSExpressionWithTypeArguments: {
+                    auto child = dynamic_cast<TSExpressionWithTypeArguments*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSInterfaceDeclaration: {
+                    auto child = dynamic_cast<TSInterfaceDeclaration*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSInterfaceBody: {
+                    auto child = dynamic_cast<TSInterfaceBody*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeAliasDeclaration: {
+                    auto child = dynamic_cast<TSTypeAliasDeclaration*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+                    TraverseNode(child->id);
+                    if (child->type_parameters) {
+                        TraverseNode(*child->type_parameters);
+                    }
+                    TraverseNode(child->type_annotation);
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSAsExpression: {
+                    auto child = dynamic_cast<TSAsExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeAssertion: {
+                    auto child = dynamic_cast<TSTypeAssertion*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSEnumDeclaration: {
+                    auto child = dynamic_cast<TSEnumDeclaration*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSEnumMember: {
+                    auto child = dynamic_cast<TSEnumMember*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSModuleDeclaration: {
+                    auto child = dynamic_cast<TSModuleDeclaration*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSModuleBlock: {
+                    auto child = dynamic_cast<TSModuleBlock*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSImportType: {
+                    auto child = dynamic_cast<TSImportType*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSImportEqualsDeclaration: {
+                    auto child = dynamic_cast<TSImportEqualsDeclaration*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSExternalModuleReference: {
+                    auto child = dynamic_cast<TSExternalModuleReference*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSNonNullExpression: {
+                    auto child = dynamic_cast<TSNonNullExpression*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSExportAssignment: {
+                    auto child = dynamic_cast<TSExportAssignment*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSNamespaceExportDeclaration: {
+                    auto child = dynamic_cast<TSNamespaceExportDeclaration*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeAnnotation: {
+                    auto child = dynamic_cast<TSTypeAnnotation*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeParameterInstantiation: {
+                    auto child = dynamic_cast<TSTypeParameterInstantiation*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeParameterDeclaration: {
+                    auto child = dynamic_cast<TSTypeParameterDeclaration*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeParameter: {
+                    auto child = dynamic_cast<TSTypeParameter*>(node);
+                    if (!Self().TraverseBefore(child)) return;
+
+                    Self().TraverseAfter(child);
+                    break;
+                }
+
+                default:
+                    return;
+
+            }
+        }
+
+        inline bool TraverseBefore(ArrayExpression* node) { return true; }
+        inline void TraverseAfter(ArrayExpression* node) {}
+        inline bool TraverseBefore(ArrayPattern* node) { return true; }
+        inline void TraverseAfter(ArrayPattern* node) {}
+        inline bool TraverseBefore(ArrowFunctionExpression* node) { return true; }
+        inline void TraverseAfter(ArrowFunctionExpression* node) {}
+        inline bool TraverseBefore(AssignmentExpression* node) { return true; }
+        inline void TraverseAfter(AssignmentExpression* node) {}
+        inline bool TraverseBefore(AssignmentPattern* node) { return true; }
+        inline void TraverseAfter(AssignmentPattern* node) {}
+        inline bool TraverseBefore(AwaitExpression* node) { return true; }
+        inline void TraverseAfter(AwaitExpression* node) {}
+        inline bool TraverseBefore(BinaryExpression* node) { return true; }
+        inline void TraverseAfter(BinaryExpression* node) {}
+        inline bool TraverseBefore(BlockStatement* node) { return true; }
+        inline void TraverseAfter(BlockStatement* node) {}
+        inline bool TraverseBefore(BreakStatement* node) { return true; }
+        inline void TraverseAfter(BreakStatement* node) {}
+        inline bool TraverseBefore(CallExpression* node) { return true; }
+        inline void TraverseAfter(CallExpression* node) {}
+        inline bool TraverseBefore(CatchClause* node) { return true; }
+        inline void TraverseAfter(CatchClause* node) {}
+        inline bool TraverseBefore(ClassBody* node) { return true; }
+        inline void TraverseAfter(ClassBody* node) {}
+        inline bool TraverseBefore(ClassDeclaration* node) { return true; }
+        inline void TraverseAfter(ClassDeclaration* node) {}
+        inline bool TraverseBefore(ClassExpression* node) { return true; }
+        inline void TraverseAfter(ClassExpression* node) {}
+        inline bool TraverseBefore(ConditionalExpression* node) { return true; }
+        inline void TraverseAfter(ConditionalExpression* node) {}
+        inline bool TraverseBefore(ContinueStatement* node) { return true; }
+        inline void TraverseAfter(ContinueStatement* node) {}
+        inline bool TraverseBefore(DebuggerStatement* node) { return true; }
+        inline void TraverseAfter(DebuggerStatement* node) {}
+        inline bool TraverseBefore(Directive* node) { return true; }
+        inline void TraverseAfter(Directive* node) {}
+        inline bool TraverseBefore(DoWhileStatement* node) { return true; }
+        inline void TraverseAfter(DoWhileStatement* node) {}
+        inline bool TraverseBefore(EmptyStatement* node) { return true; }
+        inline void TraverseAfter(EmptyStatement* node) {}
+        inline bool TraverseBefore(ExportAllDeclaration* node) { return true; }
+        inline void TraverseAfter(ExportAllDeclaration* node) {}
+        inline bool TraverseBefore(ExportDefaultDeclaration* node) { return true; }
+        inline void TraverseAfter(ExportDefaultDeclaration* node) {}
+        inline bool TraverseBefore(ExportNamedDeclaration* node) { return true; }
+        inline void TraverseAfter(ExportNamedDeclaration* node) {}
+        inline bool TraverseBefore(ExportSpecifier* node) { return true; }
+        inline void TraverseAfter(ExportSpecifier* node) {}
+        inline bool TraverseBefore(ExpressionStatement* node) { return true; }
+        inline void TraverseAfter(ExpressionStatement* node) {}
+        inline bool TraverseBefore(ForInStatement* node) { return true; }
+        inline void TraverseAfter(ForInStatement* node) {}
+        inline bool TraverseBefore(ForOfStatement* node) { return true; }
+        inline void TraverseAfter(ForOfStatement* node) {}
+        inline bool TraverseBefore(ForStatement* node) { return true; }
+        inline void TraverseAfter(ForStatement* node) {}
+        inline bool TraverseBefore(FunctionDeclaration* node) { return true; }
+        inline void TraverseAfter(FunctionDeclaration* node) {}
+        inline bool TraverseBefore(FunctionExpression* node) { return true; }
+        inline void TraverseAfter(FunctionExpression* node) {}
+        inline bool TraverseBefore(Identifier* node) { return true; }
+        inline void TraverseAfter(Identifier* node) {}
+        inline bool TraverseBefore(IfStatement* node) { return true; }
+        inline void TraverseAfter(IfStatement* node) {}
+        inline bool TraverseBefore(Import* node) { return true; }
+        inline void TraverseAfter(Import* node) {}
+        inline bool TraverseBefore(ImportDeclaration* node) { return true; }
+        inline void TraverseAfter(ImportDeclaration* node) {}
+        inline bool TraverseBefore(ImportDefaultSpecifier* node) { return true; }
+        inline void TraverseAfter(ImportDefaultSpecifier* node) {}
+        inline bool TraverseBefore(ImportNamespaceSpecifier* node) { return true; }
+        inline void TraverseAfter(ImportNamespaceSpecifier* node) {}
+        inline bool TraverseBefore(ImportSpecifier* node) { return true; }
+        inline void TraverseAfter(ImportSpecifier* node) {}
+        inline bool TraverseBefore(LabeledStatement* node) { return true; }
+        inline void TraverseAfter(LabeledStatement* node) {}
+        inline bool TraverseBefore(Literal* node) { return true; }
+        inline void TraverseAfter(Literal* node) {}
+        inline bool TraverseBefore(MetaProperty* node) { return true; }
+        inline void TraverseAfter(MetaProperty* node) {}
+        inline bool TraverseBefore(MethodDefinition* node) { return true; }
+        inline void TraverseAfter(MethodDefinition* node) {}
+        inline bool TraverseBefore(Module* node) { return true; }
+        inline void TraverseAfter(Module* node) {}
+        inline bool TraverseBefore(NewExpression* node) { return true; }
+        inline void TraverseAfter(NewExpression* node) {}
+        inline bool TraverseBefore(ObjectExpression* node) { return true; }
+        inline void TraverseAfter(ObjectExpression* node) {}
+        inline bool TraverseBefore(ObjectPattern* node) { return true; }
+        inline void TraverseAfter(ObjectPattern* node) {}
+        inline bool TraverseBefore(Property* node) { return true; }
+        inline void TraverseAfter(Property* node) {}
+        inline bool TraverseBefore(RegexLiteral* node) { return true; }
+        inline void TraverseAfter(RegexLiteral* node) {}
+        inline bool TraverseBefore(RestElement* node) { return true; }
+        inline void TraverseAfter(RestElement* node) {}
+        inline bool TraverseBefore(ReturnStatement* node) { return true; }
+        inline void TraverseAfter(ReturnStatement* node) {}
+        inline bool TraverseBefore(Script* node) { return true; }
+        inline void TraverseAfter(Script* node) {}
+        inline bool TraverseBefore(SequenceExpression* node) { return true; }
+        inline void TraverseAfter(SequenceExpression* node) {}
+        inline bool TraverseBefore(SpreadElement* node) { return true; }
+        inline void TraverseAfter(SpreadElement* node) {}
+        inline bool TraverseBefore(MemberExpression* node) { return true; }
+        inline void TraverseAfter(MemberExpression* node) {}
+        inline bool TraverseBefore(Super* node) { return true; }
+        inline void TraverseAfter(Super* node) {}
+        inline bool TraverseBefore(SwitchCase* node) { return true; }
+        inline void TraverseAfter(SwitchCase* node) {}
+        inline bool TraverseBefore(SwitchStatement* node) { return true; }
+        inline void TraverseAfter(SwitchStatement* node) {}
+        inline bool TraverseBefore(TaggedTemplateExpression* node) { return true; }
+        inline void TraverseAfter(TaggedTemplateExpression* node) {}
+        inline bool TraverseBefore(TemplateElement* node) { return true; }
+        inline void TraverseAfter(TemplateElement* node) {}
+        inline bool TraverseBefore(TemplateLiteral* node) { return true; }
+        inline void TraverseAfter(TemplateLiteral* node) {}
+        inline bool TraverseBefore(ThisExpression* node) { return true; }
+        inline void TraverseAfter(ThisExpression* node) {}
+        inline bool TraverseBefore(ThrowStatement* node) { return true; }
+        inline void TraverseAfter(ThrowStatement* node) {}
+        inline bool TraverseBefore(TryStatement* node) { return true; }
+        inline void TraverseAfter(TryStatement* node) {}
+        inline bool TraverseBefore(UnaryExpression* node) { return true; }
+        inline void TraverseAfter(UnaryExpression* node) {}
+        inline bool TraverseBefore(UpdateExpression* node) { return true; }
+        inline void TraverseAfter(UpdateExpression* node) {}
+        inline bool TraverseBefore(VariableDeclaration* node) { return true; }
+        inline void TraverseAfter(VariableDeclaration* node) {}
+        inline bool TraverseBefore(VariableDeclarator* node) { return true; }
+        inline void TraverseAfter(VariableDeclarator* node) {}
+        inline bool TraverseBefore(WhileStatement* node) { return true; }
+        inline void TraverseAfter(WhileStatement* node) {}
+        inline bool TraverseBefore(WithStatement* node) { return true; }
+        inline void TraverseAfter(WithStatement* node) {}
+        inline bool TraverseBefore(YieldExpression* node) { return true; }
+        inline void TraverseAfter(YieldExpression* node) {}
+        inline bool TraverseBefore(ArrowParameterPlaceHolder* node) { return true; }
+        inline void TraverseAfter(ArrowParameterPlaceHolder* node) {}
+        inline bool TraverseBefore(JSXClosingElement* node) { return true; }
+        inline void TraverseAfter(JSXClosingElement* node) {}
+        inline bool TraverseBefore(JSXElement* node) { return true; }
+        inline void TraverseAfter(JSXElement* node) {}
+        inline bool TraverseBefore(JSXEmptyExpression* node) { return true; }
+        inline void TraverseAfter(JSXEmptyExpression* node) {}
+        inline bool TraverseBefore(JSXExpressionContainer* node) { return true; }
+        inline void TraverseAfter(JSXExpressionContainer* node) {}
+        inline bool TraverseBefore(JSXIdentifier* node) { return true; }
+        inline void TraverseAfter(JSXIdentifier* node) {}
+        inline bool TraverseBefore(JSXMemberExpression* node) { return true; }
+        inline void TraverseAfter(JSXMemberExpression* node) {}
+        inline bool TraverseBefore(JSXAttribute* node) { return true; }
+        inline void TraverseAfter(JSXAttribute* node) {}
+        inline bool TraverseBefore(JSXNamespacedName* node) { return true; }
+        inline void TraverseAfter(JSXNamespacedName* node) {}
+        inline bool TraverseBefore(JSXOpeningElement* node) { return true; }
+        inline void TraverseAfter(JSXOpeningElement* node) {}
+        inline bool TraverseBefore(JSXSpreadAttribute* node) { return true; }
+        inline void TraverseAfter(JSXSpreadAttribute* node) {}
+        inline bool TraverseBefore(JSXText* node) { return true; }
+        inline void TraverseAfter(JSXText* node) {}
+        inline bool TraverseBefore(TSParameterProperty* node) { return true; }
+        inline void TraverseAfter(TSParameterProperty* node) {}
+        inline bool TraverseBefore(TSDeclareFunction* node) { return true; }
+        inline void TraverseAfter(TSDeclareFunction* node) {}
+        inline bool TraverseBefore(TSDeclareMethod* node) { return true; }
+        inline void TraverseAfter(TSDeclareMethod* node) {}
+        inline bool TraverseBefore(TSQualifiedName* node) { return true; }
+        inline void TraverseAfter(TSQualifiedName* node) {}
+        inline bool TraverseBefore(TSCallSignatureDeclaration* node) { return true; }
+        inline void TraverseAfter(TSCallSignatureDeclaration* node) {}
+        inline bool TraverseBefore(TSConstructSignatureDeclaration* node) { return true; }
+        inline void TraverseAfter(TSConstructSignatureDeclaration* node) {}
+        inline bool TraverseBefore(TSPropertySignature* node) { return true; }
+        inline void TraverseAfter(TSPropertySignature* node) {}
+        inline bool TraverseBefore(TSMethodSignature* node) { return true; }
+        inline void TraverseAfter(TSMethodSignature* node) {}
+        inline bool TraverseBefore(TSIndexSignature* node) { return true; }
+        inline void TraverseAfter(TSIndexSignature* node) {}
+        inline bool TraverseBefore(TSAnyKeyword* node) { return true; }
+        inline void TraverseAfter(TSAnyKeyword* node) {}
+        inline bool TraverseBefore(TSBooleanKeyword* node) { return true; }
+        inline void TraverseAfter(TSBooleanKeyword* node) {}
+        inline bool TraverseBefore(TSBigIntKeyword* node) { return true; }
+        inline void TraverseAfter(TSBigIntKeyword* node) {}
+        inline bool TraverseBefore(TSNeverKeyword* node) { return true; }
+        inline void TraverseAfter(TSNeverKeyword* node) {}
+        inline bool TraverseBefore(TSNullKeyword* node) { return true; }
+        inline void TraverseAfter(TSNullKeyword* node) {}
+        inline bool TraverseBefore(TSNumberKeyword* node) { return true; }
+        inline void TraverseAfter(TSNumberKeyword* node) {}
+        inline bool TraverseBefore(TSObjectKeyword* node) { return true; }
+        inline void TraverseAfter(TSObjectKeyword* node) {}
+        inline bool TraverseBefore(TSStringKeyword* node) { return true; }
+        inline void TraverseAfter(TSStringKeyword* node) {}
+        inline bool TraverseBefore(TSSymbolKeyword* node) { return true; }
+        inline void TraverseAfter(TSSymbolKeyword* node) {}
+        inline bool TraverseBefore(TSUndefinedKeyword* node) { return true; }
+        inline void TraverseAfter(TSUndefinedKeyword* node) {}
+        inline bool TraverseBefore(TSUnknownKeyword* node) { return true; }
+        inline void TraverseAfter(TSUnknownKeyword* node) {}
+        inline bool TraverseBefore(TSVoidKeyword* node) { return true; }
+        inline void TraverseAfter(TSVoidKeyword* node) {}
+        inline bool TraverseBefore(TSThisType* node) { return true; }
+        inline void TraverseAfter(TSThisType* node) {}
+        inline bool TraverseBefore(TSFunctionType* node) { return true; }
+        inline void TraverseAfter(TSFunctionType* node) {}
+        inline bool TraverseBefore(TSConstructorType* node) { return true; }
+        inline void TraverseAfter(TSConstructorType* node) {}
+        inline bool TraverseBefore(TSTypeReference* node) { return true; }
+        inline void TraverseAfter(TSTypeReference* node) {}
+        inline bool TraverseBefore(TSTypePredicate* node) { return true; }
+        inline void TraverseAfter(TSTypePredicate* node) {}
+        inline bool TraverseBefore(TSTypeQuery* node) { return true; }
+        inline void TraverseAfter(TSTypeQuery* node) {}
+        inline bool TraverseBefore(TSTypeLiteral* node) { return true; }
+        inline void TraverseAfter(TSTypeLiteral* node) {}
+        inline bool TraverseBefore(TSArrayType* node) { return true; }
+        inline void TraverseAfter(TSArrayType* node) {}
+        inline bool TraverseBefore(TSTupleType* node) { return true; }
+        inline void TraverseAfter(TSTupleType* node) {}
+        inline bool TraverseBefore(TSOptionalType* node) { return true; }
+        inline void TraverseAfter(TSOptionalType* node) {}
+        inline bool TraverseBefore(TSRestType* node) { return true; }
+        inline void TraverseAfter(TSRestType* node) {}
+        inline bool TraverseBefore(TSUnionType* node) { return true; }
+        inline void TraverseAfter(TSUnionType* node) {}
+        inline bool TraverseBefore(TSIntersectionType* node) { return true; }
+        inline void TraverseAfter(TSIntersectionType* node) {}
+        inline bool TraverseBefore(TSConditionalType* node) { return true; }
+        inline void TraverseAfter(TSConditionalType* node) {}
+        inline bool TraverseBefore(TSInferType* node) { return true; }
+        inline void TraverseAfter(TSInferType* node) {}
+        inline bool TraverseBefore(TSParenthesizedType* node) { return true; }
+        inline void TraverseAfter(TSParenthesizedType* node) {}
+        inline bool TraverseBefore(TSTypeOperator* node) { return true; }
+        inline void TraverseAfter(TSTypeOperator* node) {}
+        inline bool TraverseBefore(TSIndexedAccessType* node) { return true; }
+        inline void TraverseAfter(TSIndexedAccessType* node) {}
+        inline bool TraverseBefore(TSMappedType* node) { return true; }
+        inline void TraverseAfter(TSMappedType* node) {}
+        inline bool TraverseBefore(TSLiteralType* node) { return true; }
+        inline void TraverseAfter(TSLiteralType* node) {}
+        inline bool TraverseBefore(TSExpressionWithTypeArguments* node) { return true; }
+        inline void TraverseAfter(TSExpressionWithTypeArguments* node) {}
+        inline bool TraverseBefore(TSInterfaceDeclaration* node) { return true; }
+        inline void TraverseAfter(TSInterfaceDeclaration* node) {}
+        inline bool TraverseBefore(TSInterfaceBody* node) { return true; }
+        inline void TraverseAfter(TSInterfaceBody* node) {}
+        inline bool TraverseBefore(TSTypeAliasDeclaration* node) { return true; }
+        inline void TraverseAfter(TSTypeAliasDeclaration* node) {}
+        inline bool TraverseBefore(TSAsExpression* node) { return true; }
+        inline void TraverseAfter(TSAsExpression* node) {}
+        inline bool TraverseBefore(TSTypeAssertion* node) { return true; }
+        inline void TraverseAfter(TSTypeAssertion* node) {}
+        inline bool TraverseBefore(TSEnumDeclaration* node) { return true; }
+        inline void TraverseAfter(TSEnumDeclaration* node) {}
+        inline bool TraverseBefore(TSEnumMember* node) { return true; }
+        inline void TraverseAfter(TSEnumMember* node) {}
+        inline bool TraverseBefore(TSModuleDeclaration* node) { return true; }
+        inline void TraverseAfter(TSModuleDeclaration* node) {}
+        inline bool TraverseBefore(TSModuleBlock* node) { return true; }
+        inline void TraverseAfter(TSModuleBlock* node) {}
+        inline bool TraverseBefore(TSImportType* node) { return true; }
+        inline void TraverseAfter(TSImportType* node) {}
+        inline bool TraverseBefore(TSImportEqualsDeclaration* node) { return true; }
+        inline void TraverseAfter(TSImportEqualsDeclaration* node) {}
+        inline bool TraverseBefore(TSExternalModuleReference* node) { return true; }
+        inline void TraverseAfter(TSExternalModuleReference* node) {}
+        inline bool TraverseBefore(TSNonNullExpression* node) { return true; }
+        inline void TraverseAfter(TSNonNullExpression* node) {}
+        inline bool TraverseBefore(TSExportAssignment* node) { return true; }
+        inline void TraverseAfter(TSExportAssignment* node) {}
+        inline bool TraverseBefore(TSNamespaceExportDeclaration* node) { return true; }
+        inline void TraverseAfter(TSNamespaceExportDeclaration* node) {}
+        inline bool TraverseBefore(TSTypeAnnotation* node) { return true; }
+        inline void TraverseAfter(TSTypeAnnotation* node) {}
+        inline bool TraverseBefore(TSTypeParameterInstantiation* node) { return true; }
+        inline void TraverseAfter(TSTypeParameterInstantiation* node) {}
+        inline bool TraverseBefore(TSTypeParameterDeclaration* node) { return true; }
+        inline void TraverseAfter(TSTypeParameterDeclaration* node) {}
+        inline bool TraverseBefore(TSTypeParameter* node) { return true; }
+        inline void TraverseAfter(TSTypeParameter* node) {}
+
+    private:
+        inline Derived& Self() {
+            return *static_cast<Derived*>(this);
+        }
+
+    };
+
+}
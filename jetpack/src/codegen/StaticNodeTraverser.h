@@ -0,0 +1,892 @@
+//
+// Created by Duzhong Chen on 2021/12/2.
+//
+
+#pragma once
+#include "parser/SyntaxNodes.h"
+
+namespace jetpack {
+
+    /**
+     * The static version of NodeTraverser.
+     * The hooks of `Derived` are called directly, they can be inlined.
+     *
+     * `Derived` should declare `using StaticNodeTraverser<Derived>::Traverse;`
+     * if it doesn't define the hooks of all the node types.
+     */
+    template <typename Derived>
+    class StaticNodeTraverser {
+    public:
+
+        StaticNodeTraverser() = default;
+
+        void TraverseNode(SyntaxNode& node) {
+            switch (node.type) {
+
+                case SyntaxNodeType::ArrayExpression: {
+                    Self().Traverse(*dynamic_cast<ArrayExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ArrayPattern: {
+                    Self().Traverse(*dynamic_cast<ArrayPattern*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ArrowFunctionExpression: {
+                    Self().Traverse(*dynamic_cast<ArrowFunctionExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::AssignmentExpression: {
+                    Self().Traverse(*dynamic_cast<AssignmentExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::AssignmentPattern: {
+                    Self().Traverse(*dynamic_cast<AssignmentPattern*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::AwaitExpression: {
+                    Self().Traverse(*dynamic_cast<AwaitExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::BinaryExpression: {
+                    Self().Traverse(*dynamic_cast<BinaryExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::BlockStatement: {
+                    Self().Traverse(*dynamic_cast<BlockStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::BreakStatement: {
+                    Self().Traverse(*dynamic_cast<BreakStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::CallExpression: {
+                    Self().Traverse(*dynamic_cast<CallExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::CatchClause: {
+                    Self().Traverse(*dynamic_cast<CatchClause*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ClassBody: {
+                    Self().Traverse(*dynamic_cast<ClassBody*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ClassDeclaration: {
+                    Self().Traverse(*dynamic_cast<ClassDeclaration*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ClassExpression: {
+                    Self().Traverse(*dynamic_cast<ClassExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ConditionalExpression: {
+                    Self().Traverse(*dynamic_cast<ConditionalExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ContinueStatement: {
+                    Self().Traverse(*dynamic_cast<ContinueStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::DebuggerStatement: {
+                    Self().Traverse(*dynamic_cast<DebuggerStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::Directive: {
+                    Self().Traverse(*dynamic_cast<Directive*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::DoWhileStatement: {
+                    Self().Traverse(*dynamic_cast<DoWhileStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::EmptyStatement: {
+                    Self().Traverse(*dynamic_cast<EmptyStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ExportAllDeclaration: {
+                    Self().Traverse(*dynamic_cast<ExportAllDeclaration*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ExportDefaultDeclaration: {
+                    Self().Traverse(*dynamic_cast<ExportDefaultDeclaration*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ExportNamedDeclaration: {
+                    Self().Traverse(*dynamic_cast<ExportNamedDeclaration*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ExportSpecifier: {
+                    Self().Traverse(*dynamic_cast<ExportSpecifier*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ExpressionStatement: {
+                    Self().Traverse(*dynamic_cast<ExpressionStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ForInStatement: {
+                    Self().Traverse(*dynamic_cast<ForInStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ForOfStatement: {
+                    Self().Traverse(*dynamic_cast<ForOfStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ForStatement: {
+                    Self().Traverse(*dynamic_cast<ForStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::FunctionDeclaration: {
+                    Self().Traverse(*dynamic_cast<FunctionDeclaration*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::FunctionExpression: {
+                    Self().Traverse(*dynamic_cast<FunctionExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::Identifier: {
+                    Self().Traverse(*dynamic_cast<Identifier*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::IfStatement: {
+                    Self().Traverse(*dynamic_cast<IfStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::Import: {
+                    Self().Traverse(*dynamic_cast<Import*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ImportDeclaration: {
+                    Self().Traverse(*dynamic_cast<ImportDeclaration*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ImportDefaultSpecifier: {
+                    Self().Traverse(*dynamic_cast<ImportDefaultSpecifier*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ImportNamespaceSpecifier: {
+                    Self().Traverse(*dynamic_cast<ImportNamespaceSpecifier*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ImportSpecifier: {
+                    Self().Traverse(*dynamic_cast<ImportSpecifier*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::LabeledStatement: {
+                    Self().Traverse(*dynamic_cast<LabeledStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::Literal: {
+                    Self().Traverse(*dynamic_cast<Literal*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::MetaProperty: {
+                    Self().Traverse(*dynamic_cast<MetaProperty*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::MethodDefinition: {
+                    Self().Traverse(*dynamic_cast<MethodDefinition*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::Module: {
+                    Self().Traverse(*dynamic_cast<Module*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::NewExpression: {
+                    Self().Traverse(*dynamic_cast<NewExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ObjectExpression: {
+                    Self().Traverse(*dynamic_cast<ObjectExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ObjectPattern: {
+                    Self().Traverse(*dynamic_cast<ObjectPattern*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::Property: {
+                    Self().Traverse(*dynamic_cast<Property*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::RegexLiteral: {
+                    Self().Traverse(*dynamic_cast<RegexLiteral*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::RestElement: {
+                    Self().Traverse(*dynamic_cast<RestElement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ReturnStatement: {
+                    Self().Traverse(*dynamic_cast<ReturnStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::Script: {
+                    Self().Traverse(*dynamic_cast<Script*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::SequenceExpression: {
+                    Self().Traverse(*dynamic_cast<SequenceExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::SpreadElement: {
+                    Self().Traverse(*dynamic_cast<SpreadElement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::MemberExpression: {
+                    Self().Traverse(*dynamic_cast<MemberExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::Super: {
+                    Self().Traverse(*dynamic_cast<Super*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::SwitchCase: {
+                    Self().Traverse(*dynamic_cast<SwitchCase*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::SwitchStatement: {
+                    Self().Traverse(*dynamic_cast<SwitchStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TaggedTemplateExpression: {
+                    Self().Traverse(*dynamic_cast<TaggedTemplateExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TemplateElement: {
+                    Self().Traverse(*dynamic_cast<TemplateElement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TemplateLiteral: {
+                    Self().Traverse(*dynamic_cast<TemplateLiteral*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ThisExpression: {
+                    Self().Traverse(*dynamic_cast<ThisExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ThrowStatement: {
+                    Self().Traverse(*dynamic_cast<ThrowStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TryStatement: {
+                    Self().Traverse(*dynamic_cast<TryStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::UnaryExpression: {
+                    Self().Traverse(*dynamic_cast<UnaryExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::UpdateExpression: {
+                    Self().Traverse(*dynamic_cast<UpdateExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::VariableDeclaration: {
+                    Self().Traverse(*dynamic_cast<VariableDeclaration*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::VariableDeclarator: {
+                    Self().Traverse(*dynamic_cast<VariableDeclarator*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::WhileStatement: {
+                    Self().Traverse(*dynamic_cast<WhileStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::WithStatement: {
+                    Self().Traverse(*dynamic_cast<WithStatement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::YieldExpression: {
+                    Self().Traverse(*dynamic_cast<YieldExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::ArrowParameterPlaceHolder: {
+                    Self().Traverse(*dynamic_cast<ArrowParameterPlaceHolder*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::JSXClosingElement: {
+                    Self().Traverse(*dynamic_cast<JSXClosingElement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::JSXElement: {
+                    Self().Traverse(*dynamic_cast<JSXElement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::JSXEmptyExpression: {
+                    Self().Traverse(*dynamic_cast<JSXEmptyExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::JSXExpressionContainer: {
+                    Self().Traverse(*dynamic_cast<JSXExpressionContainer*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::JSXIdentifier: {
+                    Self().Traverse(*dynamic_cast<JSXIdentifier*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::JSXMemberExpression: {
+                    Self().Traverse(*dynamic_cast<JSXMemberExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::JSXAttribute: {
+                    Self().Traverse(*dynamic_cast<JSXAttribute*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::JSXNamespacedName: {
+                    Self().Traverse(*dynamic_cast<JSXNamespacedName*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::JSXOpeningElement: {
+                    Self().Traverse(*dynamic_cast<JSXOpeningElement*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::JSXSpreadAttribute: {
+                    Self().Traverse(*dynamic_cast<JSXSpreadAttribute*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::JSXText: {
+                    Self().Traverse(*dynamic_cast<JSXText*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSParameterProperty: {
+                    Self().Traverse(*dynamic_cast<TSParameterProperty*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSDeclareFunction: {
+                    Self().Traverse(*dynamic_cast<TSDeclareFunction*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSDeclareMethod: {
+                    Self().Traverse(*dynamic_cast<TSDeclareMethod*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSQualifiedName: {
+                    Self().Traverse(*dynamic_cast<TSQualifiedName*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSCallSignatureDeclaration: {
+                    Self().Traverse(*dynamic_cast<TSCallSignatureDeclaration*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSConstructSignatureDeclaration: {
+                    Self().Traverse(*dynamic_cast<TSConstructSignatureDeclaration*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSPropertySignature: {
+                    Self().Traverse(*dynamic_cast<TSPropertySignature*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSMethodSignature: {
+                    Self().Traverse(*dynamic_cast<TSMethodSignature*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSIndexSignature: {
+                    Self().Traverse(*dynamic_cast<TSIndexSignature*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSAnyKeyword: {
+                    Self().Traverse(*dynamic_cast<TSAnyKeyword*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSBooleanKeyword: {
+                    Self().Traverse(*dynamic_cast<TSBooleanKeyword*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSBigIntKeyword: {
+                    Self().Traverse(*dynamic_cast<TSBigIntKeyword*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSNeverKeyword: {
+                    Self().Traverse(*dynamic_cast<TSNeverKeyword*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSNullKeyword: {
+                    Self().Traverse(*dynamic_cast<TSNullKeyword*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSNumberKeyword: {
+                    Self().Traverse(*dynamic_cast<TSNumberKeyword*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSObjectKeyword: {
+                    Self().Traverse(*dynamic_cast<TSObjectKeyword*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSStringKeyword: {
+                    Self().Traverse(*dynamic_cast<TSStringKeyword*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSSymbolKeyword: {
+                    Self().Traverse(*dynamic_cast<TSSymbolKeyword*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSUndefinedKeyword: {
+                    Self().Traverse(*dynamic_cast<TSUndefinedKeyword*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSUnknownKeyword: {
+                    Self().Traverse(*dynamic_cast<TSUnknownKeyword*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSVoidKeyword: {
+                    Self().Traverse(*dynamic_cast<TSVoidKeyword*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSThisType: {
+                    Self().Traverse(*dynamic_cast<TSThisType*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSFunctionType: {
+                    Self().Traverse(*dynamic_cast<TSFunctionType*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSConstructorType: {
+                    Self().Traverse(*dynamic_cast<TSConstructorType*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeReference: {
+                    Self().Traverse(*dynamic_cast<TSTypeReference*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypePredicate: {
+                    Self().Traverse(*dynamic_cast<TSTypePredicate*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeQuery: {
+                    Self().Traverse(*dynamic_cast<TSTypeQuery*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeLiteral: {
+                    Self().Traverse(*dynamic_cast<TSTypeLiteral*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSArrayType: {
+                    Self().Traverse(*dynamic_cast<TSArrayType*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSTupleType: {
+                    Self().Traverse(*dynamic_cast<TSTupleType*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSOptionalType: {
+                    Self().Traverse(*dynamic_cast<TSOptionalType*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSRestType: {
+                    Self().Traverse(*dynamic_cast<TSRestType*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSUnionType: {
+                    Self().Traverse(*dynamic_cast<TSUnionType*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSIntersectionType: {
+                    Self().Traverse(*dynamic_cast<TSIntersectionType*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSConditionalType: {
+                    Self().Traverse(*dynamic_cast<TSConditionalType*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSInferType: {
+                    Self().Traverse(*dynamic_cast<TSInferType*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSParenthesizedType: {
+                    Self().Traverse(*dynamic_cast<TSParenthesizedType*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeOperator: {
+                    Self().Traverse(*dynamic_cast<TSTypeOperator*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSIndexedAccessType: {
+                    Self().Traverse(*dynamic_cast<TSIndexedAccessType*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSMappedType: {
+                    Self().Traverse(*dynamic_cast<TSMappedType*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSLiteralType: {
+                    Self().Traverse(*dynamic_cast<TSLiteralType*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSExpressionWithTypeArguments: {
+                    Self().Traverse(*dynamic_cast<TSExpressionWithTypeArguments*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSInterfaceDeclaration: {
+                    Self().Traverse(*dynamic_cast<TSInterfaceDeclaration*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSInterfaceBody: {
+                    Self().Traverse(*dynamic_cast<TSInterfaceBody*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeAliasDeclaration: {
+                    Self().Traverse(*dynamic_cast<TSTypeAliasDeclaration*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSAsExpression: {
+                    Self().Traverse(*dynamic_cast<TSAsExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeAssertion: {
+                    Self().Traverse(*dynamic_cast<TSTypeAssertion*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSEnumDeclaration: {
+                    Self().Traverse(*dynamic_cast<TSEnumDeclaration*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSEnumMember: {
+                    Self().Traverse(*dynamic_cast<TSEnumMember*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSModuleDeclaration: {
+                    Self().Traverse(*dynamic_cast<TSModuleDeclaration*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSModuleBlock: {
+                    Self().Traverse(*dynamic_cast<TSModuleBlock*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSImportType: {
+                    Self().Traverse(*dynamic_cast<TSImportType*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSImportEqualsDeclaration: {
+                    Self().Traverse(*dynamic_cast<TSImportEqualsDeclaration*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSExternalModuleReference: {
+                    Self().Traverse(*dynamic_cast<TSExternalModuleReference*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSNonNullExpression: {
+                    Self().Traverse(*dynamic_cast<TSNonNullExpression*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSExportAssignment: {
+                    Self().Traverse(*dynamic_cast<TSExportAssignment*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSNamespaceExportDeclaration: {
+                    Self().Traverse(*dynamic_cast<TSNamespaceExportDeclaration*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeAnnotation: {
+                    Self().Traverse(*dynamic_cast<TSTypeAnnotation*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeParameterInstantiation: {
+                    Self().Traverse(*dynamic_cast<TSTypeParameterInstantiation*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeParameterDeclaration: {
+                    Self().Traverse(*dynamic_cast<TSTypeParameterDeclaration*>(&node));
+                    break;
+                }
+
+                case SyntaxNodeType::TSTypeParameter: {
+                    Self().Traverse(*dynamic_cast<TSTypeParameter*>(&node));
+                    break;
+                }
+
+                default:
+                    return;
+
+            }
+        }
+
+        inline void Traverse(ArrayExpression& node) {}
+        inline void Traverse(ArrayPattern& node) {}
+        inline void Traverse(ArrowFunctionExpression& node) {}
+        inline void Traverse(AssignmentExpression& node) {}
+        inline void Traverse(AssignmentPattern& node) {}
+        inline void Traverse(AwaitExpression& node) {}
+        inline void Traverse(BinaryExpression& node) {}
+        inline void Traverse(BlockStatement& node) {}
+        inline void Traverse(BreakStatement& node) {}
+        inline void Traverse(CallExpression& node) {}
+        inline void Traverse(CatchClause& node) {}
+        inline void Traverse(ClassBody& node) {}
+        inline void Traverse(ClassDeclaration& node) {}
+        inline void Traverse(ClassExpression& node) {}
+        inline void Traverse(ConditionalExpression& node) {}
+        inline void Traverse(ContinueStatement& node) {}
+        inline void Traverse(DebuggerStatement& node) {}
+        inline void Traverse(Directive& node) {}
+        inline void Traverse(DoWhileStatement& node) {}
+        inline void Traverse(EmptyStatement& node) {}
+        inline void Traverse(ExportAllDeclaration& node) {}
+        inline void Traverse(ExportDefaultDeclaration& node) {}
+        inline void Traverse(ExportNamedDeclaration& node) {}
+        inline void Traverse(ExportSpecifier& node) {}
+        inline void Traverse(ExpressionStatement& node) {}
+        inline void Traverse(ForInStatement& node) {}
+        inline void Traverse(ForOfStatement& node) {}
+        inline void Traverse(ForStatement& node) {}
+        inline void Traverse(FunctionDeclaration& node) {}
+        inline void Traverse(FunctionExpression& node) {}
+        inline void Traverse(Identifier& node) {}
+        inline void Traverse(IfStatement& node) {}
+        inline void Traverse(Import& node) {}
+        inline void Traverse(ImportDeclaration& node) {}
+        inline void Traverse(ImportDefaultSpecifier& node) {}
+        inline void Traverse(ImportNamespaceSpecifier& node) {}
+        inline void Traverse(ImportSpecifier& node) {}
+        inline void Traverse(LabeledStatement& node) {}
+        inline void Traverse(Literal& node) {}
+        inline void Traverse(MetaProperty& node) {}
+        inline void Traverse(MethodDefinition& node) {}
+        inline void Traverse(Module& node) {}
+        inline void Traverse(NewExpression& node) {}
+        inline void Traverse(ObjectExpression& node) {}
+        inline void Traverse(ObjectPattern& node) {}
+        inline void Traverse(Property& node) {}
+        inline void Traverse(RegexLiteral& node) {}
+        inline void Traverse(RestElement& node) {}
+        inline void Traverse(ReturnStatement& node) {}
+        inline void Traverse(Script& node) {}
+        inline void Traverse(SequenceExpression& node) {}
+        inline void Traverse(SpreadElement& node) {}
+        inline void Traverse(MemberExpression& node) {}
+        inline void Traverse(Super& node) {}
+        inline void Traverse(SwitchCase& node) {}
+        inline void Traverse(SwitchStatement& node) {}
+        inline void Traverse(TaggedTemplateExpression& node) {}
+        inline void Traverse(TemplateElement& node) {}
+        inline void Traverse(TemplateLiteral& node) {}
+        inline void Traverse(ThisExpression& node) {}
+        inline void Traverse(ThrowStatement& node) {}
+        inline void Traverse(TryStatement& node) {}
+        inline void Traverse(UnaryExpression& node) {}
+        inline void Traverse(UpdateExpression& node) {}
+        inline void Traverse(VariableDeclaration& node) {}
+        inline void Traverse(VariableDeclarator& node) {}
+        inline void Traverse(WhileStatement& node) {}
+        inline void Traverse(WithStatement& node) {}
+        inline void Traverse(YieldExpression& node) {}
+        inline void Traverse(ArrowParameterPlaceHolder& node) {}
+        inline void Traverse(JSXClosingElement& node) {}
+        inline void Traverse(JSXElement& node) {}
+        inline void Traverse(JSXEmptyExpression& node) {}
+        inline void Traverse(JSXExpressionContainer& node) {}
+        inline void Traverse(JSXIdentifier& node) {}
+        inline void Traverse(JSXMemberExpression& node) {}
+        inline void Traverse(JSXAttribute& node) {}
+        inline void Traverse(JSXNamespacedName& node) {}
+        inline void Traverse(JSXOpeningElement& node) {}
+        inline void Traverse(JSXSpreadAttribute& node) {}
+        inline void Traverse(JSXText& node) {}
+        inline void Traverse(TSParameterProperty& node) {}
+        inline void Traverse(TSDeclareFunction& node) {}
+        inline void Traverse(TSDeclareMethod& node) {}
+        inline void Traverse(TSQualifiedName& node) {}
+        inline void Traverse(TSCallSignatureDeclaration& node) {}
+        inline void Traverse(TSConstructSignatureDeclaration& node) {}
+        inline void Traverse(TSPropertySignature& node) {}
+        inline void Traverse(TSMethodSignature& node) {}
+        inline void Traverse(TSIndexSignature& node) {}
+        inline void Traverse(TSAnyKeyword& node) {}
+        inline void Traverse(TSBooleanKeyword& node) {}
+        inline void Traverse(TSBigIntKeyword& node) {}
+        inline void Traverse(TSNeverKeyword& node) {}
+        inline void Traverse(TSNullKeyword& node) {}
+        inline void Traverse(TSNumberKeyword& node) {}
+        inline void Traverse(TSObjectKeyword& node) {}
+        inline void Traverse(TSStringKeyword& node) {}
+        inline void Traverse(TSSymbolKeyword& node) {}
+        inline void Traverse(TSUndefinedKeyword& node) {}
+        inline void Traverse(TSUnknownKeyword& node) {}
+        inline void Traverse(TSVoidKeyword& node) {}
+        inline void Traverse(TSThisType& node) {}
+        inline void Traverse(TSFunctionType& node) {}
+        inline void Traverse(TSConstructorType& node) {}
+        inline void Traverse(TSTypeReference& node) {}
+        inline void Traverse(TSTypePredicate& node) {}
+        inline void Traverse(TSTypeQuery& node) {}
+        inline void Traverse(TSTypeLiteral& node) {}
+        inline void Traverse(TSArrayType& node) {}
+        inline void Traverse(TSTupleType& node) {}
+        inline void Traverse(TSOptionalType& node) {}
+        inline void Traverse(TSRestType& node) {}
+        inline void Traverse(TSUnionType& node) {}
+        inline void Traverse(TSIntersectionType& node) {}
+        inline void Traverse(TSConditionalType& node) {}
+        inline void Traverse(TSInferType& node) {}
+        inline void Traverse(TSParenthesizedType& node) {}
+        inline void Traverse(TSTypeOperator& node) {}
+        inline void Traverse(TSIndexedAccessType& node) {}
+        inline void Traverse(TSMappedType& node) {}
+        inline void Traverse(TSLiteralType& node) {}
+        inline void Traverse(TSExpressionWithTypeArguments& node) {}
+        inline void Traverse(TSInterfaceDeclaration& node) {}
+        inline void Traverse(TSInterfaceBody& node) {}
+        inline void Traverse(TSTypeAliasDeclaration& node) {}
+        inline void Traverse(TSAsExpression& node) {}
+        inline void Traverse(TSTypeAssertion& node) {}
+        inline void Traverse(TSEnumDeclaration& node) {}
+        inline void Traverse(TSEnumMember& node) {}
+        inline void Traverse(TSModuleDeclaration& node) {}
+        inline void Traverse(TSModuleBlock& node) {}
+        inline void Traverse(TSImportType& node) {}
+        inline void Traverse(TSImportEqualsDeclaration& node) {}
+        inline void Traverse(TSExternalModuleReference& node) {}
+        inline void Traverse(TSNonNullExpression& node) {}
+        inline void Traverse(TSExportAssignment& node) {}
+        inline void Traverse(TSNamespaceExportDeclaration& node) {}
+        inline void Traverse(TSTypeAnnotation& node) {}
+        inline void Traverse(TSTypeParameterInstantiation& node) {}
+        inline void Traverse(TSTypeParameterDeclaration& node) {}
+        inline void Traverse(TSTypeParameter& node) {}
+
+    private:
+        inline Derived& Self() {
+            return *static_cast<Derived*>(this);
+        }
+
+    };
+
+}
@@ -2,64 +2,958 @@
 // Created by Duzhong Chen on 2020/4/3.
 //
 
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
 #include <string>
-#include <boost/lexical_cast.hpp>
+#include <string_view>
+#include <vector>
 #include "parser/NodesMaker.h"
 #include "ConstantFolding.h"
 #include "utils/string/UString.h"
 
 namespace jetpack {
 
-    inline Literal* MakeIntLiteral(AstContext& ctx, std::int32_t tmp) {
+// tricks from https://stackoverflow.com/questions/11544073/how-do-i-deal-with-the-max-macro-in-windows-h-colliding-with-max-in-std
+#define DUMMY
+
+    static const double NaN = std::numeric_limits<double>::quiet_NaN DUMMY ();
+
+    static const double Inf = std::numeric_limits<double>::infinity DUMMY ();
+
+    // integers beyond it can not be accumulated exactly
+    static const double MaxSafeInteger = 9007199254740991.0;
+
+    inline bool IsDecimalDigit(char ch) {
+        return ch >= '0' && ch <= '9';
+    }
+
+    inline bool IsStrWhiteSpace(char ch) {
+        return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\v' || ch == '\f' || ch == '\r';
+    }
+
+    /**
+     * NaN if the digits are invalid,
+     * nullopt if the result is not exact.
+     */
+    static std::optional<double> ParseRadixDigits(std::string_view digits, int radix) {
+        if (digits.empty()) {
+            return NaN;
+        }
+
+        double result = 0;
+        for (char ch : digits) {
+            int digit;
+            if (ch >= '0' && ch <= '9') {
+                digit = ch - '0';
+            } else if (ch >= 'a' && ch <= 'z') {
+                digit = ch - 'a' + 10;
+            } else if (ch >= 'A' && ch <= 'Z') {
+                digit = ch - 'A' + 10;
+            } else {
+                return NaN;
+            }
+            if (digit >= radix) {
+                return NaN;
+            }
+            result = result * radix + digit;
+        }
+
+        if (result > MaxSafeInteger) {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    /**
+     * StrUnsignedDecimalLiteral without "Infinity",
+     * e.g. `1`, `1.`, `.5`, `1.5e-3`
+     */
+    static std::optional<double> ParseDecimal(std::string_view str) {
+        std::size_t i = 0;
+        std::size_t digits = 0;
+        while (i < str.size() && IsDecimalDigit(str[i])) {
+            i++;
+            digits++;
+        }
+        if (i < str.size() && str[i] == '.') {
+            i++;
+            while (i < str.size() && IsDecimalDigit(str[i])) {
+                i++;
+                digits++;
+            }
+        }
+        if (digits == 0) {
+            return std::nullopt;
+        }
+        if (i < str.size() && (str[i] == 'e' || str[i] == 'E')) {
+            i++;
+            if (i < str.size() && (str[i] == '+' || str[i] == '-')) {
+                i++;
+            }
+            std::size_t exp_digits = 0;
+            while (i < str.size() && IsDecimalDigit(str[i])) {
+                i++;
+                exp_digits++;
+            }
+            if (exp_digits == 0) {
+                return std::nullopt;
+            }
+        }
+        if (i != str.size()) {
+            return std::nullopt;
+        }
+
+        std::string tmp(str);
+        return std::strtod(tmp.c_str(), nullptr);
+    }
+
+    /**
+     * The numeric literal in the source, e.g. `0x1F`, `0o17`, `017`, `1e3`
+     */
+    static std::optional<double> ParseNumberLiteral(const std::string& raw) {
+        if (raw.size() > 1 && raw[0] == '0') {
+            std::string_view view(raw);
+            switch (raw[1]) {
+                case 'x':
+                case 'X':
+                    return ParseRadixDigits(view.substr(2), 16);
+
+                case 'o':
+                case 'O':
+                    return ParseRadixDigits(view.substr(2), 8);
+
+                case 'b':
+                case 'B':
+                    return ParseRadixDigits(view.substr(2), 2);
+
+                default: {
+                    // legacy octal, `08` and `09` are decimal
+                    bool is_octal = true;
+                    for (std::size_t i = 1; i < raw.size(); i++) {
+                        if (raw[i] < '0' || raw[i] > '7') {
+                            is_octal = false;
+                            break;
+                        }
+                    }
+                    if (is_octal) {
+                        return ParseRadixDigits(view.substr(1), 8);
+                    }
+                    break;
+                }
+            }
+        }
+
+        return ParseDecimal(raw);
+    }
+
+    /**
+     * StringToNumber of ECMAScript
+     */
+    static std::optional<double> StringToNumber(const std::string& str) {
+        for (char ch : str) {
+            // unicode white spaces are not handled
+            if (static_cast<unsigned char>(ch) >= 0x80) {
+                return std::nullopt;
+            }
+        }
+
+        std::size_t begin = 0;
+        std::size_t end = str.size();
+        while (begin < end && IsStrWhiteSpace(str[begin])) {
+            begin++;
+        }
+        while (end > begin && IsStrWhiteSpace(str[end - 1])) {
+            end--;
+        }
+
+        std::string_view view(str.data() + begin, end - begin);
+        if (view.empty()) {
+            return 0;
+        }
+
+        if (view.size() > 2 && view[0] == '0') {
+            switch (view[1]) {
+                case 'x':
+                case 'X':
+                    return ParseRadixDigits(view.substr(2), 16);
+
+                case 'o':
+                case 'O':
+                    return ParseRadixDigits(view.substr(2), 8);
+
+                case 'b':
+                case 'B':
+                    return ParseRadixDigits(view.substr(2), 2);
+
+                default:
+                    break;
+            }
+        }
+
+        double sign = 1;
+        if (view[0] == '+' || view[0] == '-') {
+            sign = view[0] == '-' ? -1 : 1;
+            view = view.substr(1);
+        }
+
+        if (view == "Infinity") {
+            return sign * Inf;
+        }
+
+        auto result = ParseDecimal(view);
+        if (!result.has_value()) {
+            return NaN;
+        }
+        return sign * (*result);
+    }
+
+    inline int32_t ToInt32(double value) {
+        if (!std::isfinite(value)) {
+            return 0;
+        }
+        double tmp = std::fmod(std::trunc(value), 4294967296.0);
+        if (tmp < 0) {
+            tmp += 4294967296.0;
+        }
+        return static_cast<int32_t>(static_cast<uint32_t>(tmp));
+    }
+
+    inline uint32_t ToUint32(double value) {
+        return static_cast<uint32_t>(ToInt32(value));
+    }
+
+    /**
+     * Math.pow() differs from std::pow() when the exponent is NaN or infinity
+     */
+    inline double Exponentiate(double base, double exponent) {
+        if (std::isnan(exponent)) {
+            return NaN;
+        }
+        if (std::isinf(exponent) && (base == 1 || base == -1)) {
+            return NaN;
+        }
+        return std::pow(base, exponent);
+    }
+
+    /**
+     * Strings are compared by UTF-16 code units in JavaScript,
+     * which is different from UTF-8 bytes for the supplementary planes.
+     */
+    static std::u16string ToUtf16(const std::string& str) {
+        std::u16string result;
+        result.reserve(str.size());
+        uint32_t idx = 0;
+        auto buf = reinterpret_cast<const uint8_t*>(str.data());
+        while (idx < str.size()) {
+            char32_t cp = ReadCodepointFromUtf8(buf, &idx, str.size());
+            if (cp >= 0x10000) {
+                cp -= 0x10000;
+                result.push_back(static_cast<char16_t>(0xD800 + (cp >> 10)));
+                result.push_back(static_cast<char16_t>(0xDC00 + (cp & 0x3FF)));
+            } else {
+                result.push_back(static_cast<char16_t>(cp));
+            }
+        }
+        return result;
+    }
+
+    ConstantValue ConstantValue::MakeBoolean(bool value) {
+        ConstantValue result;
+        result.ty = Ty::Boolean;
+        result.boolean_ = value;
+        return result;
+    }
+
+    ConstantValue ConstantValue::MakeNumber(double value) {
+        ConstantValue result;
+        result.ty = Ty::Number;
+        result.number_ = value;
+        return result;
+    }
+
+    ConstantValue ConstantValue::MakeString(std::string value) {
+        ConstantValue result;
+        result.ty = Ty::String;
+        result.str_ = std::move(value);
+        return result;
+    }
+
+    bool ConstantValue::ToBoolean() const {
+        switch (ty) {
+            case Ty::Undefined:
+            case Ty::Null:
+                return false;
+
+            case Ty::Boolean:
+                return boolean_;
+
+            case Ty::Number:
+                return !(number_ == 0 || std::isnan(number_));
+
+            case Ty::String:
+                return !str_.empty();
+
+        }
+        return false;
+    }
+
+    std::optional<double> ConstantValue::ToNumber() const {
+        switch (ty) {
+            case Ty::Undefined:
+                return NaN;
+
+            case Ty::Null:
+                return 0;
+
+            case Ty::Boolean:
+                return boolean_ ? 1 : 0;
+
+            case Ty::Number:
+                return number_;
+
+            case Ty::String:
+                return StringToNumber(str_);
+
+        }
+        return std::nullopt;
+    }
+
+    std::string ConstantValue::ToString() const {
+        switch (ty) {
+            case Ty::Undefined:
+                return "undefined";
+
+            case Ty::Null:
+                return "null";
+
+            case Ty::Boolean:
+                return boolean_ ? "true" : "false";
+
+            case Ty::Number:
+                return ContantFolding::NumberToString(number_);
+
+            case Ty::String:
+                return str_;
+
+        }
+        return "";
+    }
+
+    static const char* TypeOf(const ConstantValue& value) {
+        switch (value.ty) {
+            case ConstantValue::Ty::Undefined:
+                return "undefined";
+
+            case ConstantValue::Ty::Null:
+                return "object";
+
+            case ConstantValue::Ty::Boolean:
+                return "boolean";
+
+            case ConstantValue::Ty::Number:
+                return "number";
+
+            case ConstantValue::Ty::String:
+                return "string";
+
+        }
+        return "undefined";
+    }
+
+    static bool StrictEquals(const ConstantValue& left, const ConstantValue& right) {
+        if (left.ty != right.ty) {
+            return false;
+        }
+        switch (left.ty) {
+            case ConstantValue::Ty::Undefined:
+            case ConstantValue::Ty::Null:
+                return true;
+
+            case ConstantValue::Ty::Boolean:
+                return left.boolean_ == right.boolean_;
+
+            case ConstantValue::Ty::Number:
+                return left.number_ == right.number_;  // NaN != NaN, 0 == -0
+
+            case ConstantValue::Ty::String:
+                return left.str_ == right.str_;
+
+        }
+        return false;
+    }
+
+    static std::optional<bool> LooseEquals(const ConstantValue& left, const ConstantValue& right) {
+        if (left.ty == right.ty) {
+            return StrictEquals(left, right);
+        }
+
+        bool left_nullish = left.ty == ConstantValue::Ty::Undefined || left.ty == ConstantValue::Ty::Null;
+        bool right_nullish = right.ty == ConstantValue::Ty::Undefined || right.ty == ConstantValue::Ty::Null;
+        if (left_nullish || right_nullish) {
+            return left_nullish && right_nullish;
+        }
+
+        // boolean, number and string are compared as numbers
+        auto left_num = left.ToNumber();
+        auto right_num = right.ToNumber();
+        if (!left_num.has_value() || !right_num.has_value()) {
+            return std::nullopt;
+        }
+        return *left_num == *right_num;
+    }
+
+    enum class CompareResult {
+        True,
+        False,
+        Undefined,  // NaN is involved
+    };
+
+    /**
+     * IsLessThan of ECMAScript
+     */
+    static std::optional<CompareResult> LessThan(const ConstantValue& left, const ConstantValue& right) {
+        if (left.ty == ConstantValue::Ty::String && right.ty == ConstantValue::Ty::String) {
+            return ToUtf16(left.str_) < ToUtf16(right.str_) ? CompareResult::True : CompareResult::False;
+        }
+
+        auto left_num = left.ToNumber();
+        auto right_num = right.ToNumber();
+        if (!left_num.has_value() || !right_num.has_value()) {
+            return std::nullopt;
+        }
+        if (std::isnan(*left_num) || std::isnan(*right_num)) {
+            return CompareResult::Undefined;
+        }
+        return *left_num < *right_num ? CompareResult::True : CompareResult::False;
+    }
+
+    static std::optional<ConstantValue> EvaluateBinary(const std::string& op,
+                                                       const ConstantValue& left,
+                                                       const ConstantValue& right) {
+        if (op == "+" && (left.ty == ConstantValue::Ty::String || right.ty == ConstantValue::Ty::String)) {
+            return ConstantValue::MakeString(left.ToString() + right.ToString());
+        }
+
+        if (op == "===") {
+            return ConstantValue::MakeBoolean(StrictEquals(left, right));
+        } else if (op == "!==") {
+            return ConstantValue::MakeBoolean(!StrictEquals(left, right));
+        } else if (op == "==" || op == "!=") {
+            auto eq = LooseEquals(left, right);
+            if (!eq.has_value()) {
+                return std::nullopt;
+            }
+            return ConstantValue::MakeBoolean(op == "==" ? *eq : !*eq);
+        } else if (op == "<" || op == ">" || op == "<=" || op == ">=") {
+            // a > b is b < a, a <= b is !(b < a), a >= b is !(a < b)
+            bool swap = op == ">" || op == "<=";
+            auto cmp = swap ? LessThan(right, left) : LessThan(left, right);
+            if (!cmp.has_value()) {
+                return std::nullopt;
+            }
+            if (op == "<" || op == ">") {
+                return ConstantValue::MakeBoolean(*cmp == CompareResult::True);
+            }
+            return ConstantValue::MakeBoolean(*cmp == CompareResult::False);
+        }
+
+        auto left_num = left.ToNumber();
+        auto right_num = right.ToNumber();
+        if (!left_num.has_value() || !right_num.has_value()) {
+            return std::nullopt;
+        }
+        double a = *left_num;
+        double b = *right_num;
+
+        if (op == "+") {
+            return ConstantValue::MakeNumber(a + b);
+        } else if (op == "-") {
+            return ConstantValue::MakeNumber(a - b);
+        } else if (op == "*") {
+            return ConstantValue::MakeNumber(a * b);
+        } else if (op == "/") {
+            return ConstantValue::MakeNumber(a / b);
+        } else if (op == "%") {
+            // the sign of fmod() follows the dividend, same as JavaScript
+            return ConstantValue::MakeNumber(std::fmod(a, b));
+        } else if (op == "**") {
+            return ConstantValue::MakeNumber(Exponentiate(a, b));
+        } else if (op == "&") {
+            return ConstantValue::MakeNumber(ToInt32(a) & ToInt32(b));
+        } else if (op == "|") {
+            return ConstantValue::MakeNumber(ToInt32(a) | ToInt32(b));
+        } else if (op == "^") {
+            return ConstantValue::MakeNumber(ToInt32(a) ^ ToInt32(b));
+        } else if (op == "<<") {
+            uint32_t shift = ToUint32(b) & 31;
+            return ConstantValue::MakeNumber(static_cast<int32_t>(ToUint32(a) << shift));
+        } else if (op == ">>") {
+            uint32_t shift = ToUint32(b) & 31;
+            return ConstantValue::MakeNumber(ToInt32(a) >> shift);
+        } else if (op == ">>>") {
+            uint32_t shift = ToUint32(b) & 31;
+            return ConstantValue::MakeNumber(ToUint32(a) >> shift);
+        }
+
+        // in, instanceof throw on primitives
+        return std::nullopt;
+    }
+
+    /**
+     * Integers are always folded,
+     * but `1/3` is shorter than `0.3333333333333333`.
+     */
+    static bool IsWorthFolding(const ConstantValue& result, std::size_t origin_length);
+
+    /**
+     * The length of the folded constant in the output.
+     */
+    static std::size_t PrintedLength(const ConstantValue& value) {
+        switch (value.ty) {
+            case ConstantValue::Ty::Undefined:
+                return 6;  // void 0
+
+            case ConstantValue::Ty::Null:
+                return 4;
+
+            case ConstantValue::Ty::Boolean:
+                return 2;  // !0
+
+            case ConstantValue::Ty::Number:
+                if (std::isnan(value.number_)) {
+                    return 3;  // 0/0
+                }
+                if (std::isinf(value.number_)) {
+                    return value.number_ > 0 ? 3 : 4;  // 1/0, -1/0
+                }
+                return ContantFolding::NumberToString(value.number_).size();
+
+            case ConstantValue::Ty::String:
+                return value.str_.size() + 2;
+
+        }
+        return 0;
+    }
+
+    static bool IsWorthFolding(const ConstantValue& result, std::size_t origin_length) {
+        if (result.ty != ConstantValue::Ty::Number || std::trunc(result.number_) == result.number_) {
+            return true;
+        }
+        return PrintedLength(result) <= origin_length;
+    }
+
+    static std::optional<ConstantValue> EvaluateLiteral(Literal* lit) {
+        switch (lit->ty) {
+            case Literal::Ty::Boolean:
+                return ConstantValue::MakeBoolean(lit->boolean_);
+
+            case Literal::Ty::Double: {
+                auto num = ParseNumberLiteral(lit->raw);
+                if (!num.has_value()) {
+                    return std::nullopt;
+                }
+                return ConstantValue::MakeNumber(*num);
+            }
+
+            case Literal::Ty::String:
+                return ConstantValue::MakeString(lit->str_);
+
+            case Literal::Ty::Null: {
+                ConstantValue result;
+                result.ty = ConstantValue::Ty::Null;
+                return result;
+            }
+
+            default:
+                return std::nullopt;
+
+        }
+    }
+
+    /**
+     * `-1`, `void 0`
+     */
+    inline bool IsFoldedUnary(UnaryExpression* unary) {
+        if (unary->argument->type != SyntaxNodeType::Literal) {
+            return false;
+        }
+        auto lit = dynamic_cast<Literal*>(unary->argument);
+        if (unary->operator_ == "-") {
+            return lit->ty == Literal::Ty::Double;
+        }
+        return unary->operator_ == "void" && lit->raw == "0";
+    }
+
+    inline bool IsUnsignedNumber(Expression* expr) {
+        if (expr->type == SyntaxNodeType::Literal) {
+            return dynamic_cast<Literal*>(expr)->ty == Literal::Ty::Double;
+        }
+        return false;
+    }
+
+    /**
+     * `0/0`, `1/0`, `-1/0`
+     */
+    inline bool IsFoldedDivision(BinaryExpression* binary) {
+        if (binary->operator_ != "/" || !IsUnsignedNumber(binary->right)) {
+            return false;
+        }
+        if (binary->left->type == SyntaxNodeType::UnaryExpression) {
+            auto unary = dynamic_cast<UnaryExpression*>(binary->left);
+            return unary->operator_ == "-" && IsUnsignedNumber(unary->argument);
+        }
+        return IsUnsignedNumber(binary->left);
+    }
+
+    std::optional<ConstantValue> ContantFolding::Evaluate(Expression* expr) {
+        switch (expr->type) {
+            case SyntaxNodeType::Literal:
+                return EvaluateLiteral(dynamic_cast<Literal*>(expr));
+
+            case SyntaxNodeType::UnaryExpression: {
+                auto unary = dynamic_cast<UnaryExpression*>(expr);
+                if (unary->argument->type != SyntaxNodeType::Literal) {
+                    return std::nullopt;
+                }
+                if (unary->operator_ == "void") {  // literals have no side effects
+                    return ConstantValue();
+                }
+                // `!0` and `!1` of the minified booleans
+                if (unary->operator_ == "!") {
+                    auto value = EvaluateLiteral(dynamic_cast<Literal*>(unary->argument));
+                    if (!value.has_value()) {
+                        return std::nullopt;
+                    }
+                    return ConstantValue::MakeBoolean(!value->ToBoolean());
+                }
+                if (unary->operator_ != "-") {
+                    return std::nullopt;
+                }
+                auto lit = dynamic_cast<Literal*>(unary->argument);
+                if (lit->ty != Literal::Ty::Double) {
+                    return std::nullopt;
+                }
+                auto num = ParseNumberLiteral(lit->raw);
+                if (!num.has_value()) {
+                    return std::nullopt;
+                }
+                return ConstantValue::MakeNumber(-(*num));
+            }
+
+            case SyntaxNodeType::BinaryExpression: {
+                // don't walk down the tree, the children are already folded
+                auto binary = dynamic_cast<BinaryExpression*>(expr);
+                if (!IsFoldedDivision(binary)) {
+                    return std::nullopt;
+                }
+                auto left = Evaluate(binary->left);
+                auto right = Evaluate(binary->right);
+                if (!left.has_value() || !right.has_value()) {
+                    return std::nullopt;
+                }
+                return ConstantValue::MakeNumber(left->number_ / right->number_);
+            }
+
+            default:
+                return std::nullopt;
+
+        }
+    }
+
+    static Literal* MakeNumberLiteral(AstContext& ctx, double value) {
         auto lit = ctx.Alloc<Literal>();
         lit->ty = Literal::Ty::Double;
-        lit->str_ = std::to_string(tmp);
+        lit->double_ = value;
+        lit->str_ = ContantFolding::NumberToString(value);
         lit->raw = lit->str_;
         return lit;
     }
 
-// tricks from https://stackoverflow.com/questions/11544073/how-do-i-deal-with-the-max-macro-in-windows-h-colliding-with-max-in-std
-#define DUMMY
+    static UnaryExpression* MakeUnary(AstContext& ctx, const char* op, Expression* argument) {
+        auto unary = ctx.Alloc<UnaryExpression>();
+        unary->operator_ = op;
+        unary->argument = argument;
+        unary->prefix = true;
+        return unary;
+    }
+
+    static Expression* MakeNumber(AstContext& ctx, double value) {
+        if (std::isnan(value) || std::isinf(value)) {
+            auto binary = ctx.Alloc<BinaryExpression>();
+            binary->operator_ = "/";
+            if (std::isnan(value)) {
+                binary->left = MakeNumberLiteral(ctx, 0);
+            } else if (value > 0) {
+                binary->left = MakeNumberLiteral(ctx, 1);
+            } else {
+                binary->left = MakeUnary(ctx, "-", MakeNumberLiteral(ctx, 1));
+            }
+            binary->right = MakeNumberLiteral(ctx, 0);
+            return binary;
+        }
+
+        // -0 included
+        if (std::signbit(value)) {
+            return MakeUnary(ctx, "-", MakeNumberLiteral(ctx, -value));
+        }
+
+        return MakeNumberLiteral(ctx, value);
+    }
+
+    Expression* ContantFolding::MakeConstant(AstContext& ctx, const ConstantValue& value) {
+        switch (value.ty) {
+            case ConstantValue::Ty::Undefined:
+                return MakeUnary(ctx, "void", MakeNumberLiteral(ctx, 0));
+
+            case ConstantValue::Ty::Null:
+                return MakeNull(ctx);
+
+            case ConstantValue::Ty::Boolean: {
+                auto lit = ctx.Alloc<Literal>();
+                lit->ty = Literal::Ty::Boolean;
+                lit->boolean_ = value.boolean_;
+                lit->raw = value.boolean_ ? "true" : "false";
+                return lit;
+            }
+
+            case ConstantValue::Ty::Number:
+                return MakeNumber(ctx, value.number_);
+
+            case ConstantValue::Ty::String:
+                return MakeStringLiteral(ctx, value.str_);
+
+        }
+        return nullptr;
+    }
+
+    /**
+     * Ref: https://tc39.es/ecma262/#sec-numeric-types-number-tostring
+     */
+    std::string ContantFolding::NumberToString(double value) {
+        if (std::isnan(value)) {
+            return "NaN";
+        }
+        if (value == 0) {
+            return "0";
+        }
+        if (std::isinf(value)) {
+            return value > 0 ? "Infinity" : "-Infinity";
+        }
+        if (value < 0) {
+            return "-" + NumberToString(-value);
+        }
+
+        // the shortest digits which can be read back
+        char buf[32];
+        for (int precision = 1; precision <= 17; precision++) {
+            std::snprintf(buf, sizeof(buf), "%.*e", precision - 1, value);
+            if (std::strtod(buf, nullptr) == value) {
+                break;
+            }
+        }
+
+        // d.ddde+XX
+        std::string digits;
+        const char* ptr = buf;
+        for (; *ptr != 'e'; ptr++) {
+            if (*ptr != '.') {
+                digits.push_back(*ptr);
+            }
+        }
+        int exp = std::atoi(ptr + 1);
+        while (digits.size() > 1 && digits.back() == '0') {
+            digits.pop_back();
+        }
+
+        int k = static_cast<int>(digits.size());
+        int n = exp + 1;
+
+        if (k <= n && n <= 21) {
+            return digits + std::string(n - k, '0');
+        }
+        if (0 < n && n <= 21) {
+            return digits.substr(0, n) + "." + digits.substr(n);
+        }
+        if (-6 < n && n <= 0) {
+            return "0." + std::string(-n, '0') + digits;
+        }
 
-    inline bool IsValieResult(std::int64_t tmp) {
-        return tmp >= std::numeric_limits<std::int32_t>::min DUMMY () && tmp <= std::numeric_limits<std::int32_t>::max DUMMY ();
+        std::string exp_str = (n - 1 >= 0 ? "e+" : "e-") + std::to_string(std::abs(n - 1));
+        if (k == 1) {
+            return digits + exp_str;
+        }
+        return digits.substr(0, 1) + "." + digits.substr(1) + exp_str;
     }
 
     Expression* ContantFolding::TryBinaryExpression(AstContext& ctx, BinaryExpression* binary) {
-        if (binary->left->type == SyntaxNodeType::Literal
-            && binary->right->type == SyntaxNodeType::Literal) {
-
-            auto left_lit = dynamic_cast<Literal*>(binary->left);
-            auto right_lit = dynamic_cast<Literal*>(binary->right);
-
-            if (binary->operator_ == "+" && left_lit->ty == Literal::Ty::String && right_lit->ty == Literal::Ty::String) {
-                std::string result = left_lit->str_ + right_lit->str_;
-                return MakeStringLiteral(ctx, result);
-            } else if (left_lit->ty == Literal::Ty::Double && right_lit->ty == Literal::Ty::Double) {
-                int32_t left_int, right_int;
-                try {
-                    left_int = boost::lexical_cast<int32_t>(left_lit->str_);
-                    right_int = boost::lexical_cast<int32_t>(right_lit->str_);
-                } catch (const boost::bad_lexical_cast& ex) {
-                    return binary;
-                }
+        if (IsFoldedDivision(binary)) {
+            auto value = Evaluate(binary);
+            // keep `1/0` and `0/0`, they are the shortest form
+            if (!value.has_value() || !std::isfinite(value->number_)) {
+                return binary;
+            }
+        }
 
-                int64_t tmp_result = 0;
-                if (binary->operator_ == "+") {
-                    tmp_result = left_int + right_int;
-                } else if (binary->operator_ == "-") {
-                    tmp_result = left_int - right_int;
-                } else {
-                    return binary;
-                }
+        auto left = Evaluate(binary->left);
+        if (!left.has_value()) {
+            return binary;
+        }
 
-                if (!IsValieResult(tmp_result)) {
-                    return binary;
-                }
-                return MakeIntLiteral(ctx, static_cast<std::int32_t>(tmp_result));
+        // the result is one of the operands
+        if (binary->operator_ == "&&") {
+            return left->ToBoolean() ? binary->right : binary->left;
+        } else if (binary->operator_ == "||") {
+            return left->ToBoolean() ? binary->left : binary->right;
+        }
+
+        auto right = Evaluate(binary->right);
+        if (!right.has_value()) {
+            return binary;
+        }
+
+        auto result = EvaluateBinary(binary->operator_, *left, *right);
+        if (!result.has_value()) {
+            return binary;
+        }
+
+        if (!IsWorthFolding(*result, PrintedLength(*left) + binary->operator_.size() + PrintedLength(*right))) {
+            return binary;
+        }
+
+        return MakeConstant(ctx, *result);
+    }
+
+    Expression* ContantFolding::TryConditionalExpression(AstContext& ctx, ConditionalExpression* cond) {
+        auto test = Evaluate(cond->test);
+        if (!test.has_value()) {
+            return cond;
+        }
+
+        return test->ToBoolean() ? cond->consequent : cond->alternate;
+    }
+
+    Expression* ContantFolding::TryUnaryExpression(AstContext& ctx, UnaryExpression* unary) {
+        if (IsFoldedUnary(unary)) {
+            return unary;
+        }
+
+        const auto& op = unary->operator_;
+        if (op == "delete") {
+            return unary;
+        }
+
+        auto arg = Evaluate(unary->argument);
+        if (!arg.has_value()) {
+            return unary;
+        }
+
+        ConstantValue result;
+        if (op == "void") {
+            return MakeConstant(ctx, result);
+        } else if (op == "typeof") {
+            result = ConstantValue::MakeString(TypeOf(*arg));
+        } else if (op == "!") {
+            result = ConstantValue::MakeBoolean(!arg->ToBoolean());
+        } else {
+            auto num = arg->ToNumber();
+            if (!num.has_value()) {
+                return unary;
+            }
+            if (op == "-") {
+                result = ConstantValue::MakeNumber(-(*num));
+            } else if (op == "+") {
+                result = ConstantValue::MakeNumber(*num);
+            } else if (op == "~") {
+                result = ConstantValue::MakeNumber(~ToInt32(*num));
+            } else {
+                return unary;
+            }
+
+            if (!IsWorthFolding(result, op.size() + PrintedLength(*arg))) {
+                return unary;
+            }
+        }
+
+        return MakeConstant(ctx, result);
+    }
+
+    static std::string EscapeTemplateRaw(const std::string& str) {
+        std::string result;
+        result.reserve(str.size());
+        for (char ch : str) {
+            switch (ch) {
+                case '\\':
+                case '`':
+                case '$':
+                    result.push_back('\\');
+                    result.push_back(ch);
+                    break;
+
+                case '\r':  // normalized to \n if not escaped
+                    result += "\\r";
+                    break;
+
+                default:
+                    result.push_back(ch);
+                    break;
+
+            }
+        }
+        return result;
+    }
+
+    inline void AppendTemplateRaw(std::string& raw, const std::string& content) {
+        // `$` + `{` would begin a substitution
+        if (!raw.empty() && raw.back() == '$' && !content.empty() && content.front() == '{') {
+            raw.push_back('\\');
+        }
+        raw += content;
+    }
+
+    Expression* ContantFolding::TryTemplateLiteral(AstContext& ctx, TemplateLiteral* tpl) {
+        std::vector<std::optional<ConstantValue>> values;
+        values.reserve(tpl->expressions.size());
+        bool has_constant = false;
+        for (auto expr : tpl->expressions) {
+            values.push_back(Evaluate(expr));
+            has_constant = has_constant || values.back().has_value();
+        }
+
+        if (!has_constant) {
+            return tpl;
+        }
+
+        std::vector<TemplateElement*> quasis;
+        std::vector<Expression*> expressions;
+
+        // merge the constants and the following quasis into the previous one
+        TemplateElement* current = tpl->quasis[0];
+        for (std::size_t i = 0; i < tpl->expressions.size(); i++) {
+            auto next = tpl->quasis[i + 1];
+            if (values[i].has_value()) {
+                auto str = values[i]->ToString();
+                current->cooked += str;
+                AppendTemplateRaw(current->raw, EscapeTemplateRaw(str));
+                current->cooked += next->cooked;
+                AppendTemplateRaw(current->raw, next->raw);
+                current->tail = next->tail;
+            } else {
+                quasis.push_back(current);
+                expressions.push_back(tpl->expressions[i]);
+                current = next;
             }
         }
-        return binary;
+        quasis.push_back(current);
+
+        if (expressions.empty()) {
+            return MakeStringLiteral(ctx, quasis[0]->cooked);
+        }
+
+        tpl->quasis = std::move(quasis);
+        tpl->expressions = std::move(expressions);
+        return tpl;
     }
 
 }
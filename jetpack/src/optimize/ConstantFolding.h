@@ -4,16 +4,93 @@
 
 #pragma once
 
+#include <optional>
+#include <string>
 #include "parser/SyntaxNodes.h"
 #include "parser/AstContext.h"
 
 namespace jetpack {
 
+    /**
+     * A primitive value of JavaScript,
+     * the result of evaluating a constant expression.
+     */
+    struct ConstantValue {
+    public:
+        enum class Ty {
+            Undefined = 0,
+            Null,
+            Boolean,
+            Number,
+            String,
+        };
+
+        Ty ty = Ty::Undefined;
+
+        bool boolean_ = false;
+        double number_ = 0;
+        std::string str_;
+
+        static ConstantValue MakeBoolean(bool value);
+
+        static ConstantValue MakeNumber(double value);
+
+        static ConstantValue MakeString(std::string value);
+
+        [[nodiscard]]
+        bool ToBoolean() const;
+
+        /**
+         * nullopt if the result can not be decided at compile time,
+         * e.g. a string with unicode white spaces.
+         */
+        [[nodiscard]]
+        std::optional<double> ToNumber() const;
+
+        [[nodiscard]]
+        std::string ToString() const;
+
+    };
+
+    /**
+     * Fold the expressions bottom-up when they are being parsed,
+     * the results are exactly the same as JavaScript.
+     *
+     * A folded constant is represented as:
+     * - Literal: boolean, null, string and non-negative number
+     * - `-1`, `-0`: UnaryExpression of a number
+     * - `void 0`: undefined
+     * - `0/0`, `1/0`, `-1/0`: NaN and infinities
+     */
     class ContantFolding {
     public:
 
         static Expression* TryBinaryExpression(AstContext& ctx, BinaryExpression* binary);
 
+        static Expression* TryUnaryExpression(AstContext& ctx, UnaryExpression* unary);
+
+        /**
+         * `cond ? a : b` with a constant test.
+         */
+        static Expression* TryConditionalExpression(AstContext& ctx, ConditionalExpression* cond);
+
+        /**
+         * Untagged template literals only.
+         */
+        static Expression* TryTemplateLiteral(AstContext& ctx, TemplateLiteral* tpl);
+
+        /**
+         * Read the value of a folded constant, nullopt if it's not.
+         */
+        static std::optional<ConstantValue> Evaluate(Expression* expr);
+
+        static Expression* MakeConstant(AstContext& ctx, const ConstantValue& value);
+
+        /**
+         * Number::toString(10) of ECMAScript
+         */
+        static std::string NumberToString(double value);
+
     };
 
 }
@@ -0,0 +1,103 @@
+//
+// Created by Duzhong Chen on 2021/11/27.
+//
+
+#include "ConstantInlining.h"
+
+namespace jetpack {
+
+    // longer strings are kept in the variable
+    static const std::size_t MaxInlinedStringSize = 16;
+
+    bool ConstantInliner::IsInlinable(const ConstantValue& value) {
+        return value.ty != ConstantValue::Ty::String || value.str_.size() <= MaxInlinedStringSize;
+    }
+
+    int32_t ConstantInliner::RemainingReferences(Variable* var) const {
+        auto iter = remaining_.find(var);
+        if (iter == remaining_.end()) {
+            return 0;
+        }
+        return iter->second;
+    }
+
+    bool ConstantInliner::Visits(SyntaxNodeType type) const {
+        switch (type) {
+            case SyntaxNodeType::Identifier:
+            case SyntaxNodeType::ImportDeclaration:
+            case SyntaxNodeType::ExportNamedDeclaration:
+            case SyntaxNodeType::VariableDeclarator:
+                return true;
+
+            default:
+                return ExpressionRewriter::Visits(type);
+
+        }
+    }
+
+    bool ConstantInliner::TraverseBefore(Identifier* node) {
+        if (node->var != nullptr && constants_.find(node->var) != constants_.end()) {
+            remaining_[node->var]++;
+        }
+        return true;
+    }
+
+    bool ConstantInliner::TraverseBefore(ImportDeclaration* node) {
+        return false;
+    }
+
+    bool ConstantInliner::TraverseBefore(ExportNamedDeclaration* node) {
+        if (node->declaration.has_value()) {
+            TraverseNode(*node->declaration);
+        }
+        return false;
+    }
+
+    bool ConstantInliner::TraverseBefore(VariableDeclarator* node) {
+        // the default values of patterns are references
+        if (node->id->type != SyntaxNodeType::Identifier) {
+            return true;
+        }
+
+        if (node->init.has_value()) {
+            TraverseNode(*node->init);
+        }
+        TraverseAfter(node);
+        return false;
+    }
+
+    Expression* ConstantInliner::Rewrite(Expression* expr) {
+        switch (expr->type) {
+            case SyntaxNodeType::Identifier: {
+                auto id = dynamic_cast<Identifier*>(expr);
+                if (id->var == nullptr) {
+                    return expr;
+                }
+                auto iter = constants_.find(id->var);
+                if (iter == constants_.end()) {
+                    return expr;
+                }
+                remaining_[id->var]--;
+                replaced_count_++;
+                return ContantFolding::MakeConstant(ctx_, iter->second);
+            }
+
+            case SyntaxNodeType::BinaryExpression:
+                return ContantFolding::TryBinaryExpression(ctx_, dynamic_cast<BinaryExpression*>(expr));
+
+            case SyntaxNodeType::UnaryExpression:
+                return ContantFolding::TryUnaryExpression(ctx_, dynamic_cast<UnaryExpression*>(expr));
+
+            case SyntaxNodeType::ConditionalExpression:
+                return ContantFolding::TryConditionalExpression(ctx_, dynamic_cast<ConditionalExpression*>(expr));
+
+            case SyntaxNodeType::TemplateLiteral:
+                return ContantFolding::TryTemplateLiteral(ctx_, dynamic_cast<TemplateLiteral*>(expr));
+
+            default:
+                return expr;
+
+        }
+    }
+
+}
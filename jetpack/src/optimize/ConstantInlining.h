@@ -0,0 +1,76 @@
+//
+// Created by Duzhong Chen on 2021/11/27.
+//
+
+#pragma once
+
+#include "utils/Common.h"
+#include "parser/SyntaxNodes.h"
+#include "parser/AstContext.h"
+#include "scope/Variable.h"
+#include "ConstantFolding.h"
+#include "ExpressionRewriter.h"
+
+namespace jetpack {
+
+    /**
+     * Replace the references of constant variables with literals,
+     * and fold the expressions containing them again.
+     *
+     * The bindings themselves are not touched:
+     * - the id of VariableDeclarator
+     * - the specifiers of import and export
+     *
+     * The other references are counted,
+     * a variable is unused if all of them are replaced.
+     */
+    class ConstantInliner: public ExpressionRewriter {
+    public:
+        ConstantInliner(AstContext& ctx, const HashMap<Variable*, ConstantValue>& constants):
+        ctx_(ctx), constants_(constants) {}
+
+        /**
+         * Long strings are not inlined,
+         * the bundle would be larger.
+         */
+        static bool IsInlinable(const ConstantValue& value);
+
+        /**
+         * The references can't be replaced, e.g. `a++`
+         */
+        [[nodiscard]]
+        int32_t RemainingReferences(Variable* var) const;
+
+        [[nodiscard]]
+        inline int32_t ReplacedCount() const {
+            return replaced_count_;
+        }
+
+        [[nodiscard]]
+        inline const char* Name() const override {
+            return "Constant inlining";
+        }
+
+        [[nodiscard]]
+        bool Visits(SyntaxNodeType type) const override;
+
+        bool TraverseBefore(Identifier* node) override;
+        bool TraverseBefore(ImportDeclaration* node) override;
+        bool TraverseBefore(ExportNamedDeclaration* node) override;
+        bool TraverseBefore(VariableDeclarator* node) override;
+
+    protected:
+        Expression* Rewrite(Expression* expr) override;
+
+    private:
+        AstContext& ctx_;
+        const HashMap<Variable*, ConstantValue>& constants_;
+
+        // references visited minus replaced
+        HashMap<Variable*, int32_t> remaining_;
+
+        int32_t replaced_count_ = 0;
+
+    };
+
+}
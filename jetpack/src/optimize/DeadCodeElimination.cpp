@@ -0,0 +1,480 @@
+//
+// Created by Duzhong Chen on 2021/11/25.
+//
+
+#include <deque>
+#include "DeadCodeElimination.h"
+#include "ConstantFolding.h"
+#include "SideEffects.h"
+#include "codegen/StaticAutoNodeTraverser.h"
+
+namespace jetpack {
+
+    /**
+     * Collect the names declared by `var`,
+     * functions and classes have their own scopes.
+     */
+    class HoistedVarsCollector: public StaticAutoNodeTraverser<HoistedVarsCollector> {
+    public:
+        using StaticAutoNodeTraverser<HoistedVarsCollector>::TraverseBefore;
+
+        /**
+         * @param functions the function declarations in the blocks are hoisted as `var`,
+         * in the sloppy mode (Annex B)
+         */
+        HoistedVarsCollector(std::vector<Identifier*>& ids, bool functions): ids_(ids), functions_(functions) {}
+
+        bool TraverseBefore(VariableDeclaration* node) {
+            if (node->kind == VarKind::Var) {
+                for (auto decl : node->declarations) {
+                    CollectPattern(decl->id);
+                }
+            }
+            return false;
+        }
+
+        bool TraverseBefore(FunctionDeclaration* node) {
+            if (functions_ && node->id.has_value()) {
+                ids_.push_back(*node->id);
+            }
+            return false;
+        }
+
+        bool TraverseBefore(FunctionExpression* node) { return false; }
+        bool TraverseBefore(ArrowFunctionExpression* node) { return false; }
+        bool TraverseBefore(ClassDeclaration* node) { return false; }
+        bool TraverseBefore(ClassExpression* node) { return false; }
+
+    private:
+        void CollectPattern(SyntaxNode* pattern) {
+            switch (pattern->type) {
+                case SyntaxNodeType::Identifier:
+                    ids_.push_back(dynamic_cast<Identifier*>(pattern));
+                    break;
+
+                case SyntaxNodeType::ArrayPattern:
+                    for (auto& elm : dynamic_cast<ArrayPattern*>(pattern)->elements) {
+                        if (elm.has_value()) {
+                            CollectPattern(*elm);
+                        }
+                    }
+                    break;
+
+                case SyntaxNodeType::ObjectPattern:
+                    for (auto prop : dynamic_cast<ObjectPattern*>(pattern)->properties) {
+                        CollectPattern(prop);
+                    }
+                    break;
+
+                case SyntaxNodeType::Property: {
+                    auto prop = dynamic_cast<Property*>(pattern);
+                    if (prop->value.has_value()) {
+                        CollectPattern(*prop->value);
+                    }
+                    break;
+                }
+
+                case SyntaxNodeType::AssignmentPattern:
+                    CollectPattern(dynamic_cast<AssignmentPattern*>(pattern)->left);
+                    break;
+
+                case SyntaxNodeType::RestElement:
+                    CollectPattern(dynamic_cast<RestElement*>(pattern)->argument);
+                    break;
+
+                default:
+                    break;
+
+            }
+        }
+
+        std::vector<Identifier*>& ids_;
+        bool functions_;
+
+    };
+
+    /**
+     * `"use strict"` in the directive prologue
+     */
+    static bool HasUseStrict(const NodeList<SyntaxNode>& body) {
+        for (auto stmt : body) {
+            Expression* expr = nullptr;
+            if (stmt->type == SyntaxNodeType::Directive) {
+                expr = dynamic_cast<Directive*>(stmt)->expression;
+            } else if (stmt->type == SyntaxNodeType::ExpressionStatement) {
+                expr = dynamic_cast<ExpressionStatement*>(stmt)->expression;
+            }
+            if (expr == nullptr || expr->type != SyntaxNodeType::Literal) {
+                return false;
+            }
+            auto lit = dynamic_cast<Literal*>(expr);
+            if (lit->ty != Literal::Ty::String) {
+                return false;
+            }
+            // the escaped one is not a directive
+            if (lit->raw.size() == 12 && lit->raw.compare(1, 10, "use strict") == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline bool IsTerminator(SyntaxNode* stmt) {
+        switch (stmt->type) {
+            case SyntaxNodeType::ReturnStatement:
+            case SyntaxNodeType::ThrowStatement:
+            case SyntaxNodeType::BreakStatement:
+            case SyntaxNodeType::ContinueStatement:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    bool DeadCodeElimination::HasLexicalDeclaration(BlockStatement* block) {
+        for (auto stmt : block->body) {
+            switch (stmt->type) {
+                case SyntaxNodeType::FunctionDeclaration:
+                case SyntaxNodeType::ClassDeclaration:
+                    return true;
+
+                case SyntaxNodeType::VariableDeclaration:
+                    if (dynamic_cast<VariableDeclaration*>(stmt)->kind != VarKind::Var) {
+                        return true;
+                    }
+                    break;
+
+                default:
+                    break;
+
+            }
+        }
+        return false;
+    }
+
+    std::optional<VariableDeclaration*> DeadCodeElimination::HoistedVars(SyntaxNode* removed) {
+        std::vector<Identifier*> ids;
+        // the strictness is unknown out of a module
+        bool sloppy = !strict_.empty() && !strict_.back();
+        HoistedVarsCollector collector(ids, sloppy);
+        collector.TraverseNode(removed);
+
+        if (ids.empty()) {
+            return std::nullopt;
+        }
+
+        auto decl = ctx_.Alloc<VariableDeclaration>();
+        decl->kind = VarKind::Var;
+        for (auto id : ids) {
+            auto declarator = ctx_.Alloc<VariableDeclarator>(std::make_unique<Scope>(ctx_));
+            declarator->id = id;
+            decl->declarations.push_back(declarator);
+        }
+        return decl;
+    }
+
+    std::optional<std::vector<SyntaxNode*>> DeadCodeElimination::TryPrune(SyntaxNode* stmt) {
+        std::vector<SyntaxNode*> result;
+
+        switch (stmt->type) {
+            case SyntaxNodeType::IfStatement: {
+                auto if_stmt = dynamic_cast<IfStatement*>(stmt);
+                auto test = ContantFolding::Evaluate(if_stmt->test);
+                if (!test.has_value()) {
+                    return std::nullopt;
+                }
+
+                std::optional<Statement*> taken = if_stmt->consequent;
+                std::optional<Statement*> removed = if_stmt->alternate;
+                if (!test->ToBoolean()) {
+                    std::swap(taken, removed);
+                }
+
+                if (removed.has_value()) {
+                    if (auto vars = HoistedVars(*removed); vars.has_value()) {
+                        result.push_back(*vars);
+                    }
+                }
+
+                if (!taken.has_value()) {
+                    return result;
+                }
+
+                if ((*taken)->type == SyntaxNodeType::BlockStatement) {
+                    auto block = dynamic_cast<BlockStatement*>(*taken);
+                    if (!HasLexicalDeclaration(block)) {
+                        for (auto child : block->body) {
+                            result.push_back(child);
+                        }
+                        return result;
+                    }
+                }
+
+                result.push_back(*taken);
+                return result;
+            }
+
+            case SyntaxNodeType::WhileStatement: {
+                auto while_stmt = dynamic_cast<WhileStatement*>(stmt);
+                auto test = ContantFolding::Evaluate(while_stmt->test);
+                if (!test.has_value() || test->ToBoolean()) {
+                    return std::nullopt;
+                }
+
+                if (auto vars = HoistedVars(while_stmt->body); vars.has_value()) {
+                    result.push_back(*vars);
+                }
+                return result;
+            }
+
+            case SyntaxNodeType::EmptyStatement:
+                return result;
+
+            case SyntaxNodeType::ExpressionStatement: {
+                // the result of an annotated call is unused
+                auto expr_stmt = dynamic_cast<ExpressionStatement*>(stmt);
+                if (!SideEffects::IsPureCall(expr_stmt->expression)) {
+                    return std::nullopt;
+                }
+                return result;
+            }
+
+            default:
+                return std::nullopt;
+
+        }
+    }
+
+    bool DeadCodeElimination::SimplifyList(std::vector<SyntaxNode*>& stmts, bool remove_unreachable) {
+        std::vector<SyntaxNode*> result;
+        result.reserve(stmts.size());
+
+        bool changed = false;
+        bool reachable = true;
+        std::deque<SyntaxNode*> queue(std::begin(stmts), std::end(stmts));
+
+        while (!queue.empty()) {
+            auto stmt = queue.front();
+            queue.pop_front();
+
+            if (!reachable) {
+                changed = true;
+                if (stmt->type == SyntaxNodeType::FunctionDeclaration) {
+                    result.push_back(stmt);
+                } else if (auto vars = HoistedVars(stmt); vars.has_value()) {
+                    result.push_back(*vars);
+                }
+                continue;
+            }
+
+            // the replacements may be pruned again, e.g. `if (true) { if (false) {} }`
+            if (auto replaced = TryPrune(stmt); replaced.has_value()) {
+                changed = true;
+                queue.insert(std::begin(queue), std::begin(*replaced), std::end(*replaced));
+                continue;
+            }
+
+            result.push_back(stmt);
+            if (remove_unreachable && IsTerminator(stmt)) {
+                reachable = false;
+            }
+        }
+
+        if (changed) {
+            stmts = std::move(result);
+            MarkChanged();
+        }
+        return changed;
+    }
+
+    bool DeadCodeElimination::SimplifyList(NodeList<SyntaxNode>& stmts, bool remove_unreachable) {
+        auto vec = stmts.to_vec();
+        if (!SimplifyList(vec, remove_unreachable)) {
+            return false;
+        }
+
+        stmts.clear();
+        for (auto stmt : vec) {
+            stmts.push_back(stmt);
+        }
+        return true;
+    }
+
+    Statement* DeadCodeElimination::SimplifyStatement(Statement* stmt) {
+        std::vector<SyntaxNode*> stmts { stmt };
+        if (!SimplifyList(stmts, false)) {
+            return stmt;
+        }
+
+        if (stmts.empty()) {
+            return ctx_.Alloc<EmptyStatement>();
+        }
+
+        if (stmts.size() == 1) {
+            return dynamic_cast<Statement*>(stmts[0]);
+        }
+
+        // no lexical declarations, it's safe to wrap them in a block
+        auto block = ctx_.Alloc<BlockStatement>();
+        for (auto child : stmts) {
+            block->body.push_back(child);
+        }
+        return block;
+    }
+
+    bool DeadCodeElimination::Visits(SyntaxNodeType type) const {
+        switch (type) {
+            case SyntaxNodeType::Module:
+            case SyntaxNodeType::BlockStatement:
+            case SyntaxNodeType::SwitchCase:
+            case SyntaxNodeType::IfStatement:
+            case SyntaxNodeType::WhileStatement:
+            case SyntaxNodeType::DoWhileStatement:
+            case SyntaxNodeType::ForStatement:
+            case SyntaxNodeType::ForInStatement:
+            case SyntaxNodeType::ForOfStatement:
+            case SyntaxNodeType::LabeledStatement:
+            case SyntaxNodeType::FunctionDeclaration:
+            case SyntaxNodeType::FunctionExpression:
+            case SyntaxNodeType::ArrowFunctionExpression:
+            case SyntaxNodeType::ClassDeclaration:
+            case SyntaxNodeType::ClassExpression:
+                return true;
+
+            default:
+                return false;
+
+        }
+    }
+
+    bool DeadCodeElimination::TraverseBefore(Module* node) {
+        // the es modules are always strict
+        strict_.push_back(node->scope->moduleType() == ModuleScope::ModuleType::EsModule ||
+                          HasUseStrict(node->body));
+        SimplifyList(node->body, false);
+        return true;
+    }
+
+    bool DeadCodeElimination::TraverseBefore(BlockStatement* node) {
+        SimplifyList(node->body, true);
+        return true;
+    }
+
+    bool DeadCodeElimination::TraverseBefore(SwitchCase* node) {
+        std::vector<SyntaxNode*> stmts(std::begin(node->consequent), std::end(node->consequent));
+        if (SimplifyList(stmts, true)) {
+            node->consequent.clear();
+            for (auto stmt : stmts) {
+                node->consequent.push_back(dynamic_cast<Statement*>(stmt));
+            }
+        }
+        return true;
+    }
+
+    bool DeadCodeElimination::TraverseBefore(IfStatement* node) {
+        node->consequent = SimplifyStatement(node->consequent);
+        if (node->alternate.has_value()) {
+            auto alternate = SimplifyStatement(*node->alternate);
+            if (alternate->type == SyntaxNodeType::EmptyStatement) {
+                node->alternate.reset();
+            } else {
+                node->alternate = alternate;
+            }
+        }
+
+        // `if (a) { if (b) c; } else d;`, the else should not be taken by the inner if
+        if (node->alternate.has_value() && node->consequent->type == SyntaxNodeType::IfStatement) {
+            auto block = ctx_.Alloc<BlockStatement>();
+            block->body.push_back(node->consequent);
+            node->consequent = block;
+            MarkChanged();
+        }
+        return true;
+    }
+
+    bool DeadCodeElimination::TraverseBefore(WhileStatement* node) {
+        node->body = SimplifyStatement(node->body);
+        return true;
+    }
+
+    bool DeadCodeElimination::TraverseBefore(DoWhileStatement* node) {
+        node->body = SimplifyStatement(node->body);
+        return true;
+    }
+
+    bool DeadCodeElimination::TraverseBefore(ForStatement* node) {
+        node->body = SimplifyStatement(node->body);
+        return true;
+    }
+
+    bool DeadCodeElimination::TraverseBefore(ForInStatement* node) {
+        node->body = SimplifyStatement(node->body);
+        return true;
+    }
+
+    bool DeadCodeElimination::TraverseBefore(ForOfStatement* node) {
+        node->body = SimplifyStatement(node->body);
+        return true;
+    }
+
+    bool DeadCodeElimination::TraverseBefore(LabeledStatement* node) {
+        node->body = SimplifyStatement(node->body);
+        return true;
+    }
+
+    bool DeadCodeElimination::TraverseBefore(FunctionDeclaration* node) {
+        strict_.push_back(strict_.empty() || strict_.back() || HasUseStrict(node->body->body));
+        return true;
+    }
+
+    bool DeadCodeElimination::TraverseBefore(FunctionExpression* node) {
+        strict_.push_back(strict_.empty() || strict_.back() || HasUseStrict(node->body->body));
+        return true;
+    }
+
+    bool DeadCodeElimination::TraverseBefore(ArrowFunctionExpression* node) {
+        bool strict = strict_.empty() || strict_.back();
+        if (!strict && node->body->type == SyntaxNodeType::BlockStatement) {
+            strict = HasUseStrict(dynamic_cast<BlockStatement*>(node->body)->body);
+        }
+        strict_.push_back(strict);
+        return true;
+    }
+
+    // the classes are always strict
+    bool DeadCodeElimination::TraverseBefore(ClassDeclaration* node) {
+        strict_.push_back(true);
+        return true;
+    }
+
+    bool DeadCodeElimination::TraverseBefore(ClassExpression* node) {
+        strict_.push_back(true);
+        return true;
+    }
+
+    void DeadCodeElimination::TraverseAfter(Module* node) {
+        strict_.pop_back();
+    }
+
+    void DeadCodeElimination::TraverseAfter(FunctionDeclaration* node) {
+        strict_.pop_back();
+    }
+
+    void DeadCodeElimination::TraverseAfter(FunctionExpression* node) {
+        strict_.pop_back();
+    }
+
+    void DeadCodeElimination::TraverseAfter(ArrowFunctionExpression* node) {
+        strict_.pop_back();
+    }
+
+    void DeadCodeElimination::TraverseAfter(ClassDeclaration* node) {
+        strict_.pop_back();
+    }
+
+    void DeadCodeElimination::TraverseAfter(ClassExpression* node) {
+        strict_.pop_back();
+    }
+
+}
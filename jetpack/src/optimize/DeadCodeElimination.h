@@ -0,0 +1,105 @@
+//
+// Created by Duzhong Chen on 2021/11/25.
+//
+
+#pragma once
+
+#include <optional>
+#include <vector>
+#include "parser/SyntaxNodes.h"
+#include "parser/AstContext.h"
+#include "Pass.h"
+
+namespace jetpack {
+
+    /**
+     * Remove the branches with constant tests,
+     * the statements after return/throw/break/continue,
+     * and the unused calls annotated by `#__PURE__`.
+     * The pruned subtrees are never visited.
+     *
+     * Hoisting is respected:
+     * - the `var` declarations in the removed code are kept without initializers
+     * - the unreachable function declarations are kept
+     * - in the sloppy mode, the functions declared in the removed blocks keep their `var` bindings
+     *
+     * Run it after the constants are folded.
+     */
+    class DeadCodeElimination: public Pass {
+    public:
+        explicit DeadCodeElimination(AstContext& ctx): ctx_(ctx) {}
+
+        [[nodiscard]]
+        inline const char* Name() const override {
+            return "Dead code elimination";
+        }
+
+        [[nodiscard]]
+        bool Visits(SyntaxNodeType type) const override;
+
+        bool TraverseBefore(Module* node) override;
+        bool TraverseBefore(BlockStatement* node) override;
+        bool TraverseBefore(SwitchCase* node) override;
+        bool TraverseBefore(IfStatement* node) override;
+        bool TraverseBefore(WhileStatement* node) override;
+        bool TraverseBefore(DoWhileStatement* node) override;
+        bool TraverseBefore(ForStatement* node) override;
+        bool TraverseBefore(ForInStatement* node) override;
+        bool TraverseBefore(ForOfStatement* node) override;
+        bool TraverseBefore(LabeledStatement* node) override;
+        bool TraverseBefore(FunctionDeclaration* node) override;
+        bool TraverseBefore(FunctionExpression* node) override;
+        bool TraverseBefore(ArrowFunctionExpression* node) override;
+        bool TraverseBefore(ClassDeclaration* node) override;
+        bool TraverseBefore(ClassExpression* node) override;
+
+        void TraverseAfter(Module* node) override;
+        void TraverseAfter(FunctionDeclaration* node) override;
+        void TraverseAfter(FunctionExpression* node) override;
+        void TraverseAfter(ArrowFunctionExpression* node) override;
+        void TraverseAfter(ClassDeclaration* node) override;
+        void TraverseAfter(ClassExpression* node) override;
+
+        /**
+         * The statements in it can be moved to the parent,
+         * without changing their scopes.
+         */
+        static bool HasLexicalDeclaration(BlockStatement* block);
+
+    private:
+        /**
+         * @param remove_unreachable false for the body of module,
+         * because imports and exports are hoisted
+         * @return true if the list is changed
+         */
+        bool SimplifyList(std::vector<SyntaxNode*>& stmts, bool remove_unreachable);
+
+        bool SimplifyList(NodeList<SyntaxNode>& stmts, bool remove_unreachable);
+
+        /**
+         * Simplify a statement which is not in a list,
+         * e.g. the alternate of `else if`.
+         */
+        Statement* SimplifyStatement(Statement* stmt);
+
+        /**
+         * @return the statements to replace it, nullopt if it can't be pruned
+         */
+        std::optional<std::vector<SyntaxNode*>> TryPrune(SyntaxNode* stmt);
+
+        /**
+         * `var a, b;` of the var declarations in the removed statement
+         */
+        std::optional<VariableDeclaration*> HoistedVars(SyntaxNode* removed);
+
+        AstContext& ctx_;
+
+        /**
+         * The functions in blocks are also `var` in the sloppy mode.
+         * The top is the strictness of the innermost function.
+         */
+        std::vector<bool> strict_;
+
+    };
+
+}
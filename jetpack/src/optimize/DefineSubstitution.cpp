@@ -0,0 +1,38 @@
+//
+// Created by Duzhong Chen on 2021/12/4.
+//
+
+#include "DefineSubstitution.h"
+
+namespace jetpack {
+
+    Expression* DefineSubstitution::Rewrite(Expression* expr) {
+        switch (expr->type) {
+            case SyntaxNodeType::Identifier:
+            case SyntaxNodeType::MemberExpression: {
+                auto value = defines_.Find(expr);
+                if (!value.has_value()) {
+                    return expr;
+                }
+                return ContantFolding::MakeConstant(ctx_, *value);
+            }
+
+            case SyntaxNodeType::BinaryExpression:
+                return ContantFolding::TryBinaryExpression(ctx_, dynamic_cast<BinaryExpression*>(expr));
+
+            case SyntaxNodeType::UnaryExpression:
+                return ContantFolding::TryUnaryExpression(ctx_, dynamic_cast<UnaryExpression*>(expr));
+
+            case SyntaxNodeType::ConditionalExpression:
+                return ContantFolding::TryConditionalExpression(ctx_, dynamic_cast<ConditionalExpression*>(expr));
+
+            case SyntaxNodeType::TemplateLiteral:
+                return ContantFolding::TryTemplateLiteral(ctx_, dynamic_cast<TemplateLiteral*>(expr));
+
+            default:
+                return expr;
+
+        }
+    }
+
+}
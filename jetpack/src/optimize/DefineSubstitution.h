@@ -0,0 +1,42 @@
+//
+// Created by Duzhong Chen on 2021/12/4.
+//
+
+#pragma once
+
+#include "parser/AstContext.h"
+#include "Defines.h"
+#include "ExpressionRewriter.h"
+
+namespace jetpack {
+
+    /**
+     * Replace the expressions in Defines with literals,
+     * and fold the expressions containing them.
+     *
+     * It runs after the symbols are resolved,
+     * the root identifier is substituted only if it's not declared by user,
+     * including a `var` hoisted from below.
+     *
+     * The assignment targets and the patterns are never replaced.
+     */
+    class DefineSubstitution: public ExpressionRewriter {
+    public:
+        DefineSubstitution(AstContext& ctx, const Defines& defines):
+        ctx_(ctx), defines_(defines) {}
+
+        [[nodiscard]]
+        inline const char* Name() const override {
+            return "Define substitution";
+        }
+
+    protected:
+        Expression* Rewrite(Expression* expr) override;
+
+    private:
+        AstContext& ctx_;
+        const Defines& defines_;
+
+    };
+
+}
@@ -0,0 +1,99 @@
+//
+// Created by Duzhong Chen on 2021/11/26.
+//
+
+#include "Defines.h"
+#include "parser/Parser.hpp"
+
+namespace jetpack {
+
+    /**
+     * `a.b.c` -> `a`
+     */
+    static Identifier* RootOfChain(Expression* expr) {
+        while (expr->type == SyntaxNodeType::MemberExpression) {
+            auto member = dynamic_cast<MemberExpression*>(expr);
+            if (member->computed || member->property->type != SyntaxNodeType::Identifier) {
+                return nullptr;
+            }
+            expr = member->object;
+        }
+
+        if (expr->type != SyntaxNodeType::Identifier) {
+            return nullptr;
+        }
+        return dynamic_cast<Identifier*>(expr);
+    }
+
+    static void AppendChain(std::string& key, Expression* expr) {
+        if (expr->type == SyntaxNodeType::Identifier) {
+            key += dynamic_cast<Identifier*>(expr)->name;
+            return;
+        }
+
+        auto member = dynamic_cast<MemberExpression*>(expr);
+        AppendChain(key, member->object);
+        key.push_back('.');
+        key += dynamic_cast<Identifier*>(member->property)->name;
+    }
+
+    bool Defines::Add(const std::string& key, std::string_view value) {
+        auto config = parser::Config::Default();
+        config.constant_folding = true;
+        AstContext ctx;
+
+        std::optional<ConstantValue> result;
+        try {
+            std::string src = "(" + std::string(value) + ");";
+            parser::Parser parser(ctx, src, config);
+            auto mod = parser.ParseModule();
+            if (mod->body.size() != 1) {
+                return false;
+            }
+            auto stmt = dynamic_cast<ExpressionStatement*>(*mod->body.begin());
+            if (stmt == nullptr) {
+                return false;
+            }
+            result = ContantFolding::Evaluate(stmt->expression);
+        } catch (parser::ParseError& err) {
+            return false;
+        }
+
+        if (!result.has_value()) {
+            return false;
+        }
+
+        roots_.insert(key.substr(0, key.find('.')));
+        values_[key] = std::move(*result);
+        return true;
+    }
+
+    bool Defines::AddFromString(std::string_view define) {
+        auto pos = define.find('=');
+        if (pos == std::string_view::npos || pos == 0) {
+            return false;
+        }
+        return Add(std::string(define.substr(0, pos)), define.substr(pos + 1));
+    }
+
+    std::optional<ConstantValue> Defines::Find(Expression* expr) const {
+        auto root = RootOfChain(expr);
+        if (root == nullptr || roots_.find(root->name) == roots_.end()) {
+            return std::nullopt;
+        }
+
+        // declared by user, e.g. `const process = {}`
+        if (root->var != nullptr) {
+            return std::nullopt;
+        }
+
+        std::string key;
+        AppendChain(key, expr);
+        auto iter = values_.find(key);
+        if (iter == values_.end()) {
+            return std::nullopt;
+        }
+        return iter->second;
+    }
+
+}
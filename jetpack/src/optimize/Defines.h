@@ -0,0 +1,54 @@
+//
+// Created by Duzhong Chen on 2021/11/26.
+//
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include "utils/Common.h"
+#include "parser/SyntaxNodes.h"
+#include "ConstantFolding.h"
+
+namespace jetpack {
+
+    /**
+     * Global constants replaced after the symbols are resolved,
+     * e.g. `process.env.NODE_ENV` -> `"production"`.
+     *
+     * A replaced expression is a literal,
+     * so it can be folded and the dead branches can be eliminated.
+     */
+    class Defines {
+    public:
+        /**
+         * @param key an identifier or a member chain, e.g. `process.env.NODE_ENV`
+         * @param value a constant expression of JavaScript, e.g. `"production"`, `false`
+         * @return false if the value is not a constant
+         */
+        bool Add(const std::string& key, std::string_view value);
+
+        /**
+         * Parse `KEY=VALUE` of the command line.
+         */
+        bool AddFromString(std::string_view define);
+
+        [[nodiscard]]
+        inline bool Empty() const {
+            return values_.empty();
+        }
+
+        /**
+         * nullopt if the expression is not defined,
+         * or the root identifier is resolved to a variable declared by user.
+         */
+        std::optional<ConstantValue> Find(Expression* expr) const;
+
+    private:
+        HashSet<std::string> roots_;
+        HashMap<std::string, ConstantValue> values_;
+
+    };
+
+}
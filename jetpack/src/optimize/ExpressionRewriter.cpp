@@ -0,0 +1,254 @@
+//
+// Created by Duzhong Chen on 2021/11/29.
+//
+
+#include "ExpressionRewriter.h"
+
+namespace jetpack {
+
+    bool ExpressionRewriter::Visits(SyntaxNodeType type) const {
+        switch (type) {
+            case SyntaxNodeType::ArrayExpression:
+            case SyntaxNodeType::ArrowFunctionExpression:
+            case SyntaxNodeType::AssignmentExpression:
+            case SyntaxNodeType::AssignmentPattern:
+            case SyntaxNodeType::AwaitExpression:
+            case SyntaxNodeType::BinaryExpression:
+            case SyntaxNodeType::CallExpression:
+            case SyntaxNodeType::ConditionalExpression:
+            case SyntaxNodeType::DoWhileStatement:
+            case SyntaxNodeType::ExportDefaultDeclaration:
+            case SyntaxNodeType::ExpressionStatement:
+            case SyntaxNodeType::ForStatement:
+            case SyntaxNodeType::IfStatement:
+            case SyntaxNodeType::JSXExpressionContainer:
+            case SyntaxNodeType::MemberExpression:
+            case SyntaxNodeType::NewExpression:
+            case SyntaxNodeType::ObjectExpression:
+            case SyntaxNodeType::ReturnStatement:
+            case SyntaxNodeType::SequenceExpression:
+            case SyntaxNodeType::SpreadElement:
+            case SyntaxNodeType::SwitchCase:
+            case SyntaxNodeType::SwitchStatement:
+            case SyntaxNodeType::TemplateLiteral:
+            case SyntaxNodeType::ThrowStatement:
+            case SyntaxNodeType::UnaryExpression:
+            case SyntaxNodeType::VariableDeclarator:
+            case SyntaxNodeType::WhileStatement:
+            case SyntaxNodeType::YieldExpression:
+                return true;
+
+            default:
+                return false;
+
+        }
+    }
+
+    Expression* ExpressionRewriter::Replace(Expression* expr) {
+        auto replaced = Rewrite(expr);
+        if (replaced != expr) {
+            MarkChanged();
+        }
+        return replaced;
+    }
+
+    SyntaxNode* ExpressionRewriter::Replace(SyntaxNode* node) {
+        if (!node->IsExpression()) {
+            return node;
+        }
+        return Replace(dynamic_cast<Expression*>(node));
+    }
+
+    void ExpressionRewriter::Replace(NodeList<SyntaxNode>& list) {
+        auto vec = list.to_vec();
+        bool changed = false;
+        for (auto& item : vec) {
+            auto replaced = Replace(item);
+            if (replaced != item) {
+                item = replaced;
+                changed = true;
+            }
+        }
+
+        if (!changed) {
+            return;
+        }
+
+        list.clear();
+        for (auto item : vec) {
+            list.push_back(item);
+        }
+    }
+
+    void ExpressionRewriter::TraverseAfter(ArrayExpression* node) {
+        for (auto& elm : node->elements) {
+            if (elm.has_value()) {
+                elm = Replace(*elm);
+            }
+        }
+    }
+
+    void ExpressionRewriter::TraverseAfter(ArrowFunctionExpression* node) {
+        node->body = Replace(node->body);
+    }
+
+    void ExpressionRewriter::TraverseAfter(AssignmentExpression* node) {
+        node->right = Replace(node->right);
+    }
+
+    void ExpressionRewriter::TraverseAfter(AssignmentPattern* node) {
+        node->right = Replace(node->right);
+    }
+
+    void ExpressionRewriter::TraverseAfter(AwaitExpression* node) {
+        node->argument = Replace(node->argument);
+    }
+
+    void ExpressionRewriter::TraverseAfter(BinaryExpression* node) {
+        node->left = Replace(node->left);
+        node->right = Replace(node->right);
+    }
+
+    void ExpressionRewriter::TraverseAfter(CallExpression* node) {
+        Replace(node->arguments);
+    }
+
+    void ExpressionRewriter::TraverseAfter(ConditionalExpression* node) {
+        node->test = Replace(node->test);
+        node->consequent = Replace(node->consequent);
+        node->alternate = Replace(node->alternate);
+    }
+
+    void ExpressionRewriter::TraverseAfter(DoWhileStatement* node) {
+        node->test = Replace(node->test);
+    }
+
+    void ExpressionRewriter::TraverseAfter(ExportDefaultDeclaration* node) {
+        node->declaration = Replace(node->declaration);
+    }
+
+    void ExpressionRewriter::TraverseAfter(ExpressionStatement* node) {
+        node->expression = Replace(node->expression);
+    }
+
+    void ExpressionRewriter::TraverseAfter(ForStatement* node) {
+        if (node->init.has_value()) {
+            node->init = Replace(*node->init);
+        }
+        if (node->test.has_value()) {
+            node->test = Replace(*node->test);
+        }
+        if (node->update.has_value()) {
+            node->update = Replace(*node->update);
+        }
+    }
+
+    void ExpressionRewriter::TraverseAfter(IfStatement* node) {
+        node->test = Replace(node->test);
+    }
+
+    void ExpressionRewriter::TraverseAfter(JSXExpressionContainer* node) {
+        node->expression = Replace(node->expression);
+    }
+
+    void ExpressionRewriter::TraverseAfter(MemberExpression* node) {
+        node->object = Replace(node->object);
+        if (node->computed) {
+            node->property = Replace(node->property);
+        }
+    }
+
+    void ExpressionRewriter::TraverseAfter(NewExpression* node) {
+        Replace(node->arguments);
+    }
+
+    void ExpressionRewriter::TraverseAfter(ObjectExpression* node) {
+        for (auto item : node->properties) {
+            if (item->type != SyntaxNodeType::Property) {
+                continue;
+            }
+            auto prop = dynamic_cast<Property*>(item);
+            if (prop->computed) {
+                prop->key = Replace(prop->key);
+            }
+            if (!prop->value.has_value()) {
+                continue;
+            }
+            auto value = Replace(*prop->value);
+            if (value != *prop->value) {
+                prop->value = value;
+                prop->shorthand = false;  // `{ a }` -> `{ a: 1 }`
+            }
+        }
+    }
+
+    void ExpressionRewriter::TraverseAfter(ReturnStatement* node) {
+        if (node->argument.has_value()) {
+            node->argument = Replace(*node->argument);
+        }
+    }
+
+    void ExpressionRewriter::TraverseAfter(SequenceExpression* node) {
+        for (auto& expr : node->expressions) {
+            expr = Replace(expr);
+        }
+    }
+
+    void ExpressionRewriter::TraverseAfter(SpreadElement* node) {
+        node->argument = Replace(node->argument);
+    }
+
+    void ExpressionRewriter::TraverseAfter(SwitchCase* node) {
+        if (node->test.has_value()) {
+            node->test = Replace(*node->test);
+        }
+    }
+
+    void ExpressionRewriter::TraverseAfter(SwitchStatement* node) {
+        node->discrimiant = Replace(node->discrimiant);
+    }
+
+    void ExpressionRewriter::TraverseAfter(TemplateLiteral* node) {
+        for (auto& expr : node->expressions) {
+            expr = Replace(expr);
+        }
+    }
+
+    void ExpressionRewriter::TraverseAfter(ThrowStatement* node) {
+        node->argument = Replace(node->argument);
+    }
+
+    void ExpressionRewriter::TraverseAfter(UnaryExpression* node) {
+        if (node->operator_ == "delete") {
+            return;
+        }
+        auto argument = Rewrite(node->argument);
+        if (argument == node->argument) {
+            return;
+        }
+        // `typeof (1 && a)` throws if `a` is not declared, `typeof a` doesn't
+        if (node->operator_ == "typeof" && argument->type == SyntaxNodeType::Identifier &&
+            dynamic_cast<Identifier*>(argument)->var == nullptr) {
+            return;
+        }
+        node->argument = argument;
+        MarkChanged();
+    }
+
+    void ExpressionRewriter::TraverseAfter(VariableDeclarator* node) {
+        if (node->init.has_value()) {
+            node->init = Replace(*node->init);
+        }
+    }
+
+    void ExpressionRewriter::TraverseAfter(WhileStatement* node) {
+        node->test = Replace(node->test);
+    }
+
+    void ExpressionRewriter::TraverseAfter(YieldExpression* node) {
+        if (node->argument.has_value()) {
+            node->argument = Replace(*node->argument);
+        }
+    }
+
+}
@@ -0,0 +1,68 @@
+//
+// Created by Duzhong Chen on 2021/11/29.
+//
+
+#pragma once
+
+#include "parser/SyntaxNodes.h"
+#include "Pass.h"
+
+namespace jetpack {
+
+    /**
+     * Replace the expressions bottom-up,
+     * the slots of expressions are rewritten after the children are visited.
+     *
+     * The patterns and the callees are never replaced.
+     */
+    class ExpressionRewriter: public Pass {
+    public:
+        [[nodiscard]]
+        bool Visits(SyntaxNodeType type) const override;
+
+        void TraverseAfter(ArrayExpression* node) override;
+        void TraverseAfter(ArrowFunctionExpression* node) override;
+        void TraverseAfter(AssignmentExpression* node) override;
+        void TraverseAfter(AssignmentPattern* node) override;
+        void TraverseAfter(AwaitExpression* node) override;
+        void TraverseAfter(BinaryExpression* node) override;
+        void TraverseAfter(CallExpression* node) override;
+        void TraverseAfter(ConditionalExpression* node) override;
+        void TraverseAfter(DoWhileStatement* node) override;
+        void TraverseAfter(ExportDefaultDeclaration* node) override;
+        void TraverseAfter(ExpressionStatement* node) override;
+        void TraverseAfter(ForStatement* node) override;
+        void TraverseAfter(IfStatement* node) override;
+        void TraverseAfter(JSXExpressionContainer* node) override;
+        void TraverseAfter(MemberExpression* node) override;
+        void TraverseAfter(NewExpression* node) override;
+        void TraverseAfter(ObjectExpression* node) override;
+        void TraverseAfter(ReturnStatement* node) override;
+        void TraverseAfter(SequenceExpression* node) override;
+        void TraverseAfter(SpreadElement* node) override;
+        void TraverseAfter(SwitchCase* node) override;
+        void TraverseAfter(SwitchStatement* node) override;
+        void TraverseAfter(TemplateLiteral* node) override;
+        void TraverseAfter(ThrowStatement* node) override;
+        void TraverseAfter(UnaryExpression* node) override;
+        void TraverseAfter(VariableDeclarator* node) override;
+        void TraverseAfter(WhileStatement* node) override;
+        void TraverseAfter(YieldExpression* node) override;
+
+    protected:
+        /**
+         * The children have been rewritten,
+         * return the replacement of the expression in its parent.
+         */
+        virtual Expression* Rewrite(Expression* expr) = 0;
+
+    private:
+        Expression* Replace(Expression* expr);
+
+        SyntaxNode* Replace(SyntaxNode* node);
+
+        void Replace(NodeList<SyntaxNode>& list);
+
+    };
+
+}
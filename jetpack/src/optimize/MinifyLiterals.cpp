@@ -0,0 +1,95 @@
+//
+// Created by Duzhong Chen on 2021/11/29.
+//
+
+#include <cmath>
+#include "MinifyLiterals.h"
+#include "ConstantFolding.h"
+
+namespace jetpack {
+
+    std::string MinifyLiterals::ShortestNumber(double value) {
+        std::string str = ContantFolding::NumberToString(value);
+
+        // 0.5 -> .5, 0.0005 -> 5e-4
+        if (str.size() > 2 && str[0] == '0' && str[1] == '.') {
+            str.erase(0, 1);
+            std::size_t first_digit = 1;
+            while (str[first_digit] == '0') {
+                first_digit++;
+            }
+            std::string digits = str.substr(first_digit);
+            std::string exp = digits + "e-" + std::to_string(digits.size() + first_digit - 1);
+            return exp.size() < str.size() ? exp : str;
+        }
+
+        // 1e+21 -> 1e21
+        if (auto pos = str.find("e+"); pos != std::string::npos) {
+            str.erase(pos + 1, 1);
+            return str;
+        }
+
+        // 1000 -> 1e3
+        if (str.find_first_not_of("0123456789") == std::string::npos) {
+            auto last_digit = str.find_last_not_of('0');
+            std::size_t zeros = str.size() - last_digit - 1;
+            if (zeros >= 3) {
+                return str.substr(0, last_digit + 1) + "e" + std::to_string(zeros);
+            }
+        }
+
+        return str;
+    }
+
+    Expression* MinifyLiterals::Rewrite(Expression* expr) {
+        switch (expr->type) {
+            case SyntaxNodeType::Identifier: {
+                auto id = dynamic_cast<Identifier*>(expr);
+                if (id->var != nullptr || id->name != "undefined") {
+                    return expr;
+                }
+                return ContantFolding::MakeConstant(ctx_, ConstantValue());
+            }
+
+            case SyntaxNodeType::Literal: {
+                auto lit = dynamic_cast<Literal*>(expr);
+                if (lit->ty == Literal::Ty::Double) {
+                    MinifyNumber(lit);
+                    return expr;
+                }
+                if (lit->ty != Literal::Ty::Boolean) {
+                    return expr;
+                }
+
+                bool value = lit->raw == "true";
+                auto num = ctx_.Alloc<Literal>();
+                num->ty = Literal::Ty::Double;
+                num->double_ = value ? 0 : 1;
+                num->raw = value ? "0" : "1";
+
+                auto unary = ctx_.Alloc<UnaryExpression>();
+                unary->operator_ = "!";
+                unary->argument = num;
+                unary->prefix = true;
+                return unary;
+            }
+
+            default:
+                return expr;
+
+        }
+    }
+
+    void MinifyLiterals::MinifyNumber(Literal* lit) {
+        // BigInt and the separators are not evaluated
+        auto value = ContantFolding::Evaluate(lit);
+        if (!value.has_value() || value->ty != ConstantValue::Ty::Number || !std::isfinite(value->number_)) {
+            return;
+        }
+        auto shortest = ShortestNumber(value->number_);
+        if (shortest.size() < lit->raw.size()) {
+            lit->raw = std::move(shortest);
+        }
+    }
+
+}
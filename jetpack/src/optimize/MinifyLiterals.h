@@ -0,0 +1,45 @@
+//
+// Created by Duzhong Chen on 2021/11/29.
+//
+
+#pragma once
+
+#include "parser/AstContext.h"
+#include "ExpressionRewriter.h"
+
+namespace jetpack {
+
+    /**
+     * Shorter forms of the literals for minifying:
+     * - `undefined` -> `void 0`, if it's not declared
+     * - `true` -> `!0`, `false` -> `!1`
+     * - the shortest form of numbers, e.g. `0.5` -> `.5`, `1000` -> `1e3`, `0xff` -> `255`
+     *
+     * Run it after the symbols are resolved,
+     * and after the passes reading the literals, e.g. DeadCodeElimination.
+     */
+    class MinifyLiterals: public ExpressionRewriter {
+    public:
+        explicit MinifyLiterals(AstContext& ctx): ctx_(ctx) {}
+
+        [[nodiscard]]
+        inline const char* Name() const override {
+            return "Minify literals";
+        }
+
+        /**
+         * The shortest source text of a finite non-negative number.
+         */
+        static std::string ShortestNumber(double value);
+
+    protected:
+        Expression* Rewrite(Expression* expr) override;
+
+    private:
+        void MinifyNumber(Literal* lit);
+
+        AstContext& ctx_;
+
+    };
+
+}
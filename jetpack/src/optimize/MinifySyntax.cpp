@@ -0,0 +1,525 @@
+//
+// Created by Duzhong Chen on 2021/11/30.
+//
+
+#include "MinifySyntax.h"
+#include "DeadCodeElimination.h"
+#include "ConstantFolding.h"
+
+namespace jetpack {
+
+    /**
+     * `undefined` or `void 0`
+     */
+    static bool IsUndefined(Expression* expr) {
+        switch (expr->type) {
+            case SyntaxNodeType::Identifier: {
+                auto id = dynamic_cast<Identifier*>(expr);
+                return id->var == nullptr && id->name == "undefined";
+            }
+
+            case SyntaxNodeType::UnaryExpression: {
+                auto unary = dynamic_cast<UnaryExpression*>(expr);
+                return unary->operator_ == "void" && unary->argument->type == SyntaxNodeType::Literal;
+            }
+
+            default:
+                return false;
+
+        }
+    }
+
+    /**
+     * The argument of `!a`, nullptr if it's not negated.
+     */
+    static Expression* NegatedArgument(Expression* expr) {
+        if (expr->type != SyntaxNodeType::UnaryExpression) {
+            return nullptr;
+        }
+        auto unary = dynamic_cast<UnaryExpression*>(expr);
+        if (!unary->prefix || unary->operator_ != "!") {
+            return nullptr;
+        }
+        return unary->argument;
+    }
+
+    /**
+     * An `else` after it would be taken by the inner `if`,
+     * e.g. `if (a) while (b) if (c) d();`
+     */
+    static bool EndsWithOpenIf(Statement* stmt) {
+        switch (stmt->type) {
+            case SyntaxNodeType::IfStatement: {
+                auto if_stmt = dynamic_cast<IfStatement*>(stmt);
+                if (!if_stmt->alternate.has_value()) {
+                    return true;
+                }
+                return EndsWithOpenIf(*if_stmt->alternate);
+            }
+
+            case SyntaxNodeType::WhileStatement:
+                return EndsWithOpenIf(dynamic_cast<WhileStatement*>(stmt)->body);
+
+            case SyntaxNodeType::ForStatement:
+                return EndsWithOpenIf(dynamic_cast<ForStatement*>(stmt)->body);
+
+            case SyntaxNodeType::ForInStatement:
+                return EndsWithOpenIf(dynamic_cast<ForInStatement*>(stmt)->body);
+
+            case SyntaxNodeType::ForOfStatement:
+                return EndsWithOpenIf(dynamic_cast<ForOfStatement*>(stmt)->body);
+
+            case SyntaxNodeType::LabeledStatement:
+                return EndsWithOpenIf(dynamic_cast<LabeledStatement*>(stmt)->body);
+
+            case SyntaxNodeType::WithStatement:
+                return EndsWithOpenIf(dynamic_cast<WithStatement*>(stmt)->body);
+
+            default:
+                return false;
+
+        }
+    }
+
+    /**
+     * `test && expr` if `when_true`, otherwise `test || expr`
+     */
+    static Expression* MakeLogical(AstContext& ctx, Expression* test, Expression* expr, bool when_true) {
+        if (auto arg = NegatedArgument(test); arg != nullptr) {
+            test = arg;
+            when_true = !when_true;
+        }
+        auto logical = ctx.Alloc<BinaryExpression>();
+        logical->operator_ = when_true ? "&&" : "||";
+        logical->left = test;
+        logical->right = expr;
+        return logical;
+    }
+
+    static Expression* MakeConditional(AstContext& ctx, Expression* test, Expression* consequent, Expression* alternate) {
+        if (auto arg = NegatedArgument(test); arg != nullptr) {
+            test = arg;
+            std::swap(consequent, alternate);
+        }
+        auto cond = ctx.Alloc<ConditionalExpression>();
+        cond->test = test;
+        cond->consequent = consequent;
+        cond->alternate = alternate;
+        return cond;
+    }
+
+    /**
+     * `"use strict";`, the ones leading a body are the directive prologue.
+     * The directives of the functions are parsed as expression statements.
+     */
+    static bool IsDirective(SyntaxNode* stmt) {
+        if (stmt->type == SyntaxNodeType::Directive) {
+            return true;
+        }
+        if (stmt->type != SyntaxNodeType::ExpressionStatement) {
+            return false;
+        }
+        auto expr = dynamic_cast<ExpressionStatement*>(stmt)->expression;
+        return expr->type == SyntaxNodeType::Literal && dynamic_cast<Literal*>(expr)->ty == Literal::Ty::String;
+    }
+
+    static Statement* MakeExpressionStatement(AstContext& ctx, Expression* expr) {
+        auto stmt = ctx.Alloc<ExpressionStatement>();
+        stmt->expression = expr;
+        return stmt;
+    }
+
+    Expression* MinifySyntax::Join(Expression* left, Expression* right) {
+        SequenceExpression* seq;
+        if (left->type == SyntaxNodeType::SequenceExpression) {
+            seq = dynamic_cast<SequenceExpression*>(left);
+        } else {
+            seq = ctx_.Alloc<SequenceExpression>();
+            seq->expressions.push_back(left);
+        }
+
+        if (right->type == SyntaxNodeType::SequenceExpression) {
+            for (auto expr : dynamic_cast<SequenceExpression*>(right)->expressions) {
+                seq->expressions.push_back(expr);
+            }
+        } else {
+            seq->expressions.push_back(right);
+        }
+        return seq;
+    }
+
+    Expression* MinifySyntax::ArgumentOf(ReturnStatement* stmt) {
+        if (stmt->argument.has_value()) {
+            return *stmt->argument;
+        }
+        return ContantFolding::MakeConstant(ctx_, ConstantValue());
+    }
+
+    Statement* MinifySyntax::Simplify(Statement* stmt) {
+        if (stmt->type != SyntaxNodeType::IfStatement) {
+            return stmt;
+        }
+        auto if_stmt = dynamic_cast<IfStatement*>(stmt);
+        auto consequent = if_stmt->consequent;
+
+        if (!if_stmt->alternate.has_value()) {
+            if (consequent->type == SyntaxNodeType::ExpressionStatement) {
+                auto expr = dynamic_cast<ExpressionStatement*>(consequent)->expression;
+                return MakeExpressionStatement(ctx_, MakeLogical(ctx_, if_stmt->test, expr, true));
+            }
+            if (consequent->type == SyntaxNodeType::EmptyStatement) {
+                return MakeExpressionStatement(ctx_, if_stmt->test);
+            }
+            return stmt;
+        }
+
+        auto alternate = *if_stmt->alternate;
+        if (alternate->type == SyntaxNodeType::ExpressionStatement) {
+            auto alt_expr = dynamic_cast<ExpressionStatement*>(alternate)->expression;
+            if (consequent->type == SyntaxNodeType::ExpressionStatement) {
+                auto cons_expr = dynamic_cast<ExpressionStatement*>(consequent)->expression;
+                return MakeExpressionStatement(ctx_, MakeConditional(ctx_, if_stmt->test, cons_expr, alt_expr));
+            }
+            if (consequent->type == SyntaxNodeType::EmptyStatement) {
+                return MakeExpressionStatement(ctx_, MakeLogical(ctx_, if_stmt->test, alt_expr, false));
+            }
+            return stmt;
+        }
+
+        if (consequent->type == SyntaxNodeType::ReturnStatement && alternate->type == SyntaxNodeType::ReturnStatement) {
+            auto cons_ret = dynamic_cast<ReturnStatement*>(consequent);
+            auto alt_ret = dynamic_cast<ReturnStatement*>(alternate);
+            if (!cons_ret->argument.has_value() && !alt_ret->argument.has_value()) {
+                return stmt;
+            }
+            auto ret = ctx_.Alloc<ReturnStatement>();
+            ret->argument = MakeConditional(ctx_, if_stmt->test, ArgumentOf(cons_ret), ArgumentOf(alt_ret));
+            return ret;
+        }
+
+        return stmt;
+    }
+
+    Statement* MinifySyntax::RemoveBraces(Statement* stmt) {
+        if (stmt->type != SyntaxNodeType::BlockStatement) {
+            return stmt;
+        }
+        auto block = dynamic_cast<BlockStatement*>(stmt);
+        if (DeadCodeElimination::HasLexicalDeclaration(block)) {
+            return stmt;
+        }
+
+        if (block->body.empty()) {
+            return ctx_.Alloc<EmptyStatement>();
+        }
+
+        if (block->body.size() == 1) {
+            if (auto child = dynamic_cast<Statement*>(*block->body.begin()); child != nullptr) {
+                return child;
+            }
+        }
+
+        return stmt;
+    }
+
+    void MinifySyntax::Append(std::vector<SyntaxNode*>& result, SyntaxNode* stmt) {
+        if (stmt->type == SyntaxNodeType::IfStatement) {
+            stmt = Simplify(dynamic_cast<IfStatement*>(stmt));
+        }
+
+        if (stmt->type == SyntaxNodeType::EmptyStatement) {
+            return;
+        }
+
+        if (result.empty()) {
+            result.push_back(stmt);
+            return;
+        }
+
+        auto last = result.back();
+        ExpressionStatement* last_expr = nullptr;
+        if (last->type == SyntaxNodeType::ExpressionStatement) {
+            last_expr = dynamic_cast<ExpressionStatement*>(last);
+        }
+
+        switch (stmt->type) {
+            case SyntaxNodeType::ExpressionStatement: {
+                if (last_expr == nullptr) {
+                    break;
+                }
+                last_expr->expression = Join(last_expr->expression, dynamic_cast<ExpressionStatement*>(stmt)->expression);
+                return;
+            }
+
+            case SyntaxNodeType::VariableDeclaration: {
+                if (last->type != SyntaxNodeType::VariableDeclaration) {
+                    break;
+                }
+                auto decl = dynamic_cast<VariableDeclaration*>(stmt);
+                auto last_decl = dynamic_cast<VariableDeclaration*>(last);
+                if (decl->kind != last_decl->kind) {
+                    break;
+                }
+                for (auto declarator : decl->declarations) {
+                    last_decl->declarations.push_back(declarator);
+                }
+                return;
+            }
+
+            case SyntaxNodeType::ReturnStatement: {
+                auto ret = dynamic_cast<ReturnStatement*>(stmt);
+
+                // `if (a) return b; return c;`
+                if (last->type == SyntaxNodeType::IfStatement) {
+                    auto if_stmt = dynamic_cast<IfStatement*>(last);
+                    if (if_stmt->alternate.has_value() || if_stmt->consequent->type != SyntaxNodeType::ReturnStatement) {
+                        break;
+                    }
+                    auto cons_ret = dynamic_cast<ReturnStatement*>(if_stmt->consequent);
+                    if (!cons_ret->argument.has_value() && !ret->argument.has_value()) {
+                        break;
+                    }
+                    auto merged = ctx_.Alloc<ReturnStatement>();
+                    merged->argument = MakeConditional(ctx_, if_stmt->test, ArgumentOf(cons_ret), ArgumentOf(ret));
+                    result.pop_back();
+                    Append(result, merged);
+                    return;
+                }
+
+                if (last_expr == nullptr || !ret->argument.has_value()) {
+                    break;
+                }
+                ret->argument = Join(last_expr->expression, *ret->argument);
+                result.pop_back();
+                Append(result, ret);
+                return;
+            }
+
+            case SyntaxNodeType::ThrowStatement: {
+                if (last_expr == nullptr) {
+                    break;
+                }
+                auto throw_stmt = dynamic_cast<ThrowStatement*>(stmt);
+                throw_stmt->argument = Join(last_expr->expression, throw_stmt->argument);
+                result.pop_back();
+                result.push_back(throw_stmt);
+                return;
+            }
+
+            case SyntaxNodeType::IfStatement: {
+                if (last_expr == nullptr) {
+                    break;
+                }
+                auto if_stmt = dynamic_cast<IfStatement*>(stmt);
+                if_stmt->test = Join(last_expr->expression, if_stmt->test);
+                result.pop_back();
+                result.push_back(if_stmt);
+                return;
+            }
+
+            default:
+                break;
+
+        }
+
+        result.push_back(stmt);
+    }
+
+    bool MinifySyntax::CompressList(std::vector<SyntaxNode*>& stmts) {
+        std::vector<SyntaxNode*> result;
+        result.reserve(stmts.size());
+
+        // the directives are kept as they are, they can't be joined
+        std::size_t prologue_size = 0;
+        while (prologue_size < stmts.size() && IsDirective(stmts[prologue_size])) {
+            result.push_back(stmts[prologue_size++]);
+        }
+
+        std::vector<SyntaxNode*> body;
+        for (auto iter = stmts.begin() + prologue_size; iter != stmts.end(); iter++) {
+            auto stmt = *iter;
+            if (stmt->type == SyntaxNodeType::BlockStatement) {
+                auto block = dynamic_cast<BlockStatement*>(stmt);
+                // a string leading the block would become a directive
+                bool leads_prologue = body.empty() && !block->body.empty() && IsDirective(*block->body.begin());
+                if (!leads_prologue && !DeadCodeElimination::HasLexicalDeclaration(block)) {
+                    for (auto child : block->body) {
+                        Append(body, child);
+                    }
+                    continue;
+                }
+            }
+            Append(body, stmt);
+        }
+        result.insert(result.end(), body.begin(), body.end());
+
+        if (result == stmts) {
+            return false;
+        }
+        stmts = std::move(result);
+        MarkChanged();
+        return true;
+    }
+
+    bool MinifySyntax::CompressList(NodeList<SyntaxNode>& stmts) {
+        auto vec = stmts.to_vec();
+        if (!CompressList(vec)) {
+            return false;
+        }
+
+        stmts.clear();
+        for (auto stmt : vec) {
+            stmts.push_back(stmt);
+        }
+        return true;
+    }
+
+    void MinifySyntax::RemoveLastReturn(BlockStatement* body) {
+        auto vec = body->body.to_vec();
+        if (vec.empty() || vec.back()->type != SyntaxNodeType::ReturnStatement) {
+            return;
+        }
+        if (dynamic_cast<ReturnStatement*>(vec.back())->argument.has_value()) {
+            return;
+        }
+
+        vec.pop_back();
+        body->body.clear();
+        for (auto stmt : vec) {
+            body->body.push_back(stmt);
+        }
+        MarkChanged();
+    }
+
+    bool MinifySyntax::Visits(SyntaxNodeType type) const {
+        switch (type) {
+            case SyntaxNodeType::Module:
+            case SyntaxNodeType::BlockStatement:
+            case SyntaxNodeType::SwitchCase:
+            case SyntaxNodeType::IfStatement:
+            case SyntaxNodeType::WhileStatement:
+            case SyntaxNodeType::ForStatement:
+            case SyntaxNodeType::ForInStatement:
+            case SyntaxNodeType::ForOfStatement:
+            case SyntaxNodeType::ReturnStatement:
+            case SyntaxNodeType::FunctionDeclaration:
+            case SyntaxNodeType::FunctionExpression:
+            case SyntaxNodeType::ArrowFunctionExpression:
+                return true;
+
+            default:
+                return false;
+
+        }
+    }
+
+    void MinifySyntax::TraverseAfter(Module* node) {
+        CompressList(node->body);
+    }
+
+    void MinifySyntax::TraverseAfter(BlockStatement* node) {
+        CompressList(node->body);
+    }
+
+    void MinifySyntax::TraverseAfter(SwitchCase* node) {
+        std::vector<SyntaxNode*> stmts(std::begin(node->consequent), std::end(node->consequent));
+        if (CompressList(stmts)) {
+            node->consequent.clear();
+            for (auto stmt : stmts) {
+                node->consequent.push_back(dynamic_cast<Statement*>(stmt));
+            }
+        }
+    }
+
+    void MinifySyntax::TraverseAfter(IfStatement* node) {
+        if (node->alternate.has_value()) {
+            auto alternate = Simplify(RemoveBraces(*node->alternate));
+            if (alternate->type == SyntaxNodeType::EmptyStatement) {
+                node->alternate.reset();
+                MarkChanged();
+            } else if (alternate != *node->alternate) {
+                node->alternate = alternate;
+                MarkChanged();
+            }
+        }
+
+        auto consequent = Simplify(RemoveBraces(node->consequent));
+        // the braces are needed by the else
+        if (node->alternate.has_value() && EndsWithOpenIf(consequent)) {
+            return;
+        }
+        if (consequent != node->consequent) {
+            node->consequent = consequent;
+            MarkChanged();
+        }
+    }
+
+    void MinifySyntax::TraverseAfter(WhileStatement* node) {
+        auto body = Simplify(RemoveBraces(node->body));
+        if (body != node->body) {
+            node->body = body;
+            MarkChanged();
+        }
+    }
+
+    void MinifySyntax::TraverseAfter(ForStatement* node) {
+        auto body = Simplify(RemoveBraces(node->body));
+        if (body != node->body) {
+            node->body = body;
+            MarkChanged();
+        }
+    }
+
+    void MinifySyntax::TraverseAfter(ForInStatement* node) {
+        auto body = Simplify(RemoveBraces(node->body));
+        if (body != node->body) {
+            node->body = body;
+            MarkChanged();
+        }
+    }
+
+    void MinifySyntax::TraverseAfter(ForOfStatement* node) {
+        auto body = Simplify(RemoveBraces(node->body));
+        if (body != node->body) {
+            node->body = body;
+            MarkChanged();
+        }
+    }
+
+    void MinifySyntax::TraverseAfter(ReturnStatement* node) {
+        if (node->argument.has_value() && IsUndefined(*node->argument)) {
+            node->argument.reset();
+            MarkChanged();
+        }
+    }
+
+    void MinifySyntax::TraverseAfter(FunctionDeclaration* node) {
+        RemoveLastReturn(node->body);
+    }
+
+    void MinifySyntax::TraverseAfter(FunctionExpression* node) {
+        RemoveLastReturn(node->body);
+    }
+
+    void MinifySyntax::TraverseAfter(ArrowFunctionExpression* node) {
+        if (node->body->type != SyntaxNodeType::BlockStatement) {
+            return;
+        }
+        auto body = dynamic_cast<BlockStatement*>(node->body);
+        RemoveLastReturn(body);
+
+        // `() => { return a; }`
+        auto stmts = body->body.to_vec();
+        if (stmts.size() != 1 || stmts[0]->type != SyntaxNodeType::ReturnStatement) {
+            return;
+        }
+        auto ret = dynamic_cast<ReturnStatement*>(stmts[0]);
+        if (!ret->argument.has_value()) {
+            return;
+        }
+        node->body = *ret->argument;
+        node->expression = true;
+        MarkChanged();
+    }
+
+}
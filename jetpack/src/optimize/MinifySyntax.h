@@ -0,0 +1,87 @@
+//
+// Created by Duzhong Chen on 2021/11/30.
+//
+
+#pragma once
+
+#include <vector>
+#include "parser/SyntaxNodes.h"
+#include "parser/AstContext.h"
+#include "Pass.h"
+
+namespace jetpack {
+
+    /**
+     * Shorter forms of the statements for minifying:
+     * - `var a = 1; var b = 2;` -> `var a = 1, b = 2;`
+     * - `a(); b();` -> `a(), b();`, also merged into the next `return`, `throw` and `if`
+     * - `if (a) b();` -> `a && b();`, `if (a) b(); else c();` -> `a ? b() : c();`
+     * - `if (a) return b; return c;` -> `return a ? b : c;`
+     * - `return undefined;` -> `return;`, and the last `return;` of a function is removed
+     * - `() => { return a; }` -> `() => a`
+     * - the braces of the blocks with one statement
+     *
+     * The lists are rewritten after their children, the whole tree is done in one traversal.
+     * Run it after the symbols are resolved.
+     */
+    class MinifySyntax: public Pass {
+    public:
+        explicit MinifySyntax(AstContext& ctx): ctx_(ctx) {}
+
+        [[nodiscard]]
+        inline const char* Name() const override {
+            return "Minify syntax";
+        }
+
+        [[nodiscard]]
+        bool Visits(SyntaxNodeType type) const override;
+
+        void TraverseAfter(Module* node) override;
+        void TraverseAfter(BlockStatement* node) override;
+        void TraverseAfter(SwitchCase* node) override;
+        void TraverseAfter(IfStatement* node) override;
+        void TraverseAfter(WhileStatement* node) override;
+        void TraverseAfter(ForStatement* node) override;
+        void TraverseAfter(ForInStatement* node) override;
+        void TraverseAfter(ForOfStatement* node) override;
+        void TraverseAfter(ReturnStatement* node) override;
+        void TraverseAfter(FunctionDeclaration* node) override;
+        void TraverseAfter(FunctionExpression* node) override;
+        void TraverseAfter(ArrowFunctionExpression* node) override;
+
+    private:
+        /**
+         * @return true if the list is changed
+         */
+        bool CompressList(std::vector<SyntaxNode*>& stmts);
+
+        bool CompressList(NodeList<SyntaxNode>& stmts);
+
+        /**
+         * Push the statement to the compressed list,
+         * merge it with the last one if possible.
+         */
+        void Append(std::vector<SyntaxNode*>& result, SyntaxNode* stmt);
+
+        /**
+         * Rewrite `if` to an expression or a `return`,
+         * the statement itself if it can't be.
+         */
+        Statement* Simplify(Statement* stmt);
+
+        /**
+         * The body of `if` and loops.
+         */
+        Statement* RemoveBraces(Statement* stmt);
+
+        void RemoveLastReturn(BlockStatement* body);
+
+        Expression* Join(Expression* left, Expression* right);
+
+        Expression* ArgumentOf(ReturnStatement* stmt);
+
+        AstContext& ctx_;
+
+    };
+
+}
@@ -0,0 +1,54 @@
+//
+// Created by Duzhong Chen on 2021/11/29.
+//
+
+#pragma once
+
+#include "parser/SyntaxNodes.h"
+#include "codegen/AutoNodeTraverser.h"
+
+namespace jetpack {
+
+    /**
+     * A transform which can be fused with the others into one traversal,
+     * see PassManager.
+     *
+     * It's still an AutoNodeTraverser, it can run alone by TraverseNode().
+     */
+    class Pass: public AutoNodeTraverser {
+    public:
+
+        [[nodiscard]]
+        virtual const char* Name() const = 0;
+
+        /**
+         * The hooks of the other node types are never called
+         * in a fused traversal.
+         */
+        [[nodiscard]]
+        virtual bool Visits(SyntaxNodeType type) const = 0;
+
+        /**
+         * The tree is changed since the last reset,
+         * for the fixed-point mode.
+         */
+        [[nodiscard]]
+        inline bool Changed() const {
+            return changed_;
+        }
+
+        inline void ResetChanged() {
+            changed_ = false;
+        }
+
+    protected:
+        inline void MarkChanged() {
+            changed_ = true;
+        }
+
+    private:
+        bool changed_ = false;
+
+    };
+
+}
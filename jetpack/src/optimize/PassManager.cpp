@@ -0,0 +1,171 @@
+//
+// Created by Duzhong Chen on 2021/11/29.
+//
+
+#include <chrono>
+#include "PassManager.h"
+#include "Benchmark.h"
+#include "codegen/StaticAutoNodeTraverser.h"
+
+namespace jetpack {
+
+    // TSTypeParameter is the last one
+    static constexpr std::size_t NodeTypeCount = static_cast<std::size_t>(SyntaxNodeType::TSTypeParameter) + 1;
+
+    /**
+     * Walk the tree once, dispatch the hooks to the passes.
+     */
+    class FusedTraverser: public StaticAutoNodeTraverser<FusedTraverser> {
+    public:
+        FusedTraverser(std::vector<std::unique_ptr<Pass>>& passes, bool profile):
+        profile_(profile) {
+            states_.resize(passes.size());
+            by_type_.resize(NodeTypeCount);
+            for (std::size_t i = 0; i < passes.size(); i++) {
+                states_[i].pass = passes[i].get();
+                for (std::size_t t = 0; t < NodeTypeCount; t++) {
+                    if (passes[i]->Visits(static_cast<SyntaxNodeType>(t))) {
+                        by_type_[t].push_back(&states_[i]);
+                    }
+                }
+            }
+            active_count_ = states_.size();
+        }
+
+        template <typename T>
+        inline bool TraverseBefore(T* node) {
+            return Before(node);
+        }
+
+        template <typename T>
+        inline void TraverseAfter(T* node) {
+            After(node);
+        }
+
+        void SubmitProfile() {
+            for (auto& state : states_) {
+                benchmark::SubmitPass(state.pass->Name(), state.elapsed_us);
+            }
+        }
+
+    private:
+        struct PassState {
+        public:
+            Pass* pass = nullptr;
+
+            // the node whose children are skipped by the pass
+            SyntaxNode* suspended_at = nullptr;
+
+            int64_t elapsed_us = 0;
+
+        };
+
+        template <typename T>
+        bool Before(T* node) {
+            auto& states = by_type_[static_cast<std::size_t>(node->type)];
+            for (auto state : states) {
+                if (state->suspended_at != nullptr) {
+                    continue;
+                }
+                if (!Measure(state, [state, node] { return state->pass->TraverseBefore(node); })) {
+                    state->suspended_at = node;
+                    active_count_--;
+                }
+            }
+
+            if (active_count_ > 0) {
+                return true;
+            }
+
+            // nobody walks down, TraverseAfter() is not called
+            Resume(states, node);
+            return false;
+        }
+
+        template <typename T>
+        void After(T* node) {
+            auto& states = by_type_[static_cast<std::size_t>(node->type)];
+            for (auto state : states) {
+                if (state->suspended_at != nullptr) {
+                    continue;
+                }
+                Measure(state, [state, node] {
+                    state->pass->TraverseAfter(node);
+                    return true;
+                });
+            }
+            Resume(states, node);
+        }
+
+        void Resume(std::vector<PassState*>& states, SyntaxNode* node) {
+            for (auto state : states) {
+                if (state->suspended_at == node) {
+                    state->suspended_at = nullptr;
+                    active_count_++;
+                }
+            }
+        }
+
+        template <typename Fn>
+        bool Measure(PassState* state, Fn fn) {
+            if (!profile_) {
+                return fn();
+            }
+            auto start = std::chrono::steady_clock::now();
+            bool result = fn();
+            auto end = std::chrono::steady_clock::now();
+            state->elapsed_us += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+            return result;
+        }
+
+        bool profile_;
+        std::vector<PassState> states_;
+        std::vector<std::vector<PassState*>> by_type_;
+        std::size_t active_count_ = 0;
+
+    };
+
+    void PassManager::AddPass(PassFactory factory) {
+        factories_.push_back(std::move(factory));
+    }
+
+    int32_t PassManager::Run(AstContext& ctx, SyntaxNode* root) const {
+        if (factories_.empty()) {
+            return 0;
+        }
+
+        std::vector<std::unique_ptr<Pass>> passes;
+        for (auto& factory : factories_) {
+            passes.push_back(factory(ctx));
+        }
+
+        FusedTraverser traverser(passes, profile_);
+        int32_t rounds = 0;
+        while (rounds < max_rounds_) {
+            for (auto& pass : passes) {
+                pass->ResetChanged();
+            }
+
+            traverser.TraverseNode(root);
+            rounds++;
+
+            if (!fixed_point_) {
+                break;
+            }
+
+            bool changed = false;
+            for (auto& pass : passes) {
+                changed = changed || pass->Changed();
+            }
+            if (!changed) {
+                break;
+            }
+        }
+
+        if (profile_) {
+            traverser.SubmitProfile();
+        }
+        return rounds;
+    }
+
+}
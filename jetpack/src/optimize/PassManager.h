@@ -0,0 +1,73 @@
+//
+// Created by Duzhong Chen on 2021/11/29.
+//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <functional>
+#include "parser/SyntaxNodes.h"
+#include "parser/AstContext.h"
+#include "Pass.h"
+
+namespace jetpack {
+
+    /**
+     * Run the passes fused into one traversal:
+     * the hooks of the passes are called in the order they are added,
+     * only for the node types they visit.
+     *
+     * If a pass skips the children of a node,
+     * it's suspended until the node is left,
+     * the others still walk down.
+     */
+    class PassManager {
+    public:
+        using PassFactory = std::function<std::unique_ptr<Pass>(AstContext&)>;
+
+        PassManager() = default;
+
+        /**
+         * The passes are created for every run,
+         * the manager can be shared by the threads.
+         */
+        void AddPass(PassFactory factory);
+
+        [[nodiscard]]
+        inline bool Empty() const {
+            return factories_.empty();
+        }
+
+        /**
+         * Traverse again until no pass changes the tree,
+         * at most max_rounds times.
+         */
+        inline void SetFixedPoint(bool fixed_point, int32_t max_rounds = 8) {
+            fixed_point_ = fixed_point;
+            max_rounds_ = max_rounds;
+        }
+
+        /**
+         * Submit the time of every pass to benchmark,
+         * the hooks are measured one by one.
+         */
+        inline void SetProfile(bool profile) {
+            profile_ = profile;
+        }
+
+        /**
+         * Thread-safe.
+         * @return the rounds of traversal
+         */
+        int32_t Run(AstContext& ctx, SyntaxNode* root) const;
+
+    private:
+        std::vector<PassFactory> factories_;
+        bool fixed_point_ = false;
+        int32_t max_rounds_ = 8;
+        bool profile_ = false;
+
+    };
+
+}
@@ -0,0 +1,47 @@
+//
+// Created by Duzhong Chen on 2021/11/28.
+//
+
+#include "ReferenceCounter.h"
+
+namespace jetpack {
+
+    int32_t ReferenceCounter::Count(Variable* var) const {
+        auto iter = counts_.find(var);
+        if (iter == counts_.end()) {
+            return 0;
+        }
+        return iter->second;
+    }
+
+    bool ReferenceCounter::TraverseBefore(Identifier* node) {
+        if (node->var != nullptr) {
+            counts_[node->var]++;
+        }
+        return true;
+    }
+
+    bool ReferenceCounter::TraverseBefore(ImportDeclaration* node) {
+        return false;
+    }
+
+    bool ReferenceCounter::TraverseBefore(ExportNamedDeclaration* node) {
+        if (node->declaration.has_value()) {
+            TraverseNode(*node->declaration);
+        }
+        return false;
+    }
+
+    bool ReferenceCounter::TraverseBefore(VariableDeclarator* node) {
+        // the default values of patterns are references
+        if (node->id->type != SyntaxNodeType::Identifier) {
+            return true;
+        }
+
+        if (node->init.has_value()) {
+            TraverseNode(*node->init);
+        }
+        return false;
+    }
+
+}
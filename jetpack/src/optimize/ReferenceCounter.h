@@ -0,0 +1,38 @@
+//
+// Created by Duzhong Chen on 2021/11/28.
+//
+
+#pragma once
+
+#include "utils/Common.h"
+#include "parser/SyntaxNodes.h"
+#include "codegen/StaticAutoNodeTraverser.h"
+#include "scope/Variable.h"
+
+namespace jetpack {
+
+    /**
+     * Count the references of the resolved variables.
+     *
+     * The bindings are not references:
+     * - the id of VariableDeclarator
+     * - the specifiers of import and export
+     */
+    class ReferenceCounter: public StaticAutoNodeTraverser<ReferenceCounter> {
+    public:
+        using StaticAutoNodeTraverser<ReferenceCounter>::TraverseBefore;
+
+        [[nodiscard]]
+        int32_t Count(Variable* var) const;
+
+        bool TraverseBefore(Identifier* node);
+        bool TraverseBefore(ImportDeclaration* node);
+        bool TraverseBefore(ExportNamedDeclaration* node);
+        bool TraverseBefore(VariableDeclarator* node);
+
+    private:
+        HashMap<Variable*, int32_t> counts_;
+
+    };
+
+}
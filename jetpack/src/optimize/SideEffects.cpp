@@ -0,0 +1,192 @@
+//
+// Created by Duzhong Chen on 2021/11/28.
+//
+
+#include "SideEffects.h"
+
+namespace jetpack {
+
+    bool SideEffects::MayHaveSideEffects(SyntaxNode* node) {
+        switch (node->type) {
+            case SyntaxNodeType::Literal:
+            case SyntaxNodeType::Identifier:
+            case SyntaxNodeType::ThisExpression:
+            case SyntaxNodeType::FunctionExpression:
+            case SyntaxNodeType::ArrowFunctionExpression:
+                return false;
+
+            case SyntaxNodeType::ClassExpression: {
+                auto cls = dynamic_cast<ClassExpression*>(node);
+                return cls->body.has_value() && !IsPureClass(cls->super_class, *cls->body);
+            }
+
+            case SyntaxNodeType::TemplateLiteral: {
+                for (auto expr : dynamic_cast<TemplateLiteral*>(node)->expressions) {
+                    if (MayHaveSideEffects(expr)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            case SyntaxNodeType::ArrayExpression: {
+                for (auto& elm : dynamic_cast<ArrayExpression*>(node)->elements) {
+                    // spread calls the iterator
+                    if (elm.has_value() && ((*elm)->type == SyntaxNodeType::SpreadElement || MayHaveSideEffects(*elm))) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            case SyntaxNodeType::ObjectExpression: {
+                for (auto item : dynamic_cast<ObjectExpression*>(node)->properties) {
+                    if (item->type != SyntaxNodeType::Property) {
+                        return true;
+                    }
+                    auto prop = dynamic_cast<Property*>(item);
+                    if (prop->computed && MayHaveSideEffects(prop->key)) {
+                        return true;
+                    }
+                    if (prop->value.has_value() && MayHaveSideEffects(*prop->value)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            case SyntaxNodeType::UnaryExpression: {
+                auto unary = dynamic_cast<UnaryExpression*>(node);
+                return unary->operator_ == "delete" || MayHaveSideEffects(unary->argument);
+            }
+
+            case SyntaxNodeType::BinaryExpression: {
+                auto binary = dynamic_cast<BinaryExpression*>(node);
+                // throw if the right side is not an object
+                if (binary->operator_ == "in" || binary->operator_ == "instanceof") {
+                    return true;
+                }
+                return MayHaveSideEffects(binary->left) || MayHaveSideEffects(binary->right);
+            }
+
+            case SyntaxNodeType::ConditionalExpression: {
+                auto cond = dynamic_cast<ConditionalExpression*>(node);
+                return MayHaveSideEffects(cond->test) ||
+                       MayHaveSideEffects(cond->consequent) ||
+                       MayHaveSideEffects(cond->alternate);
+            }
+
+            case SyntaxNodeType::SequenceExpression: {
+                for (auto expr : dynamic_cast<SequenceExpression*>(node)->expressions) {
+                    if (MayHaveSideEffects(expr)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            case SyntaxNodeType::CallExpression:
+            case SyntaxNodeType::NewExpression:
+                return !IsPureCall(node);
+
+            default:
+                return true;
+
+        }
+    }
+
+    bool SideEffects::IsPureCall(SyntaxNode* node) {
+        if (node->type == SyntaxNodeType::CallExpression) {
+            auto call = dynamic_cast<CallExpression*>(node);
+            return call->pure && IsPureCallee(call->callee) && IsPureList(call->arguments);
+        }
+        if (node->type == SyntaxNodeType::NewExpression) {
+            auto new_expr = dynamic_cast<NewExpression*>(node);
+            return new_expr->pure && IsPureCallee(new_expr->callee) && IsPureList(new_expr->arguments);
+        }
+        return false;
+    }
+
+    bool SideEffects::IsPureStatement(SyntaxNode* stmt) {
+        switch (stmt->type) {
+            case SyntaxNodeType::EmptyStatement:
+            case SyntaxNodeType::FunctionDeclaration:
+            case SyntaxNodeType::ImportDeclaration:
+            case SyntaxNodeType::ExportAllDeclaration:
+                return true;
+
+            case SyntaxNodeType::ClassDeclaration: {
+                auto cls = dynamic_cast<ClassDeclaration*>(stmt);
+                return IsPureClass(cls->super_class, cls->body);
+            }
+
+            case SyntaxNodeType::VariableDeclaration: {
+                for (auto declarator : dynamic_cast<VariableDeclaration*>(stmt)->declarations) {
+                    // destructuring may call getters and iterators
+                    if (declarator->id->type != SyntaxNodeType::Identifier) {
+                        return false;
+                    }
+                    if (declarator->init.has_value() && MayHaveSideEffects(*declarator->init)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            case SyntaxNodeType::ExportNamedDeclaration: {
+                auto export_decl = dynamic_cast<ExportNamedDeclaration*>(stmt);
+                return !export_decl->declaration.has_value() || IsPureStatement(*export_decl->declaration);
+            }
+
+            case SyntaxNodeType::ExportDefaultDeclaration: {
+                auto declaration = dynamic_cast<ExportDefaultDeclaration*>(stmt)->declaration;
+                if (declaration->type == SyntaxNodeType::FunctionDeclaration ||
+                    declaration->type == SyntaxNodeType::ClassDeclaration) {
+                    return IsPureStatement(declaration);
+                }
+                return !MayHaveSideEffects(declaration);
+            }
+
+            case SyntaxNodeType::ExpressionStatement:
+                return !MayHaveSideEffects(dynamic_cast<ExpressionStatement*>(stmt)->expression);
+
+            default:
+                return false;
+
+        }
+    }
+
+    bool SideEffects::IsPureCallee(Expression* callee) {
+        // reading the properties is trusted, e.g. `React.createElement`
+        if (callee->type == SyntaxNodeType::MemberExpression) {
+            auto member = dynamic_cast<MemberExpression*>(callee);
+            if (member->computed && MayHaveSideEffects(member->property)) {
+                return false;
+            }
+            return IsPureCallee(member->object);
+        }
+        return !MayHaveSideEffects(callee);
+    }
+
+    bool SideEffects::IsPureClass(std::optional<Identifier*> super_class, ClassBody* body) {
+        if (super_class.has_value() && MayHaveSideEffects(*super_class)) {
+            return false;
+        }
+        for (auto method : body->body) {
+            if (method->computed && method->key.has_value() && MayHaveSideEffects(*method->key)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool SideEffects::IsPureList(NodeList<SyntaxNode>& list) {
+        for (auto item : list) {
+            if (item->type == SyntaxNodeType::SpreadElement || MayHaveSideEffects(item)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+}
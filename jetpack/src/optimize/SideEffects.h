@@ -0,0 +1,45 @@
+//
+// Created by Duzhong Chen on 2021/11/28.
+//
+
+#pragma once
+
+#include "parser/SyntaxNodes.h"
+
+namespace jetpack {
+
+    /**
+     * A conservative analysis,
+     * an expression is free of side effects only if it's sure.
+     *
+     * Like the other bundlers, reading a variable is assumed
+     * to be free, and the calls annotated by `#__PURE__` are trusted.
+     */
+    class SideEffects {
+    public:
+
+        static bool MayHaveSideEffects(SyntaxNode* node);
+
+        /**
+         * An annotated call `f(a, b)` whose arguments are free of side effects,
+         * it can be dropped if the result is unused.
+         */
+        static bool IsPureCall(SyntaxNode* node);
+
+        /**
+         * The statement is free of side effects when the module is evaluated,
+         * e.g. declarations of functions and pure variables.
+         * The imports and exports from other modules are not checked.
+         */
+        static bool IsPureStatement(SyntaxNode* stmt);
+
+    private:
+        static bool IsPureCallee(Expression* callee);
+
+        static bool IsPureClass(std::optional<Identifier*> super_class, ClassBody* body);
+
+        static bool IsPureList(NodeList<SyntaxNode>& list);
+
+    };
+
+}
@@ -31,11 +31,24 @@ namespace jetpack {
             return Slice(str, size);
         }
 
+        /**
+         * Symbol ids are unique in one context,
+         * so they can be used as indexes of variables in the module.
+         */
+        inline int32_t NextSymbolId() {
+            return symbols_count_++;
+        }
+
+        inline int32_t SymbolsCount() const {
+            return symbols_count_;
+        }
+
         ~AstContext() noexcept;
 
     private:
         NoReleaseAllocator alloc_;
         std::vector<SyntaxNode*> nodes_;
+        int32_t symbols_count_ = 0;
 
     };
 
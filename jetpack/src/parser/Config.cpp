@@ -17,6 +17,7 @@ namespace jetpack::parser {
                 false,
                 false,
                 true,
+                nullptr,
         };
     }
 
@@ -5,8 +5,13 @@
 #pragma once
 
 #include <string>
+#include <memory>
 #include <optional>
 
+namespace jetpack {
+    class Defines;
+}
+
 namespace jetpack { namespace parser {
 
     struct Config {
@@ -28,6 +33,11 @@ namespace jetpack { namespace parser {
 
         bool common_js;
 
+        /**
+         * replaced after the symbols are resolved, nullptr if not any
+         */
+        std::shared_ptr<const Defines> defines;
+
     private:
         Config() = delete;
 
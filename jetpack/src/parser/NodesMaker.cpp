@@ -3,6 +3,7 @@
 //
 
 #include "NodesMaker.h"
+#include "utils/JetJSON.h"
 
 namespace jetpack {
 
@@ -33,7 +34,7 @@ namespace jetpack {
         auto lit = ctx.Alloc<Literal>();
         lit->ty = Literal::Ty::String;
         lit->str_ = str;
-        lit->raw = "\"" + str + "\"";
+        lit->raw = "\"" + EscapeJSONString(str) + "\"";
         return lit;
     }
 
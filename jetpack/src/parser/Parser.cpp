@@ -452,7 +452,7 @@ namespace jetpack::parser {
                 token = NextToken();
                 auto node = Alloc<Literal>();
                 node->ty = Literal::Ty::Boolean;
-                node->boolean_ = ctx->lookahead_.type == JsTokenType::TrueLiteral;
+                node->boolean_ = token.type == JsTokenType::TrueLiteral;
                 node->raw = GetTokenRaw(token);
                 return Finalize(marker, node);
             }
@@ -479,8 +479,13 @@ namespace jetpack::parser {
                 return Finalize(marker, node);
             }
 
-            case JsTokenType::Template:
-                return ParseTemplateLiteral(scope);
+            case JsTokenType::Template: {
+                auto tpl = ParseTemplateLiteral(scope);
+                if (ctx->config_.constant_folding) {
+                    return Finalize(marker, ContantFolding::TryTemplateLiteral(ctx->ast_context_, tpl));
+                }
+                return tpl;
+            }
 
             case JsTokenType::LeftParen:
                 ctx->is_binding_element_ = false;
@@ -624,6 +629,8 @@ namespace jetpack::parser {
                     });
                 } else {
                     shorthand = true;
+                    // `{ a }` references a
+                    scope.AddUnresolvedId(id);
                     value = move(id);
                 }
             } else {
@@ -1186,7 +1193,7 @@ namespace jetpack::parser {
                 if (expr->type == SyntaxNodeType::Import && node->arguments.size() != 1) {
                     TolerateError(ParseMessages::BadImportCallArity);
                 }
-                node->callee = expr;
+                node->callee = CalleeOf(expr);
                 expr = Finalize(StartNode(start_token), node);
                 if (async_arrow && Match(JsTokenType::Arrow)) {
                     auto temp = node->arguments.to_vec();
@@ -1220,7 +1227,7 @@ namespace jetpack::parser {
             } else if (ctx->lookahead_.type == JsTokenType::Template && ctx->lookahead_.head) {
                 auto node = Alloc<TaggedTemplateExpression>();
                 node->quasi = ParseTemplateLiteral(scope);
-                node->tag = expr;
+                node->tag = CalleeOf(expr);
                 expr = Finalize(StartNode(start_token), node);
             } else {
                 break;
@@ -1228,6 +1235,15 @@ namespace jetpack::parser {
         }
         ctx->allow_in_ = prev_allow_in;
 
+        // the annotation belongs to the outermost call, e.g. `/*#__PURE__*/ a.b().c()`
+        if (start_token.pure) {
+            if (expr->type == SyntaxNodeType::CallExpression) {
+                dynamic_cast<CallExpression*>(expr)->pure = true;
+            } else if (expr->type == SyntaxNodeType::NewExpression) {
+                dynamic_cast<NewExpression*>(expr)->pure = true;
+            }
+        }
+
         return expr;
     }
 
@@ -1595,6 +1611,8 @@ namespace jetpack::parser {
             NextToken();
 
             auto id = dynamic_cast<Identifier*>(expr);
+            // a label is not a variable, it's never bound or renamed
+            scope.RemoveUnresolvedId(id);
             std::string key = "$" + id->name;
 
             if (ctx->label_set_->find(key) != ctx->label_set_->end()) {
@@ -1639,8 +1657,8 @@ namespace jetpack::parser {
 
         std::optional<Identifier*> label;
         if (ctx->lookahead_.type == JsTokenType::Identifier && !ctx->has_line_terminator_) {
-            Scope scope(ctx->ast_context_);
-            Identifier* id = ParseVariableIdentifier(scope, VarKind::Invalid);
+            // a label is not a variable, it's never bound or renamed
+            Identifier* id = ParseIdentifierName();
 
             std::string key = "$" + id->name;
             if (auto& label_set = *ctx->label_set_; label_set.find(key) == label_set.end()) {
@@ -1667,8 +1685,8 @@ namespace jetpack::parser {
         auto node = Alloc<ContinueStatement>();
 
         if (ctx->lookahead_.type == JsTokenType::Identifier && !ctx->has_line_terminator_) {
-            Scope scope(ctx->ast_context_);
-            auto id = ParseVariableIdentifier(scope, VarKind::Invalid);
+            // a label is not a variable, it's never bound or renamed
+            auto id = ParseIdentifierName();
             node->label = id;
 
             std::string key = "$" + id->name;
@@ -2497,6 +2515,25 @@ namespace jetpack::parser {
         return std::nullopt;
     }
 
+    Expression* Parser::RecordFolded(Expression* expr, Expression* folded) {
+        if (folded != expr &&
+            (folded->type == SyntaxNodeType::Identifier || folded->type == SyntaxNodeType::MemberExpression)) {
+            ctx->folded_references_[folded] = expr;
+        }
+        return folded;
+    }
+
+    Expression* Parser::CalleeOf(Expression* expr) {
+        if (expr->type != SyntaxNodeType::MemberExpression ||
+            ctx->folded_references_.find(expr) == ctx->folded_references_.end()) {
+            return expr;
+        }
+        auto seq = Alloc<SequenceExpression>();
+        seq->expressions.push_back(ContantFolding::MakeConstant(ctx->ast_context_, ConstantValue::MakeNumber(0)));
+        seq->expressions.push_back(expr);
+        return seq;
+    }
+
     Expression* Parser::ParseAssignmentExpression(Scope& scope) {
         Expression* expr = nullptr;
 
@@ -2658,8 +2695,12 @@ namespace jetpack::parser {
                 return ParseAssignmentExpression(scope);
             });
 
-            node->test = move(expr);
-            expr = move(node);
+            node->test = expr;
+            if (ctx->config_.constant_folding) {
+                expr = RecordFolded(node, ContantFolding::TryConditionalExpression(ctx->ast_context_, node));
+            } else {
+                expr = move(node);
+            }
 
             ctx->is_assignment_target_ = false;
             ctx->is_binding_element_ = false;
@@ -2713,7 +2754,7 @@ namespace jetpack::parser {
                 std::string_view tokenView = TokenTypeToLiteral(left_tk.type);
                 binary->operator_ = std::string(tokenView.data(), tokenView.size());
                 if (ctx->config_.constant_folding) {
-                    expr = ContantFolding::TryBinaryExpression(ctx->ast_context_, binary);
+                    expr = RecordFolded(binary, ContantFolding::TryBinaryExpression(ctx->ast_context_, binary));
                 } else {
                     expr = binary;
                 }
@@ -2727,7 +2768,7 @@ namespace jetpack::parser {
                 binary->right = expr;
 
                 if (ctx->config_.constant_folding) {
-                    expr = Finalize(marker, ContantFolding::TryBinaryExpression(ctx->ast_context_, binary));
+                    expr = Finalize(marker, RecordFolded(binary, ContantFolding::TryBinaryExpression(ctx->ast_context_, binary)));
                 } else {
                     expr = Finalize(marker, binary);
                 }
@@ -2762,7 +2803,11 @@ namespace jetpack::parser {
                 return ParseExponentiationExpression(scope);
             });
             node->operator_ = "**";
-            expr = Finalize(start, node);
+            if (ctx->config_.constant_folding) {
+                expr = Finalize(start, ContantFolding::TryBinaryExpression(ctx->ast_context_, node));
+            } else {
+                expr = Finalize(start, node);
+            }
         }
 
         return expr;
@@ -2786,10 +2831,22 @@ namespace jetpack::parser {
             node->operator_ = std::string(tokenView.data(), tokenView.size());
             node->argument = expr;
             node->prefix = true;
+            // `delete (1 && a.b)` and `typeof (1 && a)` keep the folded expressions,
+            // `a` may be undeclared
+            if (auto iter = ctx->folded_references_.find(node->argument); iter != ctx->folded_references_.end()) {
+                if (node->operator_ == "delete" ||
+                    (node->operator_ == "typeof" && node->argument->type == SyntaxNodeType::Identifier)) {
+                    node->argument = iter->second;
+                }
+            }
             expr = Finalize(marker, node);
             if (ctx->strict_ && node->operator_ == "delete" && node->argument->type == SyntaxNodeType::Identifier) {
                 TolerateError(ParseMessages::StrictDelete);
             }
+            // keep the unary, `-1 ** 2` is a syntax error
+            if (ctx->config_.constant_folding && !Match(JsTokenType::Pow)) {
+                expr = Finalize(marker, ContantFolding::TryUnaryExpression(ctx->ast_context_, node));
+            }
             ctx->is_assignment_target_ = false;
             ctx->is_binding_element_ = false;
         } else if (ctx->await_ && MatchContextualKeyword("await")) {
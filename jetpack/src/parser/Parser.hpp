@@ -289,6 +289,17 @@ namespace jetpack::parser {
 
         std::optional<SyntaxNode*> CheckRequireCall(Scope& scope, CallExpression* call);
 
+        /**
+         * Remember the reference kept by folding the expression.
+         */
+        Expression* RecordFolded(Expression* expr, Expression* folded);
+
+        /**
+         * The callee kept by folding is called as `(0, a.b)()`,
+         * without `a` as the `this`.
+         */
+        Expression* CalleeOf(Expression* expr);
+
         ~Parser() = default;
 
         NodeCreatedEventEmitter<ImportDeclaration> import_decl_created_listener;
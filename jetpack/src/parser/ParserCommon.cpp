@@ -122,7 +122,7 @@ namespace jetpack::parser {
             scanner.Column(),
         };
 
-        CollectComments();
+        bool pure = CollectComments();
 
         if (scanner.Index().u8 != ctx->start_marker_.cursor.u8) {
             ctx->start_marker_ = ParserContext::Marker {
@@ -133,6 +133,7 @@ namespace jetpack::parser {
         }
 
         Token next = scanner.Lex();
+        next.pure = pure;
 
         ctx->has_line_terminator_ = token.lineNumber != next.lineNumber;
 
@@ -238,8 +239,18 @@ namespace jetpack::parser {
         return lookahead.type == JsTokenType::Identifier && lookahead.value == keyword;
     }
 
-    void ParserCommon::CollectComments() {
+    bool ParserCommon::CollectComments() {
+        auto begin = ctx->comments_.size();
         ctx->scanner_->ScanComments(ctx->comments_);
+
+        for (auto i = begin; i < ctx->comments_.size(); i++) {
+            const auto& value = ctx->comments_[i]->value_;
+            if (value.find("#__PURE__") != std::string::npos ||
+                value.find("@__PURE__") != std::string::npos) {
+                return true;
+            }
+        }
+        return false;
     }
 
     int ParserCommon::BinaryPrecedence(const Token& token) const {
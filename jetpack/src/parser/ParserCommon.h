@@ -131,7 +131,11 @@ namespace jetpack::parser {
 
         void ConsumeSemicolon();
 
-        void CollectComments();
+        /**
+         * @return true if there is a `#__PURE__` annotation
+         * in the collected comments
+         */
+        bool CollectComments();
 
         [[nodiscard]] int BinaryPrecedence(const Token& token) const;
 
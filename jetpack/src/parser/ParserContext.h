@@ -67,6 +67,12 @@ namespace jetpack::parser {
         std::optional<Token> first_cover_initialized_name_error_;
         std::unique_ptr<HashSet<std::string>> label_set_;
 
+        /**
+         * The references kept by folding `&&`, `||` and `?:` -> the folded expressions,
+         * `(1 && a.b)()` is not `a.b()`, and `typeof (1 && a)` is not `typeof a`.
+         */
+        HashMap<Expression*, Expression*> folded_references_;
+
     };
 
 }
@@ -109,6 +109,9 @@ namespace jetpack {
         Expression* callee;
         NodeList<SyntaxNode> arguments;
 
+        // annotated by `/*#__PURE__*/`, it can be dropped if the result is unused
+        bool pure = false;
+
     };
 
     class CatchClause: public SyntaxNode {
@@ -324,6 +327,17 @@ namespace jetpack {
 
         std::string name;
 
+        /**
+         * The binding resolved by scope, nullable.
+         * Renaming only changes the name of the variable,
+         * read the current name by GetName().
+         */
+        Variable* var = nullptr;
+
+        inline const std::string& GetName() const {
+            return var != nullptr ? var->name : name;
+        }
+
     };
 
     class IfStatement: public Statement {
@@ -449,6 +463,9 @@ namespace jetpack {
         Expression* callee;
         NodeList<SyntaxNode> arguments;
 
+        // annotated by `/*#__PURE__*/`, it can be dropped if the result is unused
+        bool pure = false;
+
     };
 
     class ObjectExpression: public Expression {
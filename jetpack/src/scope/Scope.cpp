@@ -47,16 +47,33 @@ namespace jetpack {
         } else {  // contruct a new
             var = std::make_shared<Variable>();
             var->scope = target_scope;
+            var->symbol_id = ctx_.NextSymbolId();
             var->name = var_id->name;
             var->kind = kind;
             target_scope->own_variables[var_id->name] = var;
         }
 
-        var->identifiers.push_back(var_id);
+        var->AddIdentifier(var_id);
+
+        if (target_scope != this) {  // hoisted var, the name is visible here too
+            MarkThrough(var.get());
+        }
 
         return var;
     }
 
+    void Scope::MarkThrough(Variable* var) {
+        if (var->scope->parent == nullptr) {  // root variables are renamed globally
+            return;
+        }
+
+        Scope* scope = this;
+        while (scope != nullptr && scope != var->scope) {
+            scope->through_variables.insert(var);
+            scope = scope->parent;
+        }
+    }
+
     /**
      * Recursively resolve symbols.
      *
@@ -68,7 +85,8 @@ namespace jetpack {
         for (auto iter = unresolved_id.begin(); iter != unresolved_id.end();) {
             auto var = RecursivelyFindVariable((*iter)->name);
             if (var != nullptr) {
-                var->identifiers.push_back(*iter);
+                var->AddIdentifier(*iter);
+                MarkThrough(var.get());
                 iter = unresolved_id.erase(iter);
             } else {
                 if (unresolve_collector) {
@@ -83,6 +101,10 @@ namespace jetpack {
         }
     }
 
+    /**
+     * Identifiers read the name from their variable,
+     * so renaming only touches the variable and the index.
+     */
     bool Scope::BatchRenameSymbols(const std::vector<std::tuple<std::string, std::string>>& changeset) {
         std::vector<PVar> buffer;
         buffer.reserve(changeset.size());
@@ -97,10 +119,6 @@ namespace jetpack {
             buffer.push_back(pvar);
             pvar->name = std::get<1>(tuple);
 
-            for (auto& id : pvar->identifiers) {
-                id->name = std::get<1>(tuple);
-            }
-
             own_variables.erase(iter);
         }
 
@@ -73,6 +73,18 @@ namespace jetpack {
             unresolved_id.push_back(id);
         }
 
+        /**
+         * The identifier turns out not to be a reference,
+         * e.g. the label of a statement.
+         */
+        inline void RemoveUnresolvedId(Identifier* id) {
+            if (!unresolved_id.empty() && unresolved_id.back() == id) {
+                unresolved_id.pop_back();
+                return;
+            }
+            unresolved_id.remove(id);
+        }
+
         void SetParent(Scope* parent_);
 
         inline bool RemoveVariable(const std::string& name) {
@@ -107,9 +119,20 @@ namespace jetpack {
 
         HashMap<std::string, PVar> own_variables;
 
+        /**
+         * Variables of enclosing non-root scopes which are
+         * referenced (or var-declared) in this scope or its children.
+         *
+         * Collected by ResolveAllSymbols(), used to decide
+         * which bindings can share the same minified name.
+         */
+        HashSet<Variable*> through_variables;
+
         std::vector<Scope*> children;
 
     protected:
+        void MarkThrough(Variable* var);
+
         AstContext& ctx_;
         Scope* parent = nullptr;
 
@@ -0,0 +1,135 @@
+//
+// Created by Duzhong Chen on 2021/11/20.
+//
+
+#include <algorithm>
+#include <numeric>
+#include "SlotAllocator.h"
+
+namespace jetpack {
+
+    SlotAllocator::SlotAllocator(Sp<UnresolvedNameCollector> reserved):
+    reserved_(std::move(reserved)) {}
+
+    Sp<MinifyNameGenerator> SlotAllocator::RenameInnerScopes(Scope& root) {
+        for (auto child : root.children) {
+            CollectScope(*child);
+        }
+
+        AssignSlots();
+
+        // the most used slot gets the shortest name
+        std::vector<int64_t> weights(slots_count_, 0);
+        for (const auto& binding : bindings_) {
+            weights[binding.slot] += static_cast<int64_t>(binding.var->identifiers.size());
+        }
+
+        std::vector<int32_t> order(slots_count_);
+        std::iota(std::begin(order), std::end(order), 0);
+        std::stable_sort(std::begin(order), std::end(order), [&weights] (int32_t a, int32_t b) {
+            return weights[a] > weights[b];
+        });
+
+        auto generator = MinifyNameGenerator::Make(reserved_);
+        std::vector<std::string> names(slots_count_);
+        for (auto slot : order) {
+            names[slot] = *generator->Next("");
+        }
+
+        for (const auto& sb : scopes_) {
+            std::vector<std::tuple<std::string, std::string>> renames;
+            for (int32_t i = sb.begin; i < sb.end; i++) {
+                const auto& binding = bindings_[i];
+                const auto& new_name = names[binding.slot];
+                if (binding.var->name != new_name) {
+                    renames.emplace_back(binding.var->name, new_name);
+                }
+            }
+            sb.scope->BatchRenameSymbols(renames);
+        }
+
+        return generator;
+    }
+
+    void SlotAllocator::CollectScope(Scope& scope) {
+        std::vector<Variable*> vars;
+        vars.reserve(scope.own_variables.size());
+        for (auto& tuple : scope.own_variables) {
+            if (tuple.second->predefined) {
+                continue;
+            }
+            vars.push_back(tuple.second.get());
+        }
+
+        // own_variables is unordered, sort it to make the result stable
+        std::sort(std::begin(vars), std::end(vars), [] (Variable* a, Variable* b) {
+            if (a->identifiers.size() != b->identifiers.size()) {
+                return a->identifiers.size() > b->identifiers.size();
+            }
+            return a->name < b->name;
+        });
+
+        ScopeBindings sb { &scope, static_cast<int32_t>(bindings_.size()), 0 };
+        for (auto var : vars) {
+            if (var->symbol_id >= static_cast<int32_t>(symbol_to_binding_.size())) {
+                symbol_to_binding_.resize(var->symbol_id + 1, -1);
+            }
+            symbol_to_binding_[var->symbol_id] = static_cast<int32_t>(bindings_.size());
+            bindings_.push_back({ var, -1 });
+        }
+        sb.end = static_cast<int32_t>(bindings_.size());
+        scopes_.push_back(sb);
+
+        for (auto child : scope.children) {
+            CollectScope(*child);
+        }
+    }
+
+    /**
+     * Greedy coloring in preorder.
+     *
+     * When a scope is visited, all the bindings of its ancestors
+     * have been colored. A binding only needs to avoid the slots of
+     * its siblings in the same scope and the outer bindings referenced
+     * through this scope.
+     */
+    void SlotAllocator::AssignSlots() {
+        std::vector<uint8_t> forbidden;
+
+        for (const auto& sb : scopes_) {
+            if (sb.begin == sb.end) {
+                continue;
+            }
+
+            forbidden.assign(slots_count_ + (sb.end - sb.begin), 0);
+            for (auto var : sb.scope->through_variables) {
+                int32_t slot = SlotOf(var);
+                if (slot >= 0) {
+                    forbidden[slot] = 1;
+                }
+            }
+
+            int32_t next = 0;
+            for (int32_t i = sb.begin; i < sb.end; i++) {
+                while (forbidden[next]) {
+                    next++;
+                }
+                bindings_[i].slot = next++;
+            }
+
+            slots_count_ = std::max(slots_count_, next);
+        }
+    }
+
+    int32_t SlotAllocator::SlotOf(Variable* var) {
+        if (var->symbol_id < 0 || var->symbol_id >= static_cast<int32_t>(symbol_to_binding_.size())) {
+            return -1;
+        }
+        int32_t index = symbol_to_binding_[var->symbol_id];
+        if (index < 0) {
+            return -1;
+        }
+        return bindings_[index].slot;
+    }
+
+}
@@ -0,0 +1,78 @@
+//
+// Created by Duzhong Chen on 2021/11/20.
+//
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include "utils/Common.h"
+#include "UniqueNameGenerator.h"
+#include "Scope.h"
+
+namespace jetpack {
+
+    /**
+     * Distribute minified names to all the inner scopes of a module.
+     *
+     * Every binding gets a slot (a color). Two bindings conflict
+     * only if they live in the same scope, or one of them is referenced
+     * inside the scope which declares the other one.
+     * Bindings in sibling scopes never conflict, so they share the
+     * same short names.
+     *
+     * Slots are sorted by the count of references, the most used
+     * slot gets the shortest name.
+     */
+    class SlotAllocator {
+    public:
+        /**
+         * @param reserved names which can not be used, e.g. the free variables. nullable
+         */
+        explicit SlotAllocator(Sp<UnresolvedNameCollector> reserved);
+
+        /**
+         * Rename all the variables in the descendants of the root scope,
+         * variables of the root scope itself are not touched.
+         *
+         * @return the generator used, new names of the root scope should be generated after it
+         */
+        Sp<MinifyNameGenerator> RenameInnerScopes(Scope& root);
+
+    private:
+        struct Binding {
+        public:
+            Variable* var;
+            int32_t   slot;
+
+        };
+
+        struct ScopeBindings {
+        public:
+            Scope*          scope;
+            int32_t         begin;
+            int32_t         end;
+
+        };
+
+        void CollectScope(Scope& scope);
+
+        void AssignSlots();
+
+        int32_t SlotOf(Variable* var);
+
+        Sp<UnresolvedNameCollector> reserved_;
+
+        std::vector<Binding> bindings_;
+
+        // in preorder, parent scopes are always before children
+        std::vector<ScopeBindings> scopes_;
+
+        // symbol id -> index of bindings_, -1 if not collected
+        std::vector<int32_t> symbol_to_binding_;
+
+        int32_t slots_count_ = 0;
+
+    };
+
+}
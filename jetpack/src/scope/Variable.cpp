@@ -7,4 +7,9 @@
 
 namespace jetpack {
 
+    void Variable::AddIdentifier(Identifier* id) {
+        id->var = this;
+        identifiers.push_back(id);
+    }
+
 }
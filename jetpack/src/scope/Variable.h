@@ -38,6 +38,11 @@ namespace jetpack {
         bool    predefined = false;
         Scope*  scope = nullptr;
 
+        /**
+         * Unique in the module, allocated by AstContext.
+         */
+        int32_t symbol_id = -1;
+
         std::string name;
 
         /**
@@ -47,6 +52,12 @@ namespace jetpack {
 
         std::vector<Identifier*> identifiers;
 
+        /**
+         * Bind the identifier to this variable,
+         * the identifier reads the name of the variable after renaming.
+         */
+        void AddIdentifier(Identifier* id);
+
     };
 
 }
@@ -0,0 +1,192 @@
+//
+// Created by Duzhong Chen on 2026/10/19.
+//
+
+#include <filesystem.hpp>
+#include "InputSourceMap.h"
+#include "utils/Common.h"
+#include "utils/JetJSON.h"
+
+namespace jetpack {
+
+    static constexpr std::string_view SOURCE_MAPPING_URL = "sourceMappingURL=";
+    static constexpr std::string_view BASE64_DATA = ";base64,";
+
+    static inline bool IsWhiteSpace(char ch) {
+        return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+    }
+
+    static int Base64Value(char ch) {
+        if (ch >= 'A' && ch <= 'Z') {
+            return ch - 'A';
+        }
+        if (ch >= 'a' && ch <= 'z') {
+            return ch - 'a' + 26;
+        }
+        if (ch >= '0' && ch <= '9') {
+            return ch - '0' + 52;
+        }
+        if (ch == '+' || ch == '-') {
+            return 62;
+        }
+        if (ch == '/' || ch == '_') {
+            return 63;
+        }
+        return -1;
+    }
+
+    /**
+     * The sources are relative to the map, and the sourceRoot.
+     * The urls are kept.
+     */
+    static std::string ResolveSourcePath(const std::string& map_dir,
+                                         const std::string& source_root,
+                                         const std::string& source) {
+        std::string full = source;
+        if (!source_root.empty()) {
+            full = source_root.back() == '/' ? source_root + source : source_root + "/" + source;
+        }
+        if (full.find("://") != std::string::npos) {
+            return full;
+        }
+        ghc::filesystem::path path(full);
+        if (!path.is_absolute()) {
+            path = ghc::filesystem::path(map_dir) / path;
+        }
+        return path.lexically_normal().generic_string();
+    }
+
+    std::optional<std::string_view> InputSourceMap::FindURL(std::string_view source) {
+        auto pos = source.rfind(SOURCE_MAPPING_URL);
+        if (pos == std::string_view::npos || pos < 4) {
+            return std::nullopt;
+        }
+
+        // "//# ", "//@ " or "/*# "
+        auto lead = source.substr(pos - 4, 4);
+        if (lead[0] != '/' || (lead[1] != '/' && lead[1] != '*') ||
+            (lead[2] != '#' && lead[2] != '@') || lead[3] != ' ') {
+            return std::nullopt;
+        }
+
+        std::size_t begin = pos + SOURCE_MAPPING_URL.size();
+        std::size_t end = begin;
+        while (end < source.size() && !IsWhiteSpace(source[end]) && source[end] != '*') {
+            end++;
+        }
+        if (end == begin) {
+            return std::nullopt;
+        }
+
+        // only the comment after the code counts
+        std::size_t rest = end;
+        if (lead[1] == '*') {
+            rest = source.find("*/", end);
+            if (rest == std::string_view::npos) {
+                return std::nullopt;
+            }
+            rest += 2;
+        }
+        for (; rest < source.size(); rest++) {
+            if (!IsWhiteSpace(source[rest])) {
+                return std::nullopt;
+            }
+        }
+
+        return source.substr(begin, end - begin);
+    }
+
+    std::optional<std::string> InputSourceMap::DecodeDataURL(std::string_view url) {
+        if (url.substr(0, 5) != "data:") {
+            return std::nullopt;
+        }
+        auto pos = url.find(BASE64_DATA);
+        if (pos == std::string_view::npos) {
+            return std::nullopt;
+        }
+
+        std::string result;
+        result.reserve((url.size() - pos) * 3 / 4);
+        uint32_t bits = 0;
+        int32_t bits_count = 0;
+        for (char ch : url.substr(pos + BASE64_DATA.size())) {
+            if (ch == '=') {
+                break;
+            }
+            int value = Base64Value(ch);
+            if (value < 0) {
+                return std::nullopt;
+            }
+            bits = (bits << 6) | static_cast<uint32_t>(value);
+            bits_count += 6;
+            if (bits_count >= 8) {
+                bits_count -= 8;
+                result.push_back(static_cast<char>((bits >> bits_count) & 0xFF));
+            }
+        }
+        return result;
+    }
+
+    bool InputSourceMap::Parse(std::string_view content, const std::string& map_dir) {
+        // the index maps have no mappings, they are not supported
+        SourceMapDecoder decoder(content, true);
+        decoded = decoder.Decode();
+        if (decoder.Failed()) {
+            return false;
+        }
+
+        for (const auto& source : decoded.sources) {
+            sources.push_back(EscapeJSONString(ResolveSourcePath(map_dir, decoded.source_root, source)));
+        }
+        decoded.sources_content.resize(sources.size());
+
+        for (const auto& mapping : decoded.content) {
+            if (mapping.source_index == SourceMapDecoder::ResultMapping::NoSource) {
+                continue;
+            }
+            if (mapping.source_index >= sources.size() ||
+                mapping.name_index >= static_cast<int32_t>(decoded.names.size())) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void InputSourceMap::Compose(CodeGenFragment& fragment, int32_t file_id, int32_t sources_base) const {
+        // the names of the input map are interned in the fragment too
+        HashMap<std::string, int32_t> name_indexes;
+        for (std::size_t i = 0; i < fragment.names.size(); i++) {
+            name_indexes[fragment.names[i]] = static_cast<int32_t>(i);
+        }
+
+        for (auto& item : fragment.mapping_items) {
+            if (item.file_id != file_id) {
+                continue;
+            }
+            auto mapping = decoded.Find(item.origin_line, item.origin_column);
+            if (mapping == nullptr) {
+                // generated by the compiler
+                item.file_id = -1;
+                continue;
+            }
+
+            item.file_id = sources_base + static_cast<int32_t>(mapping->source_index);
+            item.origin_line = mapping->before_line;
+            item.origin_column = mapping->before_column;
+
+            if (mapping->name_index >= 0) {
+                const auto& name = decoded.names[mapping->name_index];
+                auto iter = name_indexes.find(name);
+                if (iter != name_indexes.end()) {
+                    item.name_index = iter->second;
+                } else {
+                    item.name_index = static_cast<int32_t>(fragment.names.size());
+                    fragment.names.push_back(name);
+                    name_indexes[name] = item.name_index;
+                }
+            }
+        }
+    }
+
+}
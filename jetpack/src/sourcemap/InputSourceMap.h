@@ -0,0 +1,56 @@
+//
+// Created by Duzhong Chen on 2026/10/19.
+//
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "SourceMapDecoder.h"
+#include "CodeGenFragment.h"
+
+namespace jetpack {
+
+    /**
+     * The sourcemap of a module compiled by another tool (tsc, babel).
+     * The mappings of the module are composed with it,
+     * so they point to the original sources.
+     */
+    class InputSourceMap {
+    public:
+        /**
+         * The url of the `//# sourceMappingURL=` comment at the end of the source.
+         */
+        static std::optional<std::string_view> FindURL(std::string_view source);
+
+        /**
+         * Decode the json of a `data:application/json;base64,` url.
+         */
+        static std::optional<std::string> DecodeDataURL(std::string_view url);
+
+        /**
+         * @param map_dir the directory of the map, the sources are relative to it
+         * @return false if it's not a valid sourcemap
+         */
+        bool Parse(std::string_view content, const std::string& map_dir);
+
+        /**
+         * Point the mappings of the module to the original sources,
+         * the ones not covered by the map are dropped.
+         */
+        void Compose(CodeGenFragment& fragment, int32_t file_id, int32_t sources_base) const;
+
+        // escaped, relative to the working dir
+        std::vector<std::string> sources;
+
+        /**
+         * With the names and the sourcesContent,
+         * the content is written as null if it's not provided.
+         */
+        SourceMapDecoder::Result decoded;
+
+    };
+
+}
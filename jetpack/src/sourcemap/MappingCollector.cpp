@@ -7,8 +7,22 @@
 namespace jetpack {
 
     void MappingCollector::AddMapping(const std::string &name, const SourceLocation &origin, int32_t column) {
-        MappingItem item(name, origin, dist_line_, column);
-        codegen_fragment_.mapping_items.push_back(std::move(item));
+        if (lines_only_) {
+            AddMapping(origin, column);
+            return;
+        }
+
+        auto& names = codegen_fragment_.names;
+        auto iter = name_indexes_.find(name);
+        int32_t name_index;
+        if (iter != name_indexes_.end()) {
+            name_index = iter->second;
+        } else {
+            name_index = static_cast<int32_t>(names.size());
+            names.push_back(name);
+            name_indexes_[name] = name_index;
+        }
+        codegen_fragment_.mapping_items.emplace_back(origin, dist_line_, column, name_index);
     }
 
 }
@@ -24,8 +24,8 @@ namespace jetpack {
 
     class MappingCollector {
     public:
-        MappingCollector(CodeGenFragment& codegen_fragment):
-        codegen_fragment_(codegen_fragment) {}
+        MappingCollector(CodeGenFragment& codegen_fragment, bool lines_only = false):
+        codegen_fragment_(codegen_fragment), lines_only_(lines_only) {}
 
         inline void push_back(const MappingItem& item) {
             codegen_fragment_.mapping_items.push_back(item);
@@ -39,6 +39,19 @@ namespace jetpack {
             dist_line_++;
         }
 
+        inline void AddMapping(const SourceLocation& origin, int32_t column) {
+            if (lines_only_) {
+                if (mapped_line_ == dist_line_ || origin.fileId < 0) {
+                    return;
+                }
+                mapped_line_ = dist_line_;
+            }
+            codegen_fragment_.mapping_items.emplace_back(origin, dist_line_, column);
+        }
+
+        /**
+         * The name is interned in the fragment.
+         */
         void AddMapping(const std::string& name, const SourceLocation& origin, int32_t column);
 
         friend class SourceMapGenerator;
@@ -47,6 +60,11 @@ namespace jetpack {
     private:
         int32_t          dist_line_ = 1;
         CodeGenFragment& codegen_fragment_;
+        HashMap<std::string, int32_t> name_indexes_;
+
+        // at most one mapping for a line
+        bool             lines_only_ = false;
+        int32_t          mapped_line_ = 0;
 
     };
 
@@ -2,79 +2,445 @@
 // Created by Duzhong Chen on 2021/3/30.
 //
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <fmt/format.h>
 #include "SourceMapDecoder.h"
 #include "utils/Common.h"
-#include "SourceMapGenerator.h"
+#include "utils/JetJSON.h"
 
 namespace jetpack {
 
-    void SourceMapDecoder::DumpBufferToResult(uint32_t line, const std::string& buffer, SourceMapDecoder::Result& result) {
-        if (unlikely(buffer.empty())) {
-            return;
-        }
-
-        const char* str = buffer.c_str();
-        l_after_column_ += SourceMapGenerator::VLQToInt(str, str);
-        l_source_index_ += SourceMapGenerator::VLQToInt(str, str);
-        l_before_line_ += SourceMapGenerator::VLQToInt(str, str);
-        l_before_column_ += SourceMapGenerator::VLQToInt(str, str);
-//        int names_index = -1;
-//        if (str < buffer.c_str() + buffer.size()) {
-//            names_index = SourceMapGenerator::VLQToInt(str, str);
-//        }
-
-        SourceMapDecoder::ResultMapping mapping {
-            static_cast<uint32_t>(l_source_index_),
-            l_before_line_,
-            l_before_column_,
-            static_cast<int32_t>(line),
-            l_after_column_,
-        };
-        result.content.push_back(mapping);
+    static constexpr std::array<int8_t, 256> MakeBase64Values() {
+        std::array<int8_t, 256> table{};
+        for (auto& value : table) {
+            value = -1;
+        }
+        const char* chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int i = 0; i < 64; i++) {
+            table[static_cast<unsigned char>(chars[i])] = static_cast<int8_t>(i);
+        }
+        return table;
+    }
+
+    // -1 for the chars out of the base64, including the separators
+    static constexpr std::array<int8_t, 256> Base64Values = MakeBase64Values();
+
+    static inline bool DecodeVLQ(const char*& p, const char* end, int32_t& value) {
+        uint32_t result = 0;
+        uint32_t shift = 0;
+        while (p < end) {
+            int32_t digit = Base64Values[static_cast<unsigned char>(*p)];
+            if (unlikely(digit < 0)) {
+                return false;
+            }
+            p++;
+            if (likely(shift < 32)) {
+                result |= static_cast<uint32_t>(digit & 0b11111) << shift;
+            }
+            shift += 5;
+            if ((digit & 0b100000) == 0) {
+                int32_t magnitude = static_cast<int32_t>(result >> 1);
+                value = (result & 1) ? -magnitude : magnitude;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static inline void SkipWhiteSpace(const char*& p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+            p++;
+        }
+    }
+
+    /**
+     * The content between the quotes, still escaped.
+     */
+    static bool ReadRawString(const char*& p, const char* end, std::string_view& raw) {
+        if (p == end || *p != '"') {
+            return false;
+        }
+        const char* begin = ++p;
+        while (p < end) {
+            auto quote = static_cast<const char*>(std::memchr(p, '"', end - p));
+            if (quote == nullptr) {
+                return false;
+            }
+            // escaped by an odd count of backslashes
+            const char* back = quote;
+            while (back > begin && back[-1] == '\\') {
+                back--;
+            }
+            p = quote + 1;
+            if (((quote - back) & 1) == 0) {
+                raw = std::string_view(begin, quote - begin);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool ReadString(const char*& p, const char* end, std::string& out) {
+        std::string_view raw;
+        if (!ReadRawString(p, end, raw)) {
+            return false;
+        }
+        if (raw.find('\\') == std::string_view::npos) {
+            out.assign(raw.data(), raw.size());
+            return true;
+        }
+        return UnescapeJSONString(raw, out);
+    }
+
+    static bool SkipValue(const char*& p, const char* end) {
+        if (p == end) {
+            return false;
+        }
+        std::string_view raw;
+        if (*p == '"') {
+            return ReadRawString(p, end, raw);
+        }
+        if (*p == '{' || *p == '[') {
+            int32_t depth = 0;
+            while (p < end) {
+                switch (*p) {
+                    case '"':
+                        if (!ReadRawString(p, end, raw)) {
+                            return false;
+                        }
+                        continue;
+
+                    case '{':
+                    case '[':
+                        depth++;
+                        break;
+
+                    case '}':
+                    case ']':
+                        if (--depth == 0) {
+                            p++;
+                            return true;
+                        }
+                        break;
+
+                    default:
+                        break;
+
+                }
+                p++;
+            }
+            return false;
+        }
+        // numbers, true, false and null
+        while (p < end && *p != ',' && *p != '}' && *p != ']' &&
+               *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') {
+            p++;
+        }
+        return true;
+    }
+
+    /**
+     * An array of strings, the other values are nullopt.
+     */
+    template <typename Fn>
+    static bool ReadStringArray(const char*& p, const char* end, Fn&& fn) {
+        if (p == end || *p != '[') {
+            return SkipValue(p, end);
+        }
+        p++;
+        SkipWhiteSpace(p, end);
+        if (p < end && *p == ']') {
+            p++;
+            return true;
+        }
+        while (p < end) {
+            SkipWhiteSpace(p, end);
+            if (p < end && *p == '"') {
+                std::string str;
+                if (!ReadString(p, end, str)) {
+                    return false;
+                }
+                fn(std::optional<std::string>(std::move(str)));
+            } else {
+                if (!SkipValue(p, end)) {
+                    return false;
+                }
+                fn(std::optional<std::string>());
+            }
+            SkipWhiteSpace(p, end);
+            if (p < end && *p == ',') {
+                p++;
+                continue;
+            }
+            if (p < end && *p == ']') {
+                p++;
+                return true;
+            }
+            return false;
+        }
+        return false;
     }
 
     std::string SourceMapDecoder::ResultMapping::ToString() const {
-        return fmt::format("fileIndex: {} before: {}:{} after: {}:{}", source_index,
+        return fmt::format("fileIndex: {} before: {}:{} after: {}:{} name: {}", source_index,
                            before_line, before_column,
-                           after_line, after_column);
+                           after_line, after_column, name_index);
     }
 
     SourceMapDecoder::Result
     SourceMapDecoder::Decode() {
         Result result;
-        auto mappings = sourcemap_json["mappings"].get<std::string>();
+        failed_ = false;
 
-        uint32_t line_counter = 1;
+        std::string_view mappings;
+        std::string unescaped_mappings;
+        if (sourcemap_json_ != nullptr) {
+            auto& j = *sourcemap_json_;
+            if (!j.contains("mappings") || !j["mappings"].is_string()) {
+                failed_ = true;
+                return result;
+            }
+            mappings = j["mappings"].get_ref<const std::string&>();
+            if (j.contains("sourceRoot") && j["sourceRoot"].is_string()) {
+                result.source_root = j["sourceRoot"].get<std::string>();
+            }
+            if (j.contains("sources") && j["sources"].is_array()) {
+                for (const auto& source : j["sources"]) {
+                    result.sources.push_back(source.is_string() ? source.get<std::string>() : "");
+                }
+            }
+            if (j.contains("names") && j["names"].is_array()) {
+                for (const auto& name : j["names"]) {
+                    result.names.push_back(name.is_string() ? name.get<std::string>() : "");
+                }
+            }
+            if (with_sources_content_ && j.contains("sourcesContent") && j["sourcesContent"].is_array()) {
+                for (const auto& content : j["sourcesContent"]) {
+                    result.sources_content.push_back(
+                            content.is_string() ? std::optional(content.get<std::string>()) : std::nullopt);
+                }
+            }
+        } else {
+            if (!ScanJSON(result, mappings)) {
+                failed_ = true;
+                return result;
+            }
+            // "\/" is allowed by the JSON
+            if (mappings.find('\\') != std::string_view::npos) {
+                if (!UnescapeJSONString(mappings, unescaped_mappings)) {
+                    failed_ = true;
+                    return result;
+                }
+                mappings = unescaped_mappings;
+            }
+        }
 
-        std::string buffer;
+        if (!DecodeMappings(mappings, result)) {
+            failed_ = true;
+        }
 
-        for (char ch : mappings) {
-            switch (ch) {
-                case ',':
-                    DumpBufferToResult(line_counter, buffer, result);
-                    buffer.clear();
-                    break;
+        return result;
+    }
 
-                case ';':
-                    DumpBufferToResult(line_counter, buffer, result);
-                    line_counter++;
-                    l_after_column_ = 0;
-                    buffer.clear();
-                    break;
+    bool SourceMapDecoder::ScanJSON(Result& result, std::string_view& mappings) {
+        const char* p = content_.data();
+        const char* end = p + content_.size();
+
+        SkipWhiteSpace(p, end);
+        if (p == end || *p != '{') {
+            return false;
+        }
+        p++;
+
+        bool has_mappings = false;
+        while (true) {
+            SkipWhiteSpace(p, end);
+            if (p < end && *p == '}') {
+                break;
+            }
+
+            std::string_view key;
+            if (!ReadRawString(p, end, key)) {
+                return false;
+            }
+            SkipWhiteSpace(p, end);
+            if (p == end || *p != ':') {
+                return false;
+            }
+            p++;
+            SkipWhiteSpace(p, end);
+
+            bool ok;
+            if (key == "mappings") {
+                ok = ReadRawString(p, end, mappings);
+                has_mappings = true;
+            } else if (key == "sources") {
+                ok = ReadStringArray(p, end, [&result](std::optional<std::string> source) {
+                    result.sources.push_back(source.has_value() ? std::move(*source) : "");
+                });
+            } else if (key == "names") {
+                ok = ReadStringArray(p, end, [&result](std::optional<std::string> name) {
+                    result.names.push_back(name.has_value() ? std::move(*name) : "");
+                });
+            } else if (key == "sourceRoot" && p < end && *p == '"') {
+                ok = ReadString(p, end, result.source_root);
+            } else if (key == "sourcesContent" && with_sources_content_) {
+                ok = ReadStringArray(p, end, [&result](std::optional<std::string> content) {
+                    result.sources_content.push_back(std::move(content));
+                });
+            } else {
+                // the sourcesContent is the most of the file, it's skipped fast
+                ok = SkipValue(p, end);
+            }
+            if (!ok) {
+                return false;
+            }
+
+            SkipWhiteSpace(p, end);
+            if (p < end && *p == ',') {
+                p++;
+                continue;
+            }
+            if (p < end && *p == '}') {
+                break;
+            }
+            return false;
+        }
+
+        return has_mappings;
+    }
+
+    bool SourceMapDecoder::DecodeMappings(std::string_view mappings, Result& result) {
+        const char* p = mappings.data();
+        const char* end = p + mappings.size();
 
-                default:
-                    buffer.push_back(ch);
+        // about a mapping a separator
+        result.content.reserve(std::count(p, end, ',') + std::count(p, end, ';') + 1);
+        result.line_offsets.push_back(0);
+
+        int32_t after_line = 1;
+        int32_t after_column = 0;
+        int32_t source_index = 0;
+        int32_t before_line = 1;
+        int32_t before_column = 0;
+        int32_t name_index = 0;
+        bool sorted = true;
+
+        // the segments of a line are expected to be ordered by the column
+        auto end_line = [&result, &sorted] {
+            if (!sorted) {
+                auto begin = result.content.begin() + result.line_offsets.back();
+                std::stable_sort(begin, result.content.end(), [](const ResultMapping& lhs, const ResultMapping& rhs) {
+                    return lhs.after_column < rhs.after_column;
+                });
+                sorted = true;
+            }
+            result.line_offsets.push_back(result.content.size());
+        };
+
+        bool ok = true;
+        while (p < end) {
+            if (*p == ';') {
+                end_line();
+                after_line++;
+                after_column = 0;
+                p++;
+                continue;
+            }
+            if (*p == ',') {
+                p++;
+                continue;
+            }
+
+            int32_t fields[5];
+            int32_t count = 0;
+            while (p < end && *p != ',' && *p != ';') {
+                if (count == 5 || !DecodeVLQ(p, end, fields[count])) {
+                    ok = false;
                     break;
+                }
+                count++;
+            }
+            if (!ok || count == 2 || count == 3) {
+                ok = false;
+                break;
+            }
+
+            if (fields[0] < 0) {
+                sorted = false;
+            }
+            after_column += fields[0];
+            if (count == 1) {
+                result.content.push_back({
+                    ResultMapping::NoSource,
+                    0, 0,
+                    after_line,
+                    after_column,
+                });
+                continue;
+            }
 
+            source_index += fields[1];
+            before_line += fields[2];
+            before_column += fields[3];
+            int32_t name = -1;
+            if (count == 5) {
+                name_index += fields[4];
+                name = name_index;
             }
+            result.content.push_back({
+                static_cast<uint32_t>(source_index),
+                before_line,
+                before_column,
+                after_line,
+                after_column,
+                name,
+            });
         }
 
-        if (!buffer.empty()) {
-            DumpBufferToResult(line_counter, buffer, result);
+        end_line();
+        return ok;
+    }
+
+    const SourceMapDecoder::ResultMapping* SourceMapDecoder::Result::Find(int32_t after_line, int32_t after_column) const {
+        if (after_line < 1 || after_line + 1 > static_cast<int32_t>(line_offsets.size())) {
+            return nullptr;
         }
+        auto begin = content.begin() + line_offsets[after_line - 1];
+        auto end = content.begin() + line_offsets[after_line];
 
-        return result;
+        auto iter = std::upper_bound(begin, end, after_column, [](int32_t column, const ResultMapping& mapping) {
+            return column < mapping.after_column;
+        });
+        if (iter == begin) {
+            return nullptr;
+        }
+        --iter;
+        if (iter->source_index == ResultMapping::NoSource) {
+            return nullptr;
+        }
+        return &(*iter);
+    }
+
+    std::optional<SourceMapDecoder::OriginalPosition>
+    SourceMapDecoder::Result::OriginalPositionFor(int32_t line, int32_t column) const {
+        auto mapping = Find(line, column);
+        if (mapping == nullptr || mapping->source_index >= sources.size()) {
+            return std::nullopt;
+        }
+
+        OriginalPosition position {
+            sources[mapping->source_index],
+            mapping->before_line,
+            mapping->before_column,
+            std::string_view(),
+        };
+        if (mapping->name_index >= 0 && mapping->name_index < static_cast<int32_t>(names.size())) {
+            position.name = names[mapping->name_index];
+        }
+        return position;
     }
 
 }
@@ -5,6 +5,8 @@
 #pragma once
 
 #include <nlohmann/json.hpp>
+#include <optional>
+#include <string_view>
 #include <vector>
 
 namespace jetpack {
@@ -13,38 +15,104 @@ namespace jetpack {
     public:
         struct ResultMapping {
         public:
+            // a segment of only the generated column
+            static constexpr uint32_t NoSource = UINT32_MAX;
+
             uint32_t source_index;
             int32_t  before_line;
             int32_t  before_column;
             int32_t  after_line;
             int32_t  after_column;
+            int32_t  name_index = -1;
 
             [[nodiscard]]
             std::string ToString() const;
 
         };
 
+        /**
+         * The lines are 1-based, the columns are 0-based.
+         * The views point into the Result.
+         */
+        struct OriginalPosition {
+        public:
+            std::string_view source;
+            int32_t          line;
+            int32_t          column;
+
+            // empty if there is no name
+            std::string_view name;
+
+        };
+
         struct Result {
         public:
             std::vector<ResultMapping> content;
 
+            /**
+             * The mappings of the line N (1-based) are
+             * content[line_offsets[N - 1]] until content[line_offsets[N]].
+             */
+            std::vector<uint32_t> line_offsets;
+
+            std::string source_root;
+            std::vector<std::string> sources;
+
+            // only decoded if it's asked, nullopt for null
+            std::vector<std::optional<std::string>> sources_content;
+
+            std::vector<std::string> names;
+
+            /**
+             * The last mapping at or before the position of the generated code,
+             * on the same line. nullptr if it's not mapped.
+             */
+            [[nodiscard]]
+            const ResultMapping* Find(int32_t after_line, int32_t after_column) const;
+
+            /**
+             * Binary search in the line, for the symbolication of the stack traces.
+             */
+            [[nodiscard]]
+            std::optional<OriginalPosition> OriginalPositionFor(int32_t line, int32_t column) const;
+
         };
 
-        inline explicit SourceMapDecoder(nlohmann::json& j) noexcept : sourcemap_json(j) {}
+        inline explicit SourceMapDecoder(nlohmann::json& j) noexcept : sourcemap_json_(&j) {}
+
+        /**
+         * Scan the text of the sourcemap without building the JSON DOM,
+         * the mappings are decoded in place.
+         * The sourcesContent is skipped unless it's asked.
+         */
+        inline explicit SourceMapDecoder(std::string_view content, bool sources_content = false) noexcept :
+        content_(content), with_sources_content_(sources_content) {}
 
         Result Decode();
 
+        /**
+         * If the last Decode() met a malformed sourcemap,
+         * the result is incomplete.
+         */
+        [[nodiscard]]
+        inline bool Failed() const {
+            return failed_;
+        }
+
         ~SourceMapDecoder() noexcept = default;
 
     private:
-        nlohmann::json& sourcemap_json;
+        nlohmann::json* sourcemap_json_ = nullptr;
+        std::string_view content_;
+        bool with_sources_content_ = false;
+        bool failed_ = false;
 
-        int l_after_column_ = 0;
-        int l_source_index_ = 0;
-        int l_before_line_ = 1;
-        int l_before_column_ = 0;
+        /**
+         * Read the top level fields, the mappings are returned as a view.
+         */
+        bool ScanJSON(Result& result, std::string_view& mappings);
 
-        void DumpBufferToResult(uint32_t line, const std::string& buffer, SourceMapDecoder::Result& result);
+        bool DecodeMappings(std::string_view mappings, Result& result);
 
     };
 
@@ -12,6 +12,11 @@
 
 #define IntToVLQBufferSize 8
 
+// the encoded mappings are written in blocks of it
+#define MAPPINGS_BUFFER_SIZE (64 * 1024)
+
+#define SW(NEW, OLD) ((NEW) - (OLD))
+
 namespace jetpack {
     using std::memset;
 
@@ -26,37 +31,27 @@ namespace jetpack {
 
     static std::once_flag back_encoding_init_;
 
-    static int Base64BackEncodingTable[127];
+    static int Base64BackEncodingTable[128];
 
     inline char IntToBase64(int code) {
         J_ASSERT(code >= 0 && code <= 0b111111);
         return Base64EncodingTable[code];
     }
 
-    void SourceMapGenerator::IntToVLQ(io::Writer& writer, int code) {
-        int buffer[IntToVLQBufferSize];
-
+    int SourceMapGenerator::IntToVLQ(char* buffer, int code) {
         int s1 = code < 0 ? (-code << 1) | 1 : code << 1;
         int counter = 0;
-        if (s1 > 0b11111) {
-            memset(buffer, 0, IntToVLQBufferSize * sizeof(int));
-            while (s1 > 0b11111) {
-                buffer[counter++] = s1 & 0b11111;
-                s1 >>= 5;
-            }
-            buffer[counter++] = s1;
-
-            for (int i = 0; i < counter; i++) {
-                if (i != counter - 1) {
-                    buffer[i] |= 0b100000;
-                }
-                char ch = IntToBase64(buffer[i]);
-                writer.WriteByte(ch);
-            }
-        } else {
-            char ch = IntToBase64(s1);
-            writer.WriteByte(ch);
+        while (s1 > 0b11111) {
+            buffer[counter++] = IntToBase64((s1 & 0b11111) | 0b100000);
+            s1 >>= 5;
         }
+        buffer[counter++] = IntToBase64(s1);
+        return counter;
+    }
+
+    void SourceMapGenerator::IntToVLQ(io::Writer& writer, int code) {
+        char buffer[IntToVLQBufferSize];
+        writer.Write(buffer, IntToVLQ(buffer, code));
     }
 
     int SourceMapGenerator::VLQToInt(const char* str, const char*& next) {
@@ -70,42 +65,49 @@ namespace jetpack {
             }
         });
 
-        uint32_t len = 0;
-        int result = 0;
-
-        std::vector<int> buffer;
+        const char* p = str;
+        uint32_t result = 0;
+        uint32_t shift = 0;
 
-        int factor = (str[0] & 1) ? 1 : -1;
-
-        while (str[len] != '\0') {
-            char ch = str[len++];
-            J_ASSERT(ch < 127);
-            int intValue = Base64BackEncodingTable[ch];
+        // little endian groups of 5 bits, the 6th bit is the continuation
+        while (*p != '\0') {
+            // the input maps are not trusted, a bad char is read as 0
+            int intValue = Base64BackEncodingTable[static_cast<unsigned char>(*p++) & 0x7F];
+            if (shift < 32) {
+                result |= static_cast<uint32_t>(intValue & 0b11111) << shift;
+            }
+            shift += 5;
             if ((intValue & 0b100000) == 0) {  // has no next
-                buffer.push_back(intValue & 0b11111);
                 break;
             }
-            buffer.push_back(intValue & 0b11111);
         }
 
-        for (int32_t i = buffer.size() - 1; i >= 0; i--) {
-            result = result << 5 | buffer[i];
-        }
+        next = p;
 
-        next = str + len;
+        // the sign is the lowest bit of the value, not of the char
+        int magnitude = static_cast<int>(result >> 1);
+        return (result & 1) ? -magnitude : magnitude;
+    }
 
-        return (result >> 1) * factor;
+    void SourceMapGenerator::GenerateVLQStr(std::string& out, int transformed_column,
+                                            int file_index, int before_line, int before_column) {
+        char buffer[IntToVLQBufferSize * 4];
+        int len = IntToVLQ(buffer, transformed_column);
+        len += IntToVLQ(buffer + len, file_index);
+        len += IntToVLQ(buffer + len, before_line);
+        len += IntToVLQ(buffer + len, before_column);
+        out.append(buffer, len);
     }
 
-    void SourceMapGenerator::GenerateVLQStr(io::Writer& writer, int transformed_column,
-                                            int file_index, int before_line, int before_column, int var_index) {
-        IntToVLQ(writer, transformed_column);
-        IntToVLQ(writer, file_index);
-        IntToVLQ(writer, before_line);
-        IntToVLQ(writer, before_column);
-        if (var_index >= 0) {
-            IntToVLQ(writer, var_index);
-        }
+    void SourceMapGenerator::GenerateVLQStr(std::string& out, int transformed_column,
+                                            int file_index, int before_line, int before_column, int name_index) {
+        char buffer[IntToVLQBufferSize * 5];
+        int len = IntToVLQ(buffer, transformed_column);
+        len += IntToVLQ(buffer + len, file_index);
+        len += IntToVLQ(buffer + len, before_line);
+        len += IntToVLQ(buffer + len, before_column);
+        len += IntToVLQ(buffer + len, name_index);
+        out.append(buffer, len);
     }
 
 //    static constexpr size_t TableSize = sizeof Base64EncodingTable / sizeof(char);
@@ -120,8 +122,6 @@ namespace jetpack {
         writer_.Write("  \"version\": 3,\n");
         writer_.WriteS(fmt::format("  \"file\": \"{}\",\n", EscapeJSONString(filename)));
         writer_.Write("  \"sourceRoot\": \"\",\n");
-        writer_.Write("  \"names\": [],\n");
-//        mappings_.reserve(8 * 1024);
     }
 
 //    int32_t SourceMapGenerator::GetFilenameIndexByModuleId(int32_t module_id) {
@@ -146,15 +146,47 @@ namespace jetpack {
 
     void SourceMapGenerator::WriteSources() {
         FinalizeSources();
-        FinalizeSourcesContent();
+        if (module_resolver_->GetSourcesContent()) {
+            FinalizeSourcesContent();
+        }
+    }
+
+    void SourceMapGenerator::AppendFragment(CodeGenFragment& fragment) {
+        if (!mappings_begun_) {
+            writer_.Write("  \"mappings\": \"");
+            mappings_.reserve(MAPPINGS_BUFFER_SIZE);
+            mappings_begun_ = true;
+        }
+
+        if (!fragment.encoded_mappings.encoded) {
+            EncodeFragment(fragment);
+        }
+        AppendNames(fragment);
+        SpliceFragment(fragment, column_, names_base_);
+
+        if (fragment.line > 1) {
+            column_ = fragment.column;
+        } else {
+            column_ += fragment.column;
+        }
+        names_base_ += static_cast<int32_t>(fragment.names.size());
+
+        // only the encoded state is kept
+        std::string().swap(fragment.encoded_mappings.vlq);
+        std::vector<std::string>().swap(fragment.names);
     }
 
-    void SourceMapGenerator::Finalize(Slice<const MappingItem> mapping_items) {
-        writer_.Write("  \"mappings\": \"");
-        benchmark::BenchMarker mapping_barker(benchmark::BENCH_FINALIZE_SOURCEMAP_2);
-        FinalizeMapping(mapping_items);
-        mapping_barker.Submit();
-        writer_.Write("\"\n");
+    void SourceMapGenerator::Finalize() {
+        if (!mappings_begun_) {
+            writer_.Write("  \"mappings\": \"");
+            mappings_begun_ = true;
+        }
+        FlushMappings();
+        writer_.Write("\",\n");
+
+        writer_.Write("  \"names\": [");
+        writer_.WriteS(names_);
+        writer_.Write("]\n");
         writer_.Write("}");
     }
 
@@ -165,19 +197,29 @@ namespace jetpack {
         }
 
         writer_.Write("  \"sources\": [\n");
-        uint32_t counter = 0;
-        const auto total_size = module_resolver_->modules_table_.ModCount();
-        auto modules = module_resolver_->modules_table_.Modules();
-        for (const auto& module : modules) {
+        bool first = true;
+        auto write_source = [this, &first](const std::string& escaped_path) {
+            if (!first) {
+                writer_.Write(",\n");
+            }
+            first = false;
             writer_.Write("    \"");
-            writer_.WriteS(module->escaped_path);
+            writer_.WriteS(escaped_path);
             writer_.Write("\"");
-            if (counter++ < total_size - 1) {
-                writer_.Write(",");
+        };
+
+        // in the order of sources_base
+        auto modules = module_resolver_->modules_table_.Modules();
+        for (const auto& module : modules) {
+            if (module->input_sourcemap) {
+                for (const auto& source : module->input_sourcemap->sources) {
+                    write_source(source);
+                }
+                continue;
             }
-            writer_.Write("\n");
+            write_source(module->escaped_path);
         }
-        writer_.Write("  ],\n");
+        writer_.Write("\n  ],\n");
     }
 
     void SourceMapGenerator::FinalizeSourcesContent() {
@@ -188,54 +230,205 @@ namespace jetpack {
         }
         writer_.Write("  \"sourcesContent\": [\n");
 
-        uint32_t counter = 0;
-        const auto total_size = module_resolver_->modules_table_.ModCount();
-        for (const auto& module : modules) {
+        bool first = true;
+        auto write_content = [this, &first](std::optional<std::string_view> content) {
+            if (!first) {
+                writer_.Write(",\n");
+            }
+            first = false;
+            if (!content.has_value()) {
+                writer_.Write("    null");
+                return;
+            }
             writer_.Write("    \"");
-            writer_.WriteS(module->escaped_content);
+            EscapeJSONString(*content, writer_);
             writer_.Write("\"");
-            if (counter++ < total_size - 1) {
-                writer_.Write(",");
+        };
+
+        for (const auto& module : modules) {
+            if (module->input_sourcemap) {
+                for (const auto& content : module->input_sourcemap->decoded.sources_content) {
+                    write_content(content.has_value() ? std::optional<std::string_view>(*content) : std::nullopt);
+                }
+                continue;
             }
-            writer_.Write("\n");
+            write_content(module->src_content ? module->src_content->View() : std::string_view());
         }
 
-        writer_.Write("  ],\n");
+        writer_.Write("\n  ],\n");
     }
 
-    void SourceMapGenerator::FinalizeMapping(Slice<const MappingItem> items) {
-        for (const auto& item : items) {
-            AddEnoughLines(item.dist_line);
-            if (last_write_ == LastWriteType::Item) {
-                writer_.WriteByte(',');
-                last_write_ = LastWriteType::None;
-            }
-            bool ec = AddLocation(item.name, item.dist_column,
-                                  item.origin.fileId, item.origin.start.line, item.origin.start.column
-                                  );
-            if (ec) {
-                last_write_ = LastWriteType::Item;
+    void SourceMapGenerator::AppendNames(const CodeGenFragment& fragment) {
+        // not merged between the fragments, the deltas in the fragments are kept
+        for (const auto& name : fragment.names) {
+            if (!names_.empty()) {
+                names_.append(", ");
             }
+            names_.push_back('"');
+            EscapeJSONString(name, names_);
+            names_.push_back('"');
         }
     }
 
-    void SourceMapGenerator::AddEnoughLines(int32_t target_line) {
-        while (line_counter_ < target_line) {
-            l_after_col_ = 0;
-//            l_file_index_ = 0;
-            line_counter_++;
-            EndLine();
+    void SourceMapGenerator::FlushMappings() {
+        writer_.WriteS(mappings_);
+        mappings_.clear();
+    }
+
+    void SourceMapGenerator::EncodeFragment(CodeGenFragment& fragment) {
+        auto& encoded = fragment.encoded_mappings;
+        std::string& out = encoded.vlq;
+
+        // the same initial state as the generator
+        int32_t line = 1;
+        int32_t after_col = 0;
+        int32_t file_index = 0;
+        int32_t before_line = 1;
+        int32_t before_col = 0;
+        int32_t name_index = 0;
+        bool has_segment = false;
+
+        for (const auto& item : fragment.mapping_items) {
+            if (unlikely(item.file_id < 0)) {
+                continue;
+            }
+            while (line < item.dist_line) {
+                out.push_back(';');
+                line++;
+                after_col = 0;
+                has_segment = false;
+            }
+            if (has_segment) {
+                out.push_back(',');
+            }
+
+            std::size_t begin = out.size();
+            if (item.name_index >= 0) {
+                GenerateVLQStr(out,
+                               SW(item.dist_column, after_col),
+                               SW(item.file_id, file_index),
+                               SW(item.origin_line, before_line),
+                               SW(item.origin_column, before_col),
+                               SW(item.name_index, name_index));
+                name_index = item.name_index;
+                encoded.last_name_index = item.name_index;
+                if (!encoded.first_named) {
+                    encoded.first_named = EncodedMappings::Segment { begin, out.size(), item };
+                }
+            } else {
+                GenerateVLQStr(out,
+                               SW(item.dist_column, after_col),
+                               SW(item.file_id, file_index),
+                               SW(item.origin_line, before_line),
+                               SW(item.origin_column, before_col));
+            }
+            if (!encoded.first) {
+                encoded.first = EncodedMappings::Segment { begin, out.size(), item };
+            }
+            encoded.last = item;
+
+            after_col = item.dist_column;
+            file_index = item.file_id;
+            before_line = item.origin_line;
+            before_col = item.origin_column;
+            has_segment = true;
+        }
+
+        // the lines after the last mapping
+        while (line < fragment.line) {
+            out.push_back(';');
+            line++;
         }
+
+        encoded.encoded = true;
+        std::vector<MappingItem>().swap(fragment.mapping_items);
     }
 
-    void SourceMapGenerator::EndLine() {
-        writer_.WriteByte(';');
-        last_write_ = LastWriteType::LineBreak;
+    void SourceMapGenerator::RebaseFragment(CodeGenFragment& fragment, int32_t file_id, int32_t sources_base) {
+        for (auto& item : fragment.mapping_items) {
+            if (item.file_id == file_id) {
+                item.file_id = sources_base;
+            }
+        }
     }
 
-#define SW(NEW, OLD) ((NEW) - (OLD))
+    void SourceMapGenerator::SpliceFragment(const CodeGenFragment& fragment, int32_t column, int32_t names_base) {
+        const auto& encoded = fragment.encoded_mappings;
+        const std::string& vlq = encoded.vlq;
 
-    bool SourceMapGenerator::AddLocation(const std::string& name, int after_col, int file_id, int before_line, int before_col) {
+        if (!encoded.first) {
+            // only the line breaks
+            if (!vlq.empty()) {
+                mappings_.append(vlq);
+                l_after_col_ = 0;
+                last_write_ = LastWriteType::LineBreak;
+            }
+            if (mappings_.size() >= MAPPINGS_BUFFER_SIZE) {
+                FlushMappings();
+            }
+            return;
+        }
+
+        // the line breaks before the first segment
+        const auto& first = *encoded.first;
+        if (first.begin > 0) {
+            mappings_.append(vlq, 0, first.begin);
+            l_after_col_ = 0;
+        } else if (last_write_ == LastWriteType::Item) {
+            mappings_.push_back(',');
+        }
+
+        // relative to the state of the previous fragments
+        const auto& item = first.item;
+        AddLocation(item.name_index >= 0 ? names_base + item.name_index : MappingItem::NoName,
+                    item.dist_column + (item.dist_line == 1 ? column : 0),
+                    item.file_id, item.origin_line, item.origin_column);
+        std::size_t cursor = first.end;
+
+        if (encoded.first_named && encoded.first_named->begin != first.begin) {
+            // the first 4 fields are relative to the fragment itself
+            const auto& named = *encoded.first_named;
+            const char* next = vlq.c_str() + named.begin;
+            for (int i = 0; i < 4; i++) {
+                VLQToInt(next, next);
+            }
+            mappings_.append(vlq, cursor, next - vlq.c_str() - cursor);
+
+            int32_t name_index = names_base + named.item.name_index;
+            char buffer[IntToVLQBufferSize];
+            mappings_.append(buffer, IntToVLQ(buffer, SW(name_index, l_name_index_)));
+            cursor = named.end;
+        }
+
+        if (vlq.size() - cursor >= MAPPINGS_BUFFER_SIZE) {
+            FlushMappings();
+            writer_.Write(vlq.c_str() + cursor, vlq.size() - cursor);
+        } else {
+            mappings_.append(vlq, cursor, std::string::npos);
+        }
+
+        // the state at the end of the fragment
+        const auto& last = encoded.last;
+        l_file_index_ = last.file_id;
+        l_before_line_ = last.origin_line;
+        l_before_col_ = last.origin_column;
+        if (encoded.last_name_index >= 0) {
+            l_name_index_ = names_base + encoded.last_name_index;
+        }
+        if (last.dist_line == fragment.line) {
+            l_after_col_ = last.dist_column + (last.dist_line == 1 ? column : 0);
+            last_write_ = LastWriteType::Item;
+        } else {
+            l_after_col_ = 0;
+            last_write_ = LastWriteType::LineBreak;
+        }
+
+        if (mappings_.size() >= MAPPINGS_BUFFER_SIZE) {
+            FlushMappings();
+        }
+    }
+
+    bool SourceMapGenerator::AddLocation(int name_index, int after_col, int file_id, int before_line, int before_col) {
         if (unlikely(file_id < 0)) {
 //            J_ASSERT(fileId != -1);
             return false;
@@ -245,12 +438,21 @@ namespace jetpack {
 //        if (unlikely(filename_index < 0)) {
 //            return false;
 //        }
-        GenerateVLQStr(writer_,
-                       SW(after_col, l_after_col_),
-                       SW(file_id, l_file_index_),
-                       SW(before_line, l_before_line_),
-                       SW(before_col, l_before_col_),
-                       -1);
+        if (name_index >= 0) {
+            GenerateVLQStr(mappings_,
+                           SW(after_col, l_after_col_),
+                           SW(file_id, l_file_index_),
+                           SW(before_line, l_before_line_),
+                           SW(before_col, l_before_col_),
+                           SW(name_index, l_name_index_));
+            l_name_index_ = name_index;
+        } else {
+            GenerateVLQStr(mappings_,
+                           SW(after_col, l_after_col_),
+                           SW(file_id, l_file_index_),
+                           SW(before_line, l_before_line_),
+                           SW(before_col, l_before_col_));
+        }
         l_after_col_ = after_col;
         l_file_index_ = file_id;
         l_before_line_ = before_line;
@@ -29,8 +29,18 @@ namespace jetpack {
             LineBreak,
         };
 
-        static void GenerateVLQStr(io::Writer& writer, int transformed_column, int file_index, int before_line, int before_column, int var_index);
+        static void GenerateVLQStr(std::string& out, int transformed_column, int file_index, int before_line, int before_column);
+
+        /**
+         * With the 5th field, the index of the name.
+         */
+        static void GenerateVLQStr(std::string& out, int transformed_column, int file_index, int before_line, int before_column, int name_index);
         static void IntToVLQ(io::Writer& writer, int code);
+
+        /**
+         * @return the count of the chars written to the buffer, 7 at most
+         */
+        static int IntToVLQ(char* buffer, int code);
         static int VLQToInt(const char* str, const char*& next);
 
         SourceMapGenerator() = delete;
@@ -42,33 +52,69 @@ namespace jetpack {
         void WriteSources();
 
         /**
-         * Unify all collectors together
+         * Encode the mappings of the fragment to its own VLQ segments,
+         * it's called by the worker after the codegen.
+         * The mapping items are released.
          */
-        void Finalize(Slice<const MappingItem> mapping_items);
+        static void EncodeFragment(CodeGenFragment& fragment);
 
-    private:
-        void EndLine();
+        /**
+         * Point the mappings of the module to its index in the sources,
+         * it's moved by the sources of the input sourcemaps before it.
+         */
+        static void RebaseFragment(CodeGenFragment& fragment, int32_t file_id, int32_t sources_base);
+
+        /**
+         * The fragments are appended in order after WriteSources(),
+         * the mappings are spliced and flushed to the writer.
+         * It's encoded here if it's not.
+         */
+        void AppendFragment(CodeGenFragment& fragment);
 
+        /**
+         * End the mappings, write the names.
+         */
+        void Finalize();
+
+    private:
         LastWriteType last_write_ = LastWriteType::None;
         io::Writer& writer_;
-//        std::string mappings_;
+        std::string mappings_;
+        bool mappings_begun_ = false;
+
+        // the escaped names of the appended fragments
+        std::string names_;
 //        int32_t src_counter_ = 0;
-        int32_t line_counter_ = 1;
+
+        // where the next fragment begins
+        int32_t column_ = 0;
+        int32_t names_base_ = 0;
 
         int32_t l_after_col_ = 0;
         int32_t l_file_index_ = 0;
         int32_t l_before_line_ = 1;
         int32_t l_before_col_ = 0;
+        int32_t l_name_index_ = 0;
 
-        void AddEnoughLines(int32_t target_line);
+        /**
+         * The names of the fragments are concatenated,
+         * the indexes in a fragment are kept.
+         */
+        void AppendNames(const CodeGenFragment& fragment);
+
+        /**
+         * @param column where the fragment begins on the current line
+         * @param names_base the index of the first name of the fragment
+         */
+        void SpliceFragment(const CodeGenFragment& fragment, int32_t column, int32_t names_base);
 
-        void FinalizeMapping(Slice<const MappingItem> items);
+        void FlushMappings();
 
         void FinalizeSources();
 
         void FinalizeSourcesContent();
 
-        bool AddLocation(const std::string& name, int after_col, int file_id, int before_line, int before_col);
+        bool AddLocation(int name_index, int after_col, int file_id, int before_line, int before_col);
 
 //        int32_t GetFilenameIndexByModuleId(int32_t module_id);
 
@@ -502,12 +502,12 @@ namespace jetpack {
 
         if (!IsEnd() && UChar::IsOctalDigit(Peek())) {
             octal = true;
-            result = result * 8 + (Peek() - u'0');
+            result = result * 8 + (NextChar() - u'0');
 
             // 3 digits are only allowed when string starts
             // with 0, 1, 2, 3
-            if (ch - u'0' && !IsEnd() && UChar::IsOctalDigit(Peek())) {
-                result = result * 8 + (Peek() - '0');
+            if (ch <= u'3' && !IsEnd() && UChar::IsOctalDigit(Peek())) {
+                result = result * 8 + (NextChar() - '0');
             }
         }
 
@@ -1093,6 +1093,7 @@ namespace jetpack {
                             if (ch && UChar::IsOctalDigit(ch)) {
                                 uint32_t octToDec;
                                 octal = OctalToDecimal(ch, octToDec);
+                                unescaped = octToDec;
 
                                 str.append(StringFromUtf32(&unescaped, 1));
                             } else {
@@ -1190,7 +1191,7 @@ namespace jetpack {
                             if (!ScanHexEscape(ch, unescaped)) {
                                 ThrowUnexpectedToken();
                             }
-                            cooked.push_back(unescaped);
+                            cooked += StringFromUtf32(&unescaped, 1);
                             break;
                         case 'b':
                             cooked.push_back('\b');
@@ -1232,7 +1233,7 @@ namespace jetpack {
                 line_start_  = cursor_.u16;
                 cooked.push_back('\n');
             } else {
-                cooked.push_back(ch);
+                cooked += StringFromUtf32(&ch, 1);
             }
         }
 
@@ -1246,7 +1247,7 @@ namespace jetpack {
 
         Token tok;
         tok.type = JsTokenType::Template;
-        tok.value = source_->View().substr(start.u8 + 1, cursor_.u8 - rawOffset);
+        tok.value = source_->View().substr(start.u8 + 1, cursor_.u8 - rawOffset - start.u8 - 1);
         tok.lineNumber = line_number_;
         tok.lineStart = line_start_;
         tok.range = make_pair(start.u8, cursor_.u8);
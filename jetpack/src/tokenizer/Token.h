@@ -153,6 +153,9 @@ namespace jetpack {
         bool tail = false;
         std::string cooked;
 
+        // preceded by `/*#__PURE__*/` or `/*@__PURE__*/`
+        bool pure = false;
+
     };
 
 }
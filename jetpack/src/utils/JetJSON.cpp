@@ -3,60 +3,258 @@
 //
 
 #include "JetJSON.h"
-#include <sstream>
-#include <iomanip>
+#include "utils/Common.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JETPACK_JSON_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace jetpack {
 
-    static std::string FormatByte(unsigned char value) {
-        std::stringstream ss;
-        ss << std::setfill('0') << std::setw(2) << std::hex << std::uppercase
-           << static_cast<unsigned int>(value);
-        return ss.str();
+    // the input is escaped to the writer in slices of this size
+    static constexpr std::size_t ESCAPE_SLICE_SIZE = 32 * 1024;
+
+    static inline bool NeedsEscape(unsigned char ch) {
+        return ch < 0x20 || ch == '"' || ch == '\\';
+    }
+
+#ifndef JETPACK_JSON_SSE2
+    static constexpr uint64_t Broadcast(unsigned char ch) {
+        return 0x0101010101010101ULL * ch;
+    }
+
+    /**
+     * If any byte of the word is '"', '\\' or less than 0x20.
+     */
+    static inline bool WordNeedsEscape(uint64_t word) {
+        constexpr uint64_t ones = Broadcast(0x01);
+        constexpr uint64_t highs = Broadcast(0x80);
+        const uint64_t quote = word ^ Broadcast('"');
+        const uint64_t backslash = word ^ Broadcast('\\');
+        const uint64_t found = ((quote - ones) & ~quote)
+                             | ((backslash - ones) & ~backslash)
+                             | ((word - Broadcast(0x20)) & ~word);
+        return (found & highs) != 0;
+    }
+#endif
+
+    /**
+     * Find the first byte needs escaping, 16 bytes a time with SSE2,
+     * 8 bytes a time otherwise.
+     */
+    static const char* FindEscape(const char* p, const char* end) {
+#ifdef JETPACK_JSON_SSE2
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i control_max = _mm_set1_epi8(0x1F);
+        while (end - p >= 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            // chunk <= 0x1F iff min(chunk, 0x1F) == chunk, unsigned
+            const __m128i found = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                    _mm_cmpeq_epi8(_mm_min_epu8(chunk, control_max), chunk));
+            const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(found));
+            if (mask != 0) {
+#ifdef _WIN32
+                unsigned long index;
+                _BitScanForward(&index, mask);
+                return p + index;
+#else
+                return p + __builtin_ctz(mask);
+#endif
+            }
+            p += 16;
+        }
+#else
+        while (end - p >= 8) {
+            uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            if (WordNeedsEscape(word)) {
+                break;
+            }
+            p += 8;
+        }
+#endif
+        while (p < end && !NeedsEscape(static_cast<unsigned char>(*p))) {
+            p++;
+        }
+        return p;
+    }
+
+    static void AppendEscapedByte(unsigned char ch, std::string& out) {
+        static const char hex_digits[] = "0123456789ABCDEF";
+        switch (ch) {
+            case '\\':
+            case '"':
+                out.push_back('\\');
+                out.push_back(static_cast<char>(ch));
+                break;
+            case '\b':
+                out.append("\\b", 2);
+                break;
+            case '\t':
+                out.append("\\t", 2);
+                break;
+            case '\n':
+                out.append("\\n", 2);
+                break;
+            case '\f':
+                out.append("\\f", 2);
+                break;
+            case '\r':
+                out.append("\\r", 2);
+                break;
+            default: {
+                const char unicode[] = { '\\', 'u', '0', '0', hex_digits[ch >> 4], hex_digits[ch & 0xF] };
+                out.append(unicode, sizeof(unicode));
+                break;
+            }
+        }
+    }
+
+    void EscapeJSONString(std::string_view str, std::string& out) {
+        const char* p = str.data();
+        const char* end = p + str.size();
+        while (p < end) {
+            const char* next = FindEscape(p, end);
+            out.append(p, next - p);
+            if (next == end) {
+                break;
+            }
+            AppendEscapedByte(static_cast<unsigned char>(*next), out);
+            p = next + 1;
+        }
     }
 
     std::string EscapeJSONString(std::string_view str) {
         std::string m;
-        m.reserve(str.size() * 2);
+        m.reserve(str.size() + str.size() / 8);
+        EscapeJSONString(str, m);
+        return m;
+    }
 
-        for (size_t i = 0; i < str.size(); ++i) {
-            const char ch = str[i];
-            switch (ch) {
-                case '/':
-                    m += ch;
-                    break;
-                case '\\':
+    io::IOError EscapeJSONString(std::string_view str, io::Writer& writer) {
+        // the escapes are per byte, the slices can be cut anywhere
+        std::string buffer;
+        buffer.reserve(ESCAPE_SLICE_SIZE * 2);
+        for (std::size_t offset = 0; offset < str.size(); offset += ESCAPE_SLICE_SIZE) {
+            buffer.clear();
+            EscapeJSONString(str.substr(offset, ESCAPE_SLICE_SIZE), buffer);
+            auto err = writer.Write(buffer.data(), buffer.size());
+            if (err != io::IOError::Ok) {
+                return err;
+            }
+        }
+        return io::IOError::Ok;
+    }
+
+    static int HexValue(char ch) {
+        if (ch >= '0' && ch <= '9') {
+            return ch - '0';
+        }
+        if (ch >= 'a' && ch <= 'f') {
+            return ch - 'a' + 10;
+        }
+        if (ch >= 'A' && ch <= 'F') {
+            return ch - 'A' + 10;
+        }
+        return -1;
+    }
+
+    static bool ReadUnicodeEscape(std::string_view str, std::size_t index, uint32_t& code) {
+        if (index + 4 > str.size()) {
+            return false;
+        }
+        code = 0;
+        for (std::size_t i = index; i < index + 4; i++) {
+            int value = HexValue(str[i]);
+            if (value < 0) {
+                return false;
+            }
+            code = (code << 4) | static_cast<uint32_t>(value);
+        }
+        return true;
+    }
+
+    static void AppendUTF8(uint32_t code, std::string& out) {
+        if (code < 0x80) {
+            out.push_back(static_cast<char>(code));
+        } else if (code < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else if (code < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+    }
+
+    bool UnescapeJSONString(std::string_view str, std::string& out) {
+        std::size_t i = 0;
+        while (i < str.size()) {
+            std::size_t next = str.find('\\', i);
+            if (next == std::string_view::npos) {
+                out.append(str.data() + i, str.size() - i);
+                break;
+            }
+            out.append(str.data() + i, next - i);
+            if (next + 1 >= str.size()) {
+                return false;
+            }
+
+            i = next + 2;
+            switch (str[next + 1]) {
                 case '"':
-                    m += '\\';
-                    m += ch;
+                case '\\':
+                case '/':
+                    out.push_back(str[next + 1]);
                     break;
-                case '\b':
-                    m += "\\b";
+                case 'b':
+                    out.push_back('\b');
                     break;
-                case '\t':
-                    m += "\\t";
+                case 'f':
+                    out.push_back('\f');
                     break;
-                case '\n':
-                    m += "\\n";
+                case 'n':
+                    out.push_back('\n');
                     break;
-                case '\f':
-                    m += "\\f";
+                case 'r':
+                    out.push_back('\r');
                     break;
-                case '\r':
-                    m += "\\r";
+                case 't':
+                    out.push_back('\t');
                     break;
-                default:
-                    if (ch < ' ') {
-                        m += "\\u00";
-                        m += FormatByte(static_cast<unsigned char>(ch));
-                    } else {
-                        m += ch;
+                case 'u': {
+                    uint32_t code;
+                    if (!ReadUnicodeEscape(str, i, code)) {
+                        return false;
+                    }
+                    i += 4;
+
+                    // the surrogate pair
+                    uint32_t low;
+                    if (code >= 0xD800 && code <= 0xDBFF &&
+                        i + 1 < str.size() && str[i] == '\\' && str[i + 1] == 'u' &&
+                        ReadUnicodeEscape(str, i + 2, low) && low >= 0xDC00 && low <= 0xDFFF) {
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    } else if (code >= 0xD800 && code <= 0xDFFF) {
+                        code = 0xFFFD;
                     }
+                    AppendUTF8(code, out);
                     break;
+                }
+                default:
+                    return false;
             }
         }
-
-        return m;
+        return true;
     }
 
 }
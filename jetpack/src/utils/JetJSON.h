@@ -6,11 +6,31 @@
 #define ROCKET_BUNDLE_JETJSON_H
 
 #include <string>
+#include <string_view>
+#include "utils/io/FileIO.h"
 
 namespace jetpack {
 
     std::string EscapeJSONString(std::string_view str);
 
+    /**
+     * Append the escaped string to `out`.
+     */
+    void EscapeJSONString(std::string_view str, std::string& out);
+
+    /**
+     * Escape the string to the writer piece by piece,
+     * the whole escaped string is never held in memory.
+     */
+    io::IOError EscapeJSONString(std::string_view str, io::Writer& writer);
+
+    /**
+     * Decode the content between the quotes of a JSON string,
+     * append it to `out`.
+     * @return false if it's malformed
+     */
+    bool UnescapeJSONString(std::string_view str, std::string& out);
+
 }
 
 #endif //ROCKET_BUNDLE_JETJSON_H
@@ -0,0 +1,105 @@
+//
+// Created by Duzhong Chen on 2021/12/1.
+//
+
+#include <algorithm>
+#include "ChunkedBuffer.h"
+
+namespace jetpack::io {
+
+    void ChunkedBuffer::Reserve(std::size_t size) {
+        std::size_t available = static_cast<std::size_t>(end_ - cursor_);
+        std::size_t next = cursor_ == nullptr ? 0 : current_ + 1;
+        for (std::size_t i = next; i < pages_.size(); i++) {
+            available += pages_[i].capacity;
+        }
+        if (available < size) {
+            AddPage(std::max(size - available, MIN_PAGE_SIZE));
+        }
+    }
+
+    void ChunkedBuffer::AddPage(std::size_t capacity) {
+        Page page;
+        page.data = std::unique_ptr<char[]>(new char[capacity]);
+        page.capacity = capacity;
+        pages_.push_back(std::move(page));
+    }
+
+    void ChunkedBuffer::NextPage() {
+        if (cursor_ != nullptr) {
+            filled_ += pages_[current_].capacity;
+            current_++;
+        }
+        if (current_ == pages_.size()) {
+            std::size_t capacity = pages_.empty() ? MIN_PAGE_SIZE : pages_.back().capacity * 2;
+            AddPage(std::min(std::max(capacity, MIN_PAGE_SIZE), MAX_PAGE_SIZE));
+        }
+        cursor_ = pages_[current_].data.get();
+        end_ = cursor_ + pages_[current_].capacity;
+    }
+
+    void ChunkedBuffer::AppendAcrossPages(const char* data, std::size_t len) {
+        while (len > 0) {
+            if (cursor_ == end_) {
+                NextPage();
+            }
+            std::size_t count = std::min(len, static_cast<std::size_t>(end_ - cursor_));
+            std::memcpy(cursor_, data, count);
+            cursor_ += count;
+            data += count;
+            len -= count;
+        }
+    }
+
+    char ChunkedBuffer::Back() const {
+        J_ASSERT(!Empty());
+        if (cursor_ != pages_[current_].data.get()) {
+            return cursor_[-1];
+        }
+        auto& prev = pages_[current_ - 1];
+        return prev.data[prev.capacity - 1];
+    }
+
+    void ChunkedBuffer::PopBack() {
+        J_ASSERT(!Empty());
+        if (cursor_ == pages_[current_].data.get()) {
+            // back to the end of the previous page
+            current_--;
+            filled_ -= pages_[current_].capacity;
+            cursor_ = pages_[current_].data.get() + pages_[current_].capacity;
+            end_ = cursor_;
+        }
+        cursor_--;
+    }
+
+    std::vector<std::string_view> ChunkedBuffer::Chunks() const {
+        std::vector<std::string_view> result;
+        if (cursor_ == nullptr) {
+            return result;
+        }
+        result.reserve(current_ + 1);
+        for (std::size_t i = 0; i < current_; i++) {
+            result.emplace_back(pages_[i].data.get(), pages_[i].capacity);
+        }
+        auto begin = pages_[current_].data.get();
+        if (cursor_ != begin) {
+            result.emplace_back(begin, cursor_ - begin);
+        }
+        return result;
+    }
+
+    void ChunkedBuffer::CopyTo(char* dest) const {
+        for (auto chunk : Chunks()) {
+            std::memcpy(dest, chunk.data(), chunk.size());
+            dest += chunk.size();
+        }
+    }
+
+    std::string ChunkedBuffer::ToString() const {
+        std::string result;
+        result.resize(Size());
+        CopyTo(result.data());
+        return result;
+    }
+
+}
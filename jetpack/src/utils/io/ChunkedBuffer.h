@@ -0,0 +1,114 @@
+//
+// Created by Duzhong Chen on 2021/12/1.
+//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstring>
+#include "utils/Common.h"
+
+namespace jetpack::io {
+
+    /**
+     * An append-only buffer of pages.
+     * The written bytes are never moved when it grows,
+     * the pages are passed to the writer one by one.
+     *
+     * The first page is small, the next one doubles until MAX_PAGE_SIZE,
+     * a small module doesn't take a large page.
+     */
+    class ChunkedBuffer {
+    public:
+        static constexpr std::size_t MIN_PAGE_SIZE = 1024;
+        static constexpr std::size_t MAX_PAGE_SIZE = 64 * 1024;
+
+        ChunkedBuffer() = default;
+        ChunkedBuffer(ChunkedBuffer&&) = default;
+        ChunkedBuffer& operator=(ChunkedBuffer&&) = default;
+
+        ChunkedBuffer(const ChunkedBuffer&) = delete;
+        ChunkedBuffer& operator=(const ChunkedBuffer&) = delete;
+
+        /**
+         * Allocate a page for the estimated size up front,
+         * if the pages left are not enough.
+         */
+        void Reserve(std::size_t size);
+
+        inline void Append(char ch) {
+            if (unlikely(cursor_ == end_)) {
+                NextPage();
+            }
+            *cursor_++ = ch;
+        }
+
+        inline void Append(const char* data, std::size_t len) {
+            if (likely(len <= static_cast<std::size_t>(end_ - cursor_))) {
+                std::memcpy(cursor_, data, len);
+                cursor_ += len;
+                return;
+            }
+            AppendAcrossPages(data, len);
+        }
+
+        inline void Append(std::string_view view) {
+            Append(view.data(), view.size());
+        }
+
+        [[nodiscard]]
+        inline bool Empty() const {
+            return Size() == 0;
+        }
+
+        [[nodiscard]]
+        inline std::size_t Size() const {
+            if (cursor_ == nullptr) {
+                return 0;
+            }
+            return filled_ + (cursor_ - pages_[current_].data.get());
+        }
+
+        [[nodiscard]]
+        char Back() const;
+
+        void PopBack();
+
+        /**
+         * The written part of the pages, in order.
+         */
+        [[nodiscard]]
+        std::vector<std::string_view> Chunks() const;
+
+        void CopyTo(char* dest) const;
+
+        [[nodiscard]]
+        std::string ToString() const;
+
+    private:
+        struct Page {
+            std::unique_ptr<char[]> data;
+            std::size_t capacity;
+        };
+
+        void AddPage(std::size_t capacity);
+
+        void NextPage();
+
+        void AppendAcrossPages(const char* data, std::size_t len);
+
+        // the pages before current_ are full
+        std::vector<Page> pages_;
+        std::size_t current_ = 0;
+
+        // the size of the pages before current_
+        std::size_t filled_ = 0;
+        char* cursor_ = nullptr;
+        char* end_ = nullptr;
+
+    };
+
+}
@@ -2,8 +2,11 @@
 // Created by Duzhong Chen on 2021/3/28.
 //
 
+#include <algorithm>
 #include <iostream>
 #include <fmt/format.h>
+#include <xxhash.h>
+#include <filesystem.hpp>
 #include "FileIO.h"
 #if defined(_WIN32)
 #include <fstream>
@@ -111,7 +114,7 @@ namespace jetpack::io {
 
     class FileWriterInternal {
     public:
-        FileWriterInternal(const std::string& path);
+        FileWriterInternal(const std::string& path, bool atomic);
 
         inline IOError Error() const {
             return error_;
@@ -125,12 +128,61 @@ namespace jetpack::io {
 
         IOError WriteByte(unsigned char ch);
 
+        IOError WriteChunks(const ChunkedBuffer& buffer);
+
+        char* Extend(size_t len);
+
+        IOError SizeHint(uint64_t size);
+
+        /**
+         * Commit the content only if all the writes succeeded.
+         */
+        IOError Close();
+
+        uint64_t ContentHash() const;
+
+        inline void SetTargetPath(const std::string& path) {
+            J_ASSERT(atomic_);
+            target_path_ = path;
+        }
+
+        inline bool Unchanged() const {
+            return unchanged_;
+        }
+
+        /**
+         * The temporary file is removed if it's not closed,
+         * e.g. returned early on an error.
+         */
         ~FileWriterInternal();
 
     private:
+        /**
+         * Remember the first error, nothing is written after it.
+         */
+        inline IOError Record(IOError err) {
+            if (err != IOError::Ok && error_ == IOError::Ok) {
+                error_ = err;
+            }
+            return err;
+        }
+
         IOError EnsureSize(uint64_t);
 
+        /**
+         * Unmap and close the file, truncated to the written size.
+         */
+        void Release();
+
+        IOError Commit(uint64_t hash);
+
+        // the temporary file if it's atomic
         std::string path_;
+        std::string target_path_;
+        bool atomic_ = false;
+        bool opened_ = false;
+        bool closed_ = false;
+        bool unchanged_ = false;
         uint64_t offset_ = 0;
         uint64_t current_size_ = 0;
         unsigned char* mapped_mem_ = nullptr;
@@ -144,7 +196,7 @@ namespace jetpack::io {
 
     };
 
-    // 8k buffer
+    // the minimal step to grow, it's doubled if the size is not hinted
     constexpr uint64_t FILE_SIZE_INCR = 512 * 1024;
 
     IOError FileWriterInternal::Open() {
@@ -152,7 +204,7 @@ namespace jetpack::io {
             hFile = ::CreateFileA(path_.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
             if (hFile == INVALID_HANDLE_VALUE) {
                 std::cerr << fmt::format("open file {} failed: {}", path_, ::GetLastError()) << std::endl;
-                return IOError::OpenFailed;
+                return Record(IOError::OpenFailed);
             }
 
             DWORD file_size;
@@ -161,25 +213,24 @@ namespace jetpack::io {
 
             hMapping = ::CreateFileMapping(hFile, NULL, PAGE_READWRITE, 0, current_size_, NULL);
             if (hMapping == NULL) {
-                ::CloseHandle(hFile);
+                hMapping = INVALID_HANDLE_VALUE;
                 std::cerr << fmt::format("read file {} failed: {}", path_, ::GetLastError()) << std::endl;
-                return IOError::ReadFailed;
+                return Record(IOError::ReadFailed);
             }
 
             void* p = MapViewOfFile(hMapping, FILE_MAP_WRITE, 0, 0, 0);
             if (p == NULL) {
-                ::CloseHandle(hMapping);
-                ::CloseHandle(hFile);
                 std::cerr << fmt::format("read file {} failed: {}", path_, ::GetLastError()) << std::endl;
-                return IOError::ReadFailed;
+                return Record(IOError::ReadFailed);
             }
             mapped_mem_ = reinterpret_cast<unsigned char*>(p);
+            opened_ = true;
             return IOError::Ok;
 #else
         fd = ::open(path_.c_str(), O_RDWR | O_CREAT, 0644);
         if (fd < 0) {
             std::cerr << fmt::format("open file {} failed: {}", path_, strerror(errno)) << std::endl;
-            return IOError::OpenFailed;
+            return Record(IOError::OpenFailed);
         }
 
         struct stat st;
@@ -188,15 +239,17 @@ namespace jetpack::io {
 
         current_size_ = st.st_size;
         if (auto ret = EnsureSize(FILE_SIZE_INCR); ret != IOError::Ok) {
-            return ret;
+            return Record(ret);
         }
 
         mapped_mem_ = reinterpret_cast<unsigned char*>(::mmap(nullptr, current_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
         if (mapped_mem_ == MAP_FAILED) {
+            mapped_mem_ = nullptr;
             std::cerr << fmt::format("map file {} failed: {}", path_, strerror(errno)) << std::endl;
-            return IOError::ReadFailed;
+            return Record(IOError::ReadFailed);
         }
 
+        opened_ = true;
         return IOError::Ok;
 #endif
     }
@@ -205,6 +258,8 @@ namespace jetpack::io {
 #ifdef _WIN32
 		::UnmapViewOfFile(mapped_mem_);
         ::CloseHandle(hMapping);
+        mapped_mem_ = nullptr;
+        hMapping = INVALID_HANDLE_VALUE;
 
         bool ok = false;
 
@@ -213,47 +268,55 @@ namespace jetpack::io {
         ok = ::SetFilePointerEx(hFile, large_size, NULL, FILE_BEGIN);
         if (!ok) {
             std::cerr << fmt::format("can not set file pointer of {}", path_) << std::endl;
-            return IOError::ResizeFailed;
+            return Record(IOError::ResizeFailed);
         }
 
         ok = ::SetEndOfFile(hFile);
         if (!ok) {
             std::cerr << fmt::format("can not set end of {}", path_) << std::endl;
-            return IOError::ResizeFailed;
+            return Record(IOError::ResizeFailed);
         }
 
         current_size_ = size;
 
 		hMapping = ::CreateFileMapping(hFile, NULL, PAGE_READWRITE, 0, current_size_, NULL);
 		if (hMapping == NULL) {
-			::CloseHandle(hFile);
+			hMapping = INVALID_HANDLE_VALUE;
 			std::cerr << fmt::format("create file mapping {} failed: {}", path_, ::GetLastError()) << std::endl;
-			return IOError::ResizeFailed;
+			return Record(IOError::ResizeFailed);
 		}
 
 		void* p = MapViewOfFile(hMapping, FILE_MAP_WRITE, 0, 0, 0);
 		if (p == NULL) {
-			::CloseHandle(hMapping);
-			::CloseHandle(hFile);
 			std::cerr << fmt::format("map file {} failed: {}", path_, ::GetLastError()) << std::endl;
-			return IOError::ResizeFailed;
+			return Record(IOError::ResizeFailed);
 		}
 		mapped_mem_ = reinterpret_cast<unsigned char*>(p);
 
         return IOError::Ok;
 #else
-        ::munmap(mapped_mem_, current_size_);
+        if (mapped_mem_ != nullptr) {
+            ::munmap(mapped_mem_, current_size_);
+            mapped_mem_ = nullptr;
+        }
 
-        if (::ftruncate(fd, size) != 0) {
+#if defined(__linux__)
+        // allocate the blocks up front, instead of a sparse file
+        bool allocated = size > current_size_ && ::posix_fallocate(fd, 0, size) == 0;
+#else
+        bool allocated = false;
+#endif
+        if (!allocated && ::ftruncate(fd, size) != 0) {
             std::cerr << fmt::format("resize file {} failed: {}", path_, strerror(errno)) << std::endl;
-            return IOError::ResizeFailed;
+            return Record(IOError::ResizeFailed);
         }
         current_size_ = size;
 
         mapped_mem_ = reinterpret_cast<unsigned char*>(::mmap(nullptr, current_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
         if (mapped_mem_ == MAP_FAILED) {
+            mapped_mem_ = nullptr;
             std::cerr << fmt::format("map file {} failed: {}", path_, strerror(errno)) << std::endl;
-            return IOError::ReadFailed;
+            return Record(IOError::ReadFailed);
         }
 
         return IOError::Ok;
@@ -265,15 +328,25 @@ namespace jetpack::io {
             return IOError::Ok;
         }
 
-        uint64_t need_size = current_size_;
-        while (need_size < size) {
-            need_size += FILE_SIZE_INCR;
-        }
+        // grow geometrically, the mapping is rebuilt O(log n) times
+        uint64_t need_size = std::max(current_size_ * 2, current_size_ + FILE_SIZE_INCR);
+        return Resize(std::max(need_size, size));
+    }
 
-        return Resize(need_size);
+    IOError FileWriterInternal::SizeHint(uint64_t size) {
+        if (error_ != IOError::Ok) {
+            return error_;
+        }
+        if (current_size_ >= size) {
+            return IOError::Ok;
+        }
+        return Resize(size);
     }
 
     IOError FileWriterInternal::Write(const char *bytes, size_t len) {
+        if (error_ != IOError::Ok) {
+            return error_;
+        }
         IOError err = EnsureSize(offset_ + len);
         if (err != IOError::Ok) {
             return err;
@@ -284,6 +357,9 @@ namespace jetpack::io {
     }
 
     IOError FileWriterInternal::WriteByte(unsigned char ch) {
+        if (error_ != IOError::Ok) {
+            return error_;
+        }
         IOError err = EnsureSize(offset_ + 1);
         if (err != IOError::Ok) {
             return err;
@@ -292,33 +368,154 @@ namespace jetpack::io {
         return IOError::Ok;
     }
 
-    FileWriterInternal::~FileWriterInternal() {
+    IOError FileWriterInternal::WriteChunks(const ChunkedBuffer& buffer) {
+        if (error_ != IOError::Ok) {
+            return error_;
+        }
+        // grow the mapping once, copy the pages into it
+        IOError err = EnsureSize(offset_ + buffer.Size());
+        if (err != IOError::Ok) {
+            return err;
+        }
+        for (auto chunk : buffer.Chunks()) {
+            memcpy(mapped_mem_ + offset_, chunk.data(), chunk.size());
+            offset_ += chunk.size();
+        }
+        return IOError::Ok;
+    }
+
+    char* FileWriterInternal::Extend(size_t len) {
+        if (error_ != IOError::Ok || EnsureSize(offset_ + len) != IOError::Ok) {
+            return nullptr;
+        }
+        char* result = reinterpret_cast<char*>(mapped_mem_ + offset_);
+        offset_ += len;
+        return result;
+    }
+
+    uint64_t FileWriterInternal::ContentHash() const {
+        if (mapped_mem_ == nullptr) {
+            return 0;
+        }
+        return XXH3_64bits(mapped_mem_, offset_);
+    }
+
+    IOError FileWriterInternal::Close() {
+        if (!opened_) {
+            return error_;
+        }
+        opened_ = false;
+        closed_ = true;
+
+        uint64_t hash = atomic_ && error_ == IOError::Ok ? ContentHash() : 0;
+        Release();
+
+        if (!atomic_) {
+            return error_;
+        }
+        if (error_ != IOError::Ok) {
+            // the target is kept untouched
+            std::error_code ec;
+            ghc::filesystem::remove(path_, ec);
+            return error_;
+        }
+        return Record(Commit(hash));
+    }
+
+    void FileWriterInternal::Release() {
 #ifdef _WIN32
-		::UnmapViewOfFile(mapped_mem_);
-        ::CloseHandle(hMapping);
-		::CloseHandle(hFile);
+        if (mapped_mem_ != nullptr) {
+            ::UnmapViewOfFile(mapped_mem_);
+            mapped_mem_ = nullptr;
+        }
+        if (hMapping != INVALID_HANDLE_VALUE) {
+            ::CloseHandle(hMapping);
+            hMapping = INVALID_HANDLE_VALUE;
+        }
+        if (hFile != INVALID_HANDLE_VALUE) {
+            LARGE_INTEGER large_size;
+            large_size.QuadPart = offset_;
+            if (!::SetFilePointerEx(hFile, large_size, NULL, FILE_BEGIN) || !::SetEndOfFile(hFile)) {
+                Record(IOError::ResizeFailed);
+            }
+            ::CloseHandle(hFile);
+            hFile = INVALID_HANDLE_VALUE;
+        }
 #else
         if (likely(mapped_mem_ != nullptr)) {
             ::munmap(mapped_mem_, current_size_);
             mapped_mem_ = nullptr;
         }
         if (likely(fd >= 0)) {
-            ::ftruncate(fd, offset_);
-            ::close(fd);
+            if (::ftruncate(fd, offset_) != 0) {
+                std::cerr << fmt::format("truncate file {} failed: {}", path_, strerror(errno)) << std::endl;
+                Record(IOError::ResizeFailed);
+            }
+            if (::close(fd) != 0) {
+                Record(IOError::WriteFailed);
+            }
             fd = -1;
         }
 #endif
     }
 
-    FileWriterInternal::FileWriterInternal(const std::string& path): path_(path) {
+    IOError FileWriterInternal::Commit(uint64_t hash) {
+        std::error_code ec;
+        auto old_size = ghc::filesystem::file_size(target_path_, ec);
+
+        bool same = false;
+        if (!ec && old_size == offset_) {
+            if (offset_ == 0) {
+                same = true;
+            } else {
+                MappedFileReader reader;
+                same = reader.Open(target_path_) == IOError::Ok &&
+                       XXH3_64bits(reader.Data(), reader.FileSize()) == hash;
+            }
+        }
+
+        if (same) {
+            // the mtime of the previous file is kept, no rebuild is triggered
+            ghc::filesystem::remove(path_, ec);
+            unchanged_ = true;
+            return IOError::Ok;
+        }
+
+        ghc::filesystem::rename(path_, target_path_, ec);
+        if (ec) {
+            std::cerr << fmt::format("rename {} to {} failed: {}", path_, target_path_, ec.message()) << std::endl;
+            ghc::filesystem::remove(path_, ec);
+            return IOError::WriteFailed;
+        }
+        return IOError::Ok;
+    }
+
+    FileWriterInternal::~FileWriterInternal() {
+        Release();
+        if (atomic_ && !closed_) {
+            std::error_code ec;
+            ghc::filesystem::remove(path_, ec);
+        }
+    }
+
+    static std::string TempPathOf(const std::string& path) {
+#ifdef _WIN32
+        return fmt::format("{}.{}.tmp", path, ::GetCurrentProcessId());
+#else
+        return fmt::format("{}.{}.tmp", path, ::getpid());
+#endif
+    }
+
+    FileWriterInternal::FileWriterInternal(const std::string& path, bool atomic):
+    path_(atomic ? TempPathOf(path) : path), target_path_(path), atomic_(atomic) {
     }
 
     void FileWriterInternalDeleter::operator()(FileWriterInternal *d) {
         delete d;
     }
 
-    FileWriter::FileWriter(const std::string& path) {
-        auto ptr = new FileWriterInternal(path);
+    FileWriter::FileWriter(const std::string& path, bool atomic) {
+        auto ptr = new FileWriterInternal(path, atomic);
         d_ = std::unique_ptr<FileWriterInternal, FileWriterInternalDeleter>(ptr);
     }
 
@@ -326,6 +523,22 @@ namespace jetpack::io {
         return d_->Open();
     }
 
+    IOError FileWriter::Close() {
+        return d_->Close();
+    }
+
+    uint64_t FileWriter::ContentHash() const {
+        return d_->ContentHash();
+    }
+
+    void FileWriter::SetPath(const std::string& path) {
+        d_->SetTargetPath(path);
+    }
+
+    bool FileWriter::Unchanged() const {
+        return d_->Unchanged();
+    }
+
     IOError FileWriter::Write(const char *bytes, size_t len) {
         return d_->Write(bytes, len);
     }
@@ -334,6 +547,27 @@ namespace jetpack::io {
         return d_->WriteByte(ch);
     }
 
+    IOError FileWriter::WriteChunks(const ChunkedBuffer& buffer) {
+        return d_->WriteChunks(buffer);
+    }
+
+    char* FileWriter::Extend(size_t len) {
+        return d_->Extend(len);
+    }
+
+    void FileWriter::SizeHint(uint64_t size) {
+        d_->SizeHint(size);
+    }
+
+    IOError Writer::WriteChunks(const ChunkedBuffer& buffer) {
+        for (auto chunk : buffer.Chunks()) {
+            if (auto err = Write(chunk.data(), chunk.size()); err != IOError::Ok) {
+                return err;
+            }
+        }
+        return IOError::Ok;
+    }
+
     IOError StringWriter::Write(const char* bytes, size_t len) {
         d_.append(bytes, len);
         return IOError::Ok;
@@ -344,6 +578,16 @@ namespace jetpack::io {
         return IOError::Ok;
     }
 
+    void StringWriter::SizeHint(uint64_t size) {
+        d_.reserve(size);
+    }
+
+    char* StringWriter::Extend(size_t len) {
+        auto offset = d_.size();
+        d_.resize(offset + len);
+        return d_.data() + offset;
+    }
+
     IOError ReadFileToStdString(const std::string& filename, std::string& result) {
         MappedFileReader reader;
         IOError error = reader.Open(filename);
@@ -377,12 +621,16 @@ namespace jetpack::io {
     }
 
     IOError WriteBufferToPath(const std::string& filename, const char* buffer, int64_t size) {
-        FileWriter writer(filename);
+        FileWriter writer(filename, true);
         IOError err = writer.Open();
         if (err != IOError::Ok) {
             return err;
         }
-        return writer.Write(buffer, size);
+        err = writer.Write(buffer, size);
+        if (err != IOError::Ok) {
+            return err;
+        }
+        return writer.Close();
     }
 
 }
@@ -9,6 +9,7 @@
 #include <string_view>
 #include "utils/string/UString.h"
 #include "utils/MemoryViewOwner.h"
+#include "ChunkedBuffer.h"
 
 namespace jetpack::io {
     enum class IOError {
@@ -33,6 +34,28 @@ namespace jetpack::io {
 
         virtual IOError Write(const char* bytes, size_t len) = 0;
 
+        /**
+         * Write the pages in order, without joining them first.
+         */
+        virtual IOError WriteChunks(const ChunkedBuffer& buffer);
+
+        /**
+         * Extend the output by `len` bytes, return the address of them.
+         * They can be filled by many threads,
+         * the address is valid until the next write.
+         *
+         * nullptr if the writer doesn't support it.
+         */
+        virtual char* Extend(size_t len) {
+            return nullptr;
+        }
+
+        /**
+         * The expected size of the whole output,
+         * the space is allocated at once.
+         */
+        virtual void SizeHint(uint64_t size) {}
+
         virtual ~Writer() = default;
 
     };
@@ -45,16 +68,52 @@ namespace jetpack::io {
 
     };
 
+    /**
+     * If it's atomic, the content is written to a temporary file,
+     * which replaces the target when closed.
+     * The previous file is kept untouched if the content is unchanged,
+     * if any write failed, or if it's destroyed without Close().
+     */
     class FileWriter : public Writer {
     public:
-        FileWriter(const std::string& path);
+        FileWriter(const std::string& path, bool atomic = false);
 
         IOError Open();
 
+        /**
+         * Commit the content if all the writes succeeded,
+         * the first error is returned otherwise.
+         */
+        IOError Close();
+
+        /**
+         * XXH3 of the bytes written.
+         */
+        [[nodiscard]]
+        uint64_t ContentHash() const;
+
+        /**
+         * Change the target of an atomic writer before it's closed,
+         * e.g. to a name with the content hash.
+         */
+        void SetPath(const std::string& path);
+
+        /**
+         * The target is not replaced because the content is the same.
+         */
+        [[nodiscard]]
+        bool Unchanged() const;
+
         IOError Write(const char* bytes, size_t len) override;
 
         IOError WriteByte(unsigned char ch) override;
 
+        IOError WriteChunks(const ChunkedBuffer& buffer) override;
+
+        char* Extend(size_t len) override;
+
+        void SizeHint(uint64_t size) override;
+
         ~FileWriter() override = default;
 
     private:
@@ -70,6 +129,10 @@ namespace jetpack::io {
 
         IOError WriteByte(unsigned char ch) override;
 
+        char* Extend(size_t len) override;
+
+        void SizeHint(uint64_t size) override;
+
         ~StringWriter() override = default;
 
     private:
@@ -9,6 +9,7 @@
 
 #include "ModuleResolver.h"
 #include "codegen/CodeGen.h"
+#include "parser/NodesMaker.h"
 
 using namespace jetpack;
 using namespace jetpack::parser;
@@ -24,7 +25,7 @@ inline std::string ParseAndCodeGen(std::string_view content) {
     CodeGenConfig code_gen_config;
     CodeGen codegen(code_gen_config, fragment);
     codegen.Traverse(*mod);
-    return fragment.content;
+    return fragment.content.ToString();
 }
 
 TEST(CodeGen, Export) {
@@ -185,3 +186,141 @@ TEST(CodeGen, Setter) {
 
     EXPECT_EQ(ParseAndCodeGen(std::string(src)), src);
 }
+
+inline std::string MangleAndCodeGen(std::string_view content, PropertyMangler& mangler) {
+    Config config = Config::Default();
+    AstContext ctx;
+    Parser parser(ctx, content, config);
+
+    auto mod = parser.ParseModule();
+    mod->scope->ResolveAllSymbols(nullptr);
+
+    std::vector<PropertyNames> names(1);
+    PropertyMangler::CollectNames(*mod, names[0]);
+    mangler.DistributeNames(names);
+    mangler.Apply(*mod);
+
+    CodeGenFragment fragment;
+    CodeGenConfig code_gen_config;
+    CodeGen codegen(code_gen_config, fragment);
+    codegen.Traverse(*mod);
+    return fragment.content.ToString();
+}
+
+TEST(CodeGen, MangleProps) {
+    std::string src = "const obj = { _a: 1, b: 2, _c() {} };\n"
+                      "obj._a = obj.b + obj._a;\n"
+                      "obj._c();\n";
+    std::string expected = "const obj = {\n"
+                           "  q: 1,\n"
+                           "  b: 2,\n"
+                           "  w: function() {  }\n"
+                           "};\n"
+                           "obj.q = obj.b + obj.q;\n"
+                           "obj.w();\n";
+
+    PropertyMangler mangler("^_");
+    EXPECT_EQ(MangleAndCodeGen(src, mangler), expected);
+}
+
+TEST(CodeGen, MangleShorthandAndQuoted) {
+    std::string src = "const _a = 1;\n"
+                      "const obj = { _a, '_b': 2 };\n"
+                      "console.log(obj._b, obj.q);\n";
+    std::string expected = "const _a = 1;\n"
+                           "const obj = {\n"
+                           "  w: _a,\n"
+                           "  '_b': 2\n"
+                           "};\n"
+                           "console.log(obj._b, obj.q);\n";
+
+    PropertyMangler mangler("^_");
+    EXPECT_EQ(MangleAndCodeGen(src, mangler), expected);
+}
+
+TEST(CodeGen, ModuleParts) {
+    std::string src = "// header\n"
+                      "const a = 1;\n"
+                      "/* between */\n"
+                      "function b() {\n"
+                      "  // inner\n"
+                      "  return a;\n"
+                      "}\n"
+                      "const c = b();\n"
+                      "// last\n"
+                      "export { c };\n";
+
+    Config config = Config::Default();
+    AstContext ctx;
+    Parser parser(ctx, src, config);
+    auto mod = parser.ParseModule();
+
+    CodeGenConfig code_gen_config;
+    CodeGenFragment whole;
+    CodeGen(code_gen_config, whole).Traverse(*mod);
+
+    auto stmts = mod->body.to_vec();
+    auto ends = CodeGen::SplitModule(stmts, 1);
+    EXPECT_EQ(ends.size(), stmts.size());
+
+    std::string joined;
+    std::size_t begin = 0;
+    for (auto end : ends) {
+        CodeGenFragment part;
+        CodeGen(code_gen_config, part).TraverseModulePart(*mod, stmts, begin, end);
+        joined += part.content.ToString();
+        begin = end;
+    }
+    EXPECT_EQ(joined, whole.content.ToString());
+    EXPECT_NE(joined.find("/* between */"), std::string::npos);
+    EXPECT_NE(joined.find("// last"), std::string::npos);
+}
+
+TEST(CodeGen, ModulePartsSynthesized) {
+    std::string src = "const a = 1;\n"
+                      "// before b\n"
+                      "const b = a;\n"
+                      "// last\n"
+                      "export { b };\n";
+
+    Config config = Config::Default();
+    AstContext ctx;
+    Parser parser(ctx, src, config);
+    auto mod = parser.ParseModule();
+
+    // the statements generated by the bundler have no range
+    auto synthesized = [&ctx](const std::string& name) {
+        auto stmt = ctx.Alloc<ExpressionStatement>();
+        stmt->expression = MakeId(ctx, name);
+        return stmt;
+    };
+    auto parsed = mod->body.to_vec();
+    std::vector<SyntaxNode*> stmts {
+        synthesized("x"), parsed[0], synthesized("y"), parsed[1], synthesized("z"), parsed[2],
+    };
+    mod->body.clear();
+    for (auto stmt : stmts) {
+        mod->body.push_back(stmt);
+    }
+
+    CodeGenConfig code_gen_config;
+    CodeGenFragment whole;
+    CodeGen(code_gen_config, whole).Traverse(*mod);
+
+    // split before the parsed ones only
+    auto ends = CodeGen::SplitModule(stmts, 1);
+    std::vector<std::size_t> expected_ends { 3, 5, 6 };
+    EXPECT_EQ(ends, expected_ends);
+
+    std::string joined;
+    std::size_t begin = 0;
+    for (auto end : ends) {
+        CodeGenFragment part;
+        CodeGen(code_gen_config, part).TraverseModulePart(*mod, stmts, begin, end);
+        joined += part.content.ToString();
+        begin = end;
+    }
+    EXPECT_EQ(joined, whole.content.ToString());
+    EXPECT_NE(joined.find("// before b"), std::string::npos);
+    EXPECT_NE(joined.find("// last"), std::string::npos);
+}
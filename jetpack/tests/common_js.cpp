@@ -13,6 +13,7 @@
 #include "SimpleAPI.h"
 
 #include "ModuleResolver.h"
+#include "utils/io/FileIO.h"
 
 using namespace jetpack;
 using namespace jetpack::parser;
@@ -31,7 +32,7 @@ inline std::string ParseAndCodeGen(std::string_view content) {
     code_gen_config.minify = false;
     CodeGen codegen(code_gen_config, fragment);
     codegen.Traverse(*mod);
-    return fragment.content;
+    return fragment.content.ToString();
 }
 
 TEST(CommonJS, HookParser) {
@@ -101,7 +102,7 @@ TEST(CommonJS, CodeGen) {
     CodeGenConfig code_gen_config;
     CodeGen codegen(code_gen_config, fragment);
     codegen.Traverse(*mod);
-    const auto& output = fragment.content;
+    auto output = fragment.content.ToString();
     EXPECT_EQ(output, "let require_foo = __commonJS(a => {\n"
                       "  a.name = function() {\n"
                       "    console.log('name');\n"
@@ -127,3 +128,29 @@ TEST(CommonJS, Complex) {
     flags |= JETPACK_TRACE_FILE;
     EXPECT_EQ(jetpack_bundle_module(entryPath.c_str(), outputPath.string().c_str(), static_cast<int>(flags), nullptr), 0);
 }
+
+/**
+ * the names of the require calls never take a global
+ */
+TEST(CommonJS, CallNames) {
+    ghc::filesystem::path path(JETPACK_TEST_RUNNING_DIR);
+    path.append("tests/fixtures/cjs_names/index.js");
+
+    ghc::filesystem::path output_path(JETPACK_BUILD_DIR);
+    output_path.append("cjs_names_bundle_test.js");
+
+    auto resolver = std::make_shared<ModuleResolver>();
+    parser::Config parser_config = parser::Config::Default();
+    parser_config.common_js = true;
+
+    CodeGenConfig codegen_config;
+    codegen_config.sourcemap = false;
+
+    resolver->BeginFromEntry(parser_config, path.string());
+    resolver->CodeGenAllModules(codegen_config, output_path.string());
+
+    std::string content;
+    EXPECT_EQ(io::ReadFileToStdString(output_path.string(), content), io::IOError::Ok);
+    EXPECT_NE(content.find("const lib = jp_require_0();"), std::string::npos);
+    EXPECT_NE(content.find("typeof jp_require)"), std::string::npos);
+}
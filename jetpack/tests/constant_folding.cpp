@@ -24,7 +24,7 @@ inline std::string CF_ParseAndCodeGen(std::string_view content) {
     CodeGenFragment fragment;
     CodeGen codegen(code_gen_config, fragment);
     codegen.Traverse(*mod);
-    return fragment.content;
+    return fragment.content.ToString();
 }
 
 TEST(ConstantFolding, AddString1) {
@@ -36,7 +36,7 @@ TEST(ConstantFolding, AddString1) {
 
 TEST(ConstantFolding, AddString2) {
     std::string src = "const a = 'aaa' + 'bbb' + 'ccc' + 'ddd' + 2;\n";
-    std::string expected = "const a = \"aaabbbcccddd\" + 2;\n";
+    std::string expected = "const a = \"aaabbbcccddd2\";\n";
 
     EXPECT_EQ(CF_ParseAndCodeGen(src), expected);
 }
@@ -54,3 +54,76 @@ TEST(ConstantFolding, Combite) {
 
     EXPECT_EQ(CF_ParseAndCodeGen(src), expected);
 }
+
+TEST(ConstantFolding, Arithmetic) {
+    std::string src = "const a = 7 % -3, b = 2 ** 10, c = 1 / 3, d = (1 + 2) * 3;\n";
+    std::string expected = "const a = 1, b = 1024, c = 1 / 3, d = 9;\n";
+
+    EXPECT_EQ(CF_ParseAndCodeGen(src), expected);
+}
+
+TEST(ConstantFolding, SpecialNumbers) {
+    std::string src = "const a = 0 * -1, b = 0 / 0 + 1, c = -1e308 * 10, d = 1e21 * 10;\n";
+    std::string expected = "const a = -0, b = 0 / 0, c = -1 / 0, d = 1e+22;\n";
+
+    EXPECT_EQ(CF_ParseAndCodeGen(src), expected);
+}
+
+TEST(ConstantFolding, Bitwise) {
+    std::string src = "const a = 1 << 31, b = -1 >>> 0, c = ~5, d = 5 & 3 | 8, e = 0x10 ^ 0o17;\n";
+    std::string expected = "const a = -2147483648, b = 4294967295, c = -6, d = 9, e = 31;\n";
+
+    EXPECT_EQ(CF_ParseAndCodeGen(src), expected);
+}
+
+TEST(ConstantFolding, Compare) {
+    std::string src = "const a = '10' < '9', b = 10 < 9, c = null == void 0, d = '1' == 1, e = 0 / 0 === 0 / 0;\n";
+    std::string expected = "const a = true, b = false, c = true, d = true, e = false;\n";
+
+    EXPECT_EQ(CF_ParseAndCodeGen(src), expected);
+}
+
+TEST(ConstantFolding, Unary) {
+    std::string src = "const a = typeof 1, b = !'', c = void 'x', d = - -1, e = +'0x1f';\n";
+    std::string expected = "const a = \"number\", b = true, c = void 0, d = 1, e = 31;\n";
+
+    EXPECT_EQ(CF_ParseAndCodeGen(src), expected);
+}
+
+TEST(ConstantFolding, Logical) {
+    std::string src = "const a = 0 || foo, b = 1 && bar, c = '' && baz;\n";
+    std::string expected = "const a = foo, b = bar, c = '';\n";
+
+    EXPECT_EQ(CF_ParseAndCodeGen(src), expected);
+}
+
+TEST(ConstantFolding, LogicalReference) {
+    std::string src = "(1 && obj.fn)();\n"
+                      "(0 ? a : obj.fn)`x`;\n"
+                      "(1 && fn)();\n"
+                      "typeof (1 && undeclared);\n"
+                      "delete (1 && obj.prop);\n"
+                      "const a = 1 && obj.fn;\n";
+    std::string expected = "(0, obj.fn)();\n"
+                           "(0, obj.fn)`x`;\n"
+                           "fn();\n"
+                           "typeof (1 && undeclared);\n"
+                           "delete (1 && obj.prop);\n"
+                           "const a = obj.fn;\n";
+
+    EXPECT_EQ(CF_ParseAndCodeGen(src), expected);
+}
+
+TEST(ConstantFolding, NumberToString) {
+    std::string src = "const a = '' + 1 / 8, b = '' + 1e-7, c = 'x' + 2 ** 69, d = '' + 2 ** 70;\n";
+    std::string expected = "const a = \"0.125\", b = \"1e-7\", c = \"x590295810358705700000\", d = \"1.1805916207174113e+21\";\n";
+
+    EXPECT_EQ(CF_ParseAndCodeGen(src), expected);
+}
+
+TEST(ConstantFolding, TemplateLiteral) {
+    std::string src = "const a = `x${1 + 1}y${b}z${'`'}`, c = `a${'b'}${1}`;\n";
+    std::string expected = "const a = `x2y${b}z\\``, c = \"ab1\";\n";
+
+    EXPECT_EQ(CF_ParseAndCodeGen(src), expected);
+}
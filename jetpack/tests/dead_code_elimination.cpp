@@ -0,0 +1,236 @@
+//
+// Created by Duzhong Chen on 2021/11/25.
+//
+
+#include <gtest/gtest.h>
+#include <parser/Parser.hpp>
+
+#include "optimize/DeadCodeElimination.h"
+#include "optimize/Defines.h"
+#include "optimize/DefineSubstitution.h"
+#include "codegen/CodeGen.h"
+
+using namespace jetpack;
+using namespace jetpack::parser;
+
+inline std::string DCE_ParseAndCodeGen(std::string_view content, std::shared_ptr<const Defines> defines = nullptr,
+                                       bool common_js = false) {
+    Config config = Config::Default();
+    config.constant_folding = true;
+    config.defines = std::move(defines);
+    AstContext ctx;
+    Parser parser(ctx, content, config);
+    parser.Context()->is_common_js_ = common_js;
+
+    auto mod = parser.ParseModule();
+
+    std::vector<Identifier*> unresolved_ids;
+    mod->scope->ResolveAllSymbols(&unresolved_ids);
+
+    if (config.defines) {
+        DefineSubstitution substitution(ctx, *config.defines);
+        substitution.TraverseNode(mod);
+    }
+
+    DeadCodeElimination dce(ctx);
+    dce.TraverseNode(mod);
+
+    CodeGenConfig code_gen_config;
+    CodeGenFragment fragment;
+    CodeGen codegen(code_gen_config, fragment);
+    codegen.Traverse(*mod);
+    return fragment.content.ToString();
+}
+
+TEST(DeadCodeElimination, IfFalse) {
+    std::string src = "if (false) { a(); }\nb();\n";
+    std::string expected = "b();\n";
+
+    EXPECT_EQ(DCE_ParseAndCodeGen(src), expected);
+}
+
+TEST(DeadCodeElimination, IfElse) {
+    std::string src = "if (1 + 1 === 2) { a(); } else { b(); }\n"
+                      "if ('') a(); else if (0) b(); else c();\n";
+    std::string expected = "a();\n"
+                           "c();\n";
+
+    EXPECT_EQ(DCE_ParseAndCodeGen(src), expected);
+}
+
+TEST(DeadCodeElimination, KeepBlockScope) {
+    std::string src = "if (true) { let a = 1; }\n";
+    std::string expected = "{\n"
+                           "  let a = 1;\n"
+                           "}\n";
+
+    EXPECT_EQ(DCE_ParseAndCodeGen(src), expected);
+}
+
+TEST(DeadCodeElimination, HoistedVar) {
+    std::string src = "if (false) { var a = 1, [b, {c: d}] = e; let f = 2; }\n"
+                      "while (0) { var g = 3; }\n";
+    std::string expected = "var a, b, d;\n"
+                           "var g;\n";
+
+    EXPECT_EQ(DCE_ParseAndCodeGen(src), expected);
+}
+
+TEST(DeadCodeElimination, HoistedFunction) {
+    std::string src = "function a() {\n"
+                      "  if (false) { function g() {  } }\n"
+                      "  return g;\n"
+                      "}\n";
+    std::string sloppy = "function a() {\n"
+                         "  var g;\n"
+                         "  return g;\n"
+                         "}\n";
+    std::string strict = "function a() {\n"
+                         "  return g;\n"
+                         "}\n";
+
+    EXPECT_EQ(DCE_ParseAndCodeGen(src, nullptr, true), sloppy);
+    EXPECT_EQ(DCE_ParseAndCodeGen(src), strict);
+
+    // Annex B is not for the strict mode
+    std::string strict_module = "'use strict';\n" + src;
+    EXPECT_EQ(DCE_ParseAndCodeGen(strict_module, nullptr, true).find("var g"), std::string::npos);
+
+    std::string strict_function = "function a() {\n"
+                                  "  'use strict';\n"
+                                  "  if (false) { function g() {  } }\n"
+                                  "  return g;\n"
+                                  "}\n";
+    EXPECT_EQ(DCE_ParseAndCodeGen(strict_function, nullptr, true).find("var g"), std::string::npos);
+
+    std::string class_method = "class A {\n"
+                               "  f() {\n"
+                               "    if (false) { function g() {  } }\n"
+                               "    return g;\n"
+                               "  }\n"
+                               "}\n";
+    EXPECT_EQ(DCE_ParseAndCodeGen(class_method, nullptr, true).find("var g"), std::string::npos);
+}
+
+TEST(DeadCodeElimination, Unreachable) {
+    std::string src = "function f() {\n"
+                      "  return g();\n"
+                      "  h();\n"
+                      "  var a = 1;\n"
+                      "  function g() {  }\n"
+                      "}\n";
+    std::string expected = "function f() {\n"
+                           "  return g();\n"
+                           "  var a;\n"
+                           "  function g() {  }\n"
+                           "}\n";
+
+    EXPECT_EQ(DCE_ParseAndCodeGen(src), expected);
+}
+
+TEST(DeadCodeElimination, NestedIf) {
+    std::string src = "if (a) { if (false) b(); } else c();\n"
+                      "if (a) if (true) b(); else ; else c();\n";
+    std::string expected = "if (a) {} else c();\n"
+                           "if (a) b(); else c();\n";
+
+    EXPECT_EQ(DCE_ParseAndCodeGen(src), expected);
+}
+
+TEST(DeadCodeElimination, Conditional) {
+    std::string src = "const a = true ? b : c, d = null ? b : c;\n";
+    std::string expected = "const a = b, d = c;\n";
+
+    EXPECT_EQ(DCE_ParseAndCodeGen(src), expected);
+}
+
+TEST(DeadCodeElimination, Define) {
+    auto defines = std::make_shared<Defines>();
+    EXPECT_TRUE(defines->AddFromString("process.env.NODE_ENV=\"production\""));
+    EXPECT_TRUE(defines->AddFromString("__DEV__=false"));
+    EXPECT_FALSE(defines->AddFromString("DEBUG=a"));
+    EXPECT_FALSE(defines->AddFromString("DEBUG"));
+
+    std::string src = "if (process.env.NODE_ENV !== 'production') { checkProps(); }\n"
+                      "if (process.env.NODE_ENV === 'production') module.exports = a; else module.exports = b;\n"
+                      "const c = __DEV__ ? d : e, f = !__DEV__ && g;\n"
+                      "const h = process.env.NODE_ENV.length;\n";
+    std::string expected = "module.exports = a;\n"
+                           "const c = e, f = g;\n"
+                           "const h = (\"production\").length;\n";
+
+    EXPECT_EQ(DCE_ParseAndCodeGen(src, defines), expected);
+}
+
+TEST(DeadCodeElimination, DefineShadowed) {
+    auto defines = std::make_shared<Defines>();
+    EXPECT_TRUE(defines->AddFromString("process.env.NODE_ENV='production'"));
+
+    std::string src = "process.env.NODE_ENV = 'test';\n"
+                      "function f(process) {\n"
+                      "  return process.env.NODE_ENV;\n"
+                      "}\n";
+    std::string expected = "process.env.NODE_ENV = 'test';\n"
+                           "function f(process) {\n"
+                           "  return process.env.NODE_ENV;\n"
+                           "}\n";
+
+    EXPECT_EQ(DCE_ParseAndCodeGen(src, defines), expected);
+}
+
+TEST(DeadCodeElimination, DefineHoistedVar) {
+    auto defines = std::make_shared<Defines>();
+    EXPECT_TRUE(defines->AddFromString("DEBUG=true"));
+
+    std::string src = "function f() {\n"
+                      "  if (DEBUG) log();\n"
+                      "  var DEBUG = 0;\n"
+                      "}\n"
+                      "function g() {\n"
+                      "  if (!DEBUG) return;\n"
+                      "  log([DEBUG], { DEBUG });\n"
+                      "}\n";
+    std::string expected = "function f() {\n"
+                           "  if (DEBUG) log();\n"
+                           "  var DEBUG = 0;\n"
+                           "}\n"
+                           "function g() {\n"
+                           "  log([true], {\n"
+                           "    DEBUG: true\n"
+                           "  });\n"
+                           "}\n";
+
+    EXPECT_EQ(DCE_ParseAndCodeGen(src, defines), expected);
+}
+
+TEST(DeadCodeElimination, DefineAssignmentTarget) {
+    auto defines = std::make_shared<Defines>();
+    EXPECT_TRUE(defines->AddFromString("process.env.NODE_ENV='production'"));
+    EXPECT_TRUE(defines->AddFromString("DEBUG=false"));
+
+    std::string src = "({ a: process.env.NODE_ENV, b: DEBUG } = o);\n"
+                      "process.env.NODE_ENV = DEBUG;\n"
+                      "DEBUG += 1;\n"
+                      "for (process.env.NODE_ENV in o) {}\n";
+    std::string expected = "({ a: process.env.NODE_ENV, b: DEBUG } = o);\n"
+                           "process.env.NODE_ENV = false;\n"
+                           "DEBUG += 1;\n"
+                           "for (process.env.NODE_ENV in o) {}\n";
+
+    EXPECT_EQ(DCE_ParseAndCodeGen(src, defines), expected);
+}
+
+TEST(DeadCodeElimination, PureCall) {
+    std::string src = "/*#__PURE__*/ a();\n"
+                      "/* @__PURE__ */ new B(1, 'x', () => {});\n"
+                      "/*#__PURE__*/ c(d());\n"
+                      "/*#__PURE__*/ e.f().g();\n"
+                      "h();\n"
+                      "const i = /*#__PURE__*/ j();\n";
+    std::string expected = "/*#__PURE__*/ c(d());\n"
+                           "/*#__PURE__*/ e.f().g();\n"
+                           "h();\n"
+                           "const i = /*#__PURE__*/ j();\n";
+
+    EXPECT_EQ(DCE_ParseAndCodeGen(src), expected);
+}
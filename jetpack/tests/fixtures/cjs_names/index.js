@@ -0,0 +1,3 @@
+const lib = require('./lib');
+
+console.log(lib.name, typeof jp_require);
@@ -0,0 +1,11 @@
+export const DEBUG = false;
+export const LEVEL = 3;
+export const NAME = 'jetpack';
+export const MESSAGE = 'a string too long to be inlined';
+export let counter = 0;
+
+export function log(msg) {
+  if (DEBUG) {
+    console.log(NAME, msg);
+  }
+}
@@ -0,0 +1,2 @@
+export const VERSION = 2;
+export const SIZE = VERSION * 4;
@@ -0,0 +1,12 @@
+import { DEBUG, LEVEL as level, NAME, MESSAGE, log } from './flags';
+import * as flags from './flags2';
+import { LIMIT } from './reexport';
+import { MAX } from './limits';
+
+if (DEBUG) {
+  console.log('debug mode');
+}
+
+log(level * 2, { NAME }, MESSAGE, flags.VERSION, LIMIT);
+
+export { MAX };
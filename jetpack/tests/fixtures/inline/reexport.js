@@ -0,0 +1,3 @@
+import { LIMIT } from './limits';
+
+export { LIMIT };
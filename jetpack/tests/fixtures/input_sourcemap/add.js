@@ -0,0 +1,4 @@
+export function add(a, b) {
+    return a + b;
+}
+//# sourceMappingURL=add.js.map
@@ -0,0 +1,3 @@
+import { add } from './add';
+
+console.log(add(1, 2));
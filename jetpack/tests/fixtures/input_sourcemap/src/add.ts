@@ -0,0 +1,4 @@
+// compiled to add.js
+export function add(a: number, b: number): number {
+    return a + b;
+}
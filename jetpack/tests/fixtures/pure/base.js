@@ -0,0 +1,5 @@
+export class Base {
+  name() {
+    return 'base';
+  }
+}
@@ -0,0 +1,5 @@
+console.log('helper loaded');
+
+export function helper(value) {
+  return value;
+}
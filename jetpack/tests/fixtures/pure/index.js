@@ -0,0 +1,11 @@
+import { Widget } from './widget';
+import { helper } from './helper';
+import { used } from './used';
+import { palette } from './styles';
+
+const unused = /*#__PURE__*/ Widget.create();
+const alsoUnused = /*#__PURE__*/ helper(unused);
+
+used(palette);
+
+export { theme } from './styles';
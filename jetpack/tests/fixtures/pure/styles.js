@@ -0,0 +1,3 @@
+import { theme, palette } from './theme';
+
+export { theme, palette };
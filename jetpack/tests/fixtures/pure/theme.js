@@ -0,0 +1,2 @@
+export const theme = /*#__PURE__*/ createTheme();
+export const palette = /*#__PURE__*/ createPalette();
@@ -0,0 +1,7 @@
+import { Base } from './base';
+
+export var Widget = /*#__PURE__*/ function (Base) {
+  function Widget() {}
+  Widget.create = function () { return new Widget(); };
+  return Widget;
+}(Base);
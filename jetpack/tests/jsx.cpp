@@ -27,7 +27,7 @@ inline std::string ParseJSXAndCodeGen(std::string_view content) {
     CodeGenConfig code_gen_config;
     CodeGen codegen(code_gen_config, fragment);
     codegen.Traverse(*mod);
-    return fragment.content;
+    return fragment.content.ToString();
 }
 
 TEST(JSX, TranspileSimple1) {
@@ -3,8 +3,12 @@
 //
 #include <gtest/gtest.h>
 #include <iostream>
+#include <cstring>
+#include <filesystem.hpp>
 #include "parser/AstContext.h"
 #include "parser/SyntaxNodes.h"
+#include "utils/io/ChunkedBuffer.h"
+#include "utils/io/FileIO.h"
 
 using namespace jetpack;
 
@@ -37,3 +41,149 @@ TEST(Memroy, Delete) {
 
     EXPECT_EQ(on, true);
 }
+
+TEST(ChunkedBuffer, AcrossPages) {
+    io::ChunkedBuffer buffer;
+    EXPECT_TRUE(buffer.Empty());
+
+    std::string expected;
+    std::string line(1000, 'a');
+    for (int i = 0; i < 200; i++) {
+        line[0] = static_cast<char>('0' + i % 10);
+        buffer.Append(line);
+        buffer.Append(';');
+        expected += line;
+        expected += ';';
+    }
+
+    EXPECT_EQ(buffer.Size(), expected.size());
+    EXPECT_EQ(buffer.ToString(), expected);
+
+    // 1K, 2K, ..., 64K, 64K, ...
+    auto chunks = buffer.Chunks();
+    EXPECT_EQ(chunks[0].size(), io::ChunkedBuffer::MIN_PAGE_SIZE);
+    EXPECT_EQ(chunks[1].size(), io::ChunkedBuffer::MIN_PAGE_SIZE * 2);
+    EXPECT_EQ(chunks[chunks.size() - 2].size(), io::ChunkedBuffer::MAX_PAGE_SIZE);
+}
+
+TEST(ChunkedBuffer, Reserve) {
+    io::ChunkedBuffer buffer;
+    buffer.Append("abc");
+    buffer.Reserve(100000);
+    buffer.Append(std::string(100000, 'a'));
+
+    auto chunks = buffer.Chunks();
+    EXPECT_EQ(chunks.size(), 2);
+    EXPECT_EQ(chunks[0].size() + chunks[1].size(), 100003);
+
+    // enough already
+    io::ChunkedBuffer small;
+    small.Reserve(10);
+    small.Reserve(20);
+    small.Append(std::string(io::ChunkedBuffer::MIN_PAGE_SIZE, 'a'));
+    EXPECT_EQ(small.Chunks().size(), 1);
+}
+
+TEST(ChunkedBuffer, PopBack) {
+    io::ChunkedBuffer buffer;
+    buffer.Append(std::string(io::ChunkedBuffer::MIN_PAGE_SIZE - 1, 'a'));
+    buffer.Append(';');
+    buffer.Append('}');
+    EXPECT_EQ(buffer.Back(), '}');
+
+    buffer.PopBack();
+    EXPECT_EQ(buffer.Back(), ';');
+    buffer.PopBack();
+    EXPECT_EQ(buffer.Size(), io::ChunkedBuffer::MIN_PAGE_SIZE - 1);
+    buffer.Append("}}");
+
+    auto result = buffer.ToString();
+    EXPECT_EQ(result.size(), io::ChunkedBuffer::MIN_PAGE_SIZE + 1);
+    EXPECT_EQ(result.substr(result.size() - 3), "a}}");
+}
+
+TEST(FileWriter, GrowAndHint) {
+    std::string path = std::string(JETPACK_BUILD_DIR) + "/file_writer_test.txt";
+    std::string expected;
+    {
+        io::FileWriter writer(path);
+        EXPECT_EQ(writer.Open(), io::IOError::Ok);
+
+        // grown without a hint
+        for (int i = 0; i < 300000; i++) {
+            writer.Write("abc;", 4);
+            expected += "abc;";
+        }
+
+        // the hint is larger than the written size
+        writer.SizeHint(expected.size() * 4);
+        char* dest = writer.Extend(3);
+        ASSERT_NE(dest, nullptr);
+        std::memcpy(dest, "end", 3);
+        expected += "end";
+    }
+
+    std::string result;
+    EXPECT_EQ(io::ReadFileToStdString(path, result), io::IOError::Ok);
+    EXPECT_EQ(result, expected);
+}
+
+TEST(FileWriter, AtomicUnchanged) {
+    std::string path = std::string(JETPACK_BUILD_DIR) + "/atomic_writer_test.txt";
+    ghc::filesystem::remove(path);
+
+    auto write_file = [&path](const std::string& content) {
+        io::FileWriter writer(path, true);
+        EXPECT_EQ(writer.Open(), io::IOError::Ok);
+        writer.WriteS(content);
+        EXPECT_EQ(writer.Close(), io::IOError::Ok);
+        return writer.Unchanged();
+    };
+
+    EXPECT_FALSE(write_file("let a = 1;"));
+    auto mtime = ghc::filesystem::last_write_time(path);
+
+    EXPECT_TRUE(write_file("let a = 1;"));
+    EXPECT_EQ(ghc::filesystem::last_write_time(path), mtime);
+
+    EXPECT_FALSE(write_file("let a = 2;"));
+
+    std::string result;
+    EXPECT_EQ(io::ReadFileToStdString(path, result), io::IOError::Ok);
+    EXPECT_EQ(result, "let a = 2;");
+
+    // no temporary file is left
+    for (auto& entry : ghc::filesystem::directory_iterator(JETPACK_BUILD_DIR)) {
+        EXPECT_NE(entry.path().extension().string(), ".tmp");
+    }
+}
+
+TEST(FileWriter, AtomicNotCommitted) {
+    std::string path = std::string(JETPACK_BUILD_DIR) + "/atomic_writer_test.txt";
+    EXPECT_EQ(io::WriteBufferToPath(path, "let a = 1;", 10), io::IOError::Ok);
+
+    // destroyed without Close(), e.g. returned early
+    {
+        io::FileWriter writer(path, true);
+        EXPECT_EQ(writer.Open(), io::IOError::Ok);
+        writer.WriteS("let a = 2;");
+    }
+
+    std::string result;
+    EXPECT_EQ(io::ReadFileToStdString(path, result), io::IOError::Ok);
+    EXPECT_EQ(result, "let a = 1;");
+
+    // the error is kept, nothing is committed
+    std::string missing = std::string(JETPACK_BUILD_DIR) + "/no_such_dir/atomic_writer_test.txt";
+    {
+        io::FileWriter writer(missing, true);
+        EXPECT_EQ(writer.Open(), io::IOError::OpenFailed);
+        EXPECT_EQ(writer.WriteS("let a = 2;"), io::IOError::OpenFailed);
+        EXPECT_EQ(writer.Close(), io::IOError::OpenFailed);
+    }
+    EXPECT_FALSE(ghc::filesystem::exists(missing));
+
+    for (auto& entry : ghc::filesystem::directory_iterator(JETPACK_BUILD_DIR)) {
+        EXPECT_NE(entry.path().extension().string(), ".tmp");
+    }
+}
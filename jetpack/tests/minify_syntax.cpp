@@ -0,0 +1,119 @@
+//
+// Created by Duzhong Chen on 2021/11/30.
+//
+
+#include <gtest/gtest.h>
+#include <parser/Parser.hpp>
+
+#include "optimize/PassManager.h"
+#include "optimize/MinifyLiterals.h"
+#include "optimize/MinifySyntax.h"
+#include "codegen/CodeGen.h"
+
+using namespace jetpack;
+using namespace jetpack::parser;
+
+inline std::string MS_ParseAndCodeGen(std::string_view content) {
+    Config config = Config::Default();
+    AstContext ctx;
+    Parser parser(ctx, content, config);
+
+    auto mod = parser.ParseModule();
+    mod->scope->ResolveAllSymbols(nullptr);
+
+    PassManager passes;
+    passes.AddPass([](AstContext& ctx) {
+        return std::make_unique<MinifyLiterals>(ctx);
+    });
+    passes.AddPass([](AstContext& ctx) {
+        return std::make_unique<MinifySyntax>(ctx);
+    });
+    passes.Run(ctx, mod);
+
+    CodeGenConfig code_gen_config;
+    code_gen_config.minify = true;
+    code_gen_config.comments = false;
+    CodeGenFragment fragment;
+    CodeGen codegen(code_gen_config, fragment);
+    codegen.Traverse(*mod);
+    return fragment.content.ToString();
+}
+
+TEST(MinifySyntax, MergeStatements) {
+    std::string src = "var a = 1; var b = 2; let c = 3; let d = 4;\n"
+                      "e(); f();\n";
+    std::string expected = "var a=1,b=2;let c=3,d=4;e(),f();";
+
+    EXPECT_EQ(MS_ParseAndCodeGen(src), expected);
+}
+
+TEST(MinifySyntax, IfToExpression) {
+    std::string src = "if (a) b();\n"
+                      "if (!a) { c(); }\n"
+                      "if (a) { b(); } else { c(); }\n";
+    std::string expected = "a&&b(),a||c(),a?b():c();";
+
+    EXPECT_EQ(MS_ParseAndCodeGen(src), expected);
+}
+
+TEST(MinifySyntax, Return) {
+    std::string src = "function f() { a(); if (b) { return 1; } else { return 2; } }\n"
+                      "function g() { if (a) return 1; return 2; }\n"
+                      "function h() { if (a) return undefined; b(); return; }\n"
+                      "const i = () => { return { a: 1 }; };\n";
+    std::string expected = "function f(){return a(),b?1:2}"
+                           "function g(){return a?1:2}"
+                           "function h(){if(a)return;b()}"
+                           "const i=()=>({a:1});";
+
+    EXPECT_EQ(MS_ParseAndCodeGen(src), expected);
+}
+
+TEST(MinifySyntax, Braces) {
+    std::string src = "for (;;) { if (a) { b(); c(); } }\n"
+                      "if (a) { while (b) if (c) break; } else { d(); }\n"
+                      "{ let e = 1; }\n";
+    std::string expected = "for(;;)a&&(b(),c());"
+                           "if(a){while(b)if(c)break}else d();"
+                           "{let e=1}";
+
+    EXPECT_EQ(MS_ParseAndCodeGen(src), expected);
+}
+
+TEST(MinifySyntax, Semicolons) {
+    std::string src = "function f() { a(); while (b); }\n"
+                      "switch (a) { case 1: b(); break; default: c(); }\n";
+    std::string expected = "function f(){a();while(b);}"
+                           "switch(a){case 1:b();break;default:c()}";
+
+    EXPECT_EQ(MS_ParseAndCodeGen(src), expected);
+}
+
+TEST(MinifySyntax, Literals) {
+    std::string src = "x = { 'a': 1, 'b-c': 2, '1': 3, '01': 4 };\n"
+                      "y = x['a'] + 0.5 + 1000 + 0x10 + 1.50 + 0.0001;\n"
+                      "z = x['1'] + x['01'] + x['1e3'] + x['-1'];\n";
+    std::string expected = "x={a:1,'b-c':2,1:3,'01':4},y=x.a+.5+1e3+16+1.5+1e-4,"
+                           "z=x[1]+x['01']+x['1e3']+x['-1'];";
+
+    EXPECT_EQ(MS_ParseAndCodeGen(src), expected);
+}
+
+TEST(MinifySyntax, ShortestNumber) {
+    EXPECT_EQ(MinifyLiterals::ShortestNumber(0.25), ".25");
+    EXPECT_EQ(MinifyLiterals::ShortestNumber(100), "100");
+    EXPECT_EQ(MinifyLiterals::ShortestNumber(123000), "123e3");
+    EXPECT_EQ(MinifyLiterals::ShortestNumber(0.000012), "12e-6");
+    EXPECT_EQ(MinifyLiterals::ShortestNumber(1e21), "1e21");
+}
+
+TEST(MinifySyntax, DirectivePrologue) {
+    std::string src = "function r() { \"use strict\"; return this; }\n"
+                      "function s() { 'use strict'; 'use asm'; a(); b(); }\n"
+                      "function t() { { 'x'; } a(); }\n";
+    std::string expected = "function r(){\"use strict\";return this}"
+                           "function s(){'use strict';'use asm';a(),b()}"
+                           "function t(){{'x'}a()}";
+
+    EXPECT_EQ(MS_ParseAndCodeGen(src), expected);
+}
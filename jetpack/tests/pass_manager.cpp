@@ -0,0 +1,127 @@
+//
+// Created by Duzhong Chen on 2021/11/29.
+//
+
+#include <gtest/gtest.h>
+#include <parser/Parser.hpp>
+
+#include "optimize/PassManager.h"
+#include "optimize/DeadCodeElimination.h"
+#include "optimize/MinifyLiterals.h"
+#include "codegen/CodeGen.h"
+
+using namespace jetpack;
+using namespace jetpack::parser;
+
+/**
+ * Count the identifiers, the functions are skipped if `skip_functions`.
+ */
+class IdentifierCounter: public Pass {
+public:
+    IdentifierCounter(int32_t& count, bool skip_functions):
+    count_(count), skip_functions_(skip_functions) {}
+
+    [[nodiscard]]
+    const char* Name() const override {
+        return "Identifier counter";
+    }
+
+    [[nodiscard]]
+    bool Visits(SyntaxNodeType type) const override {
+        return type == SyntaxNodeType::Identifier || type == SyntaxNodeType::FunctionExpression;
+    }
+
+    bool TraverseBefore(Identifier* node) override {
+        count_++;
+        return true;
+    }
+
+    bool TraverseBefore(FunctionExpression* node) override {
+        return !skip_functions_;
+    }
+
+private:
+    int32_t& count_;
+    bool skip_functions_;
+
+};
+
+inline std::string PM_ParseAndCodeGen(std::string_view content, const PassManager& passes, int32_t* rounds = nullptr) {
+    Config config = Config::Default();
+    config.constant_folding = true;
+    AstContext ctx;
+    Parser parser(ctx, content, config);
+
+    auto mod = parser.ParseModule();
+    mod->scope->ResolveAllSymbols(nullptr);
+
+    auto result = passes.Run(ctx, mod);
+    if (rounds != nullptr) {
+        *rounds = result;
+    }
+
+    CodeGenConfig code_gen_config;
+    CodeGenFragment fragment;
+    CodeGen codegen(code_gen_config, fragment);
+    codegen.Traverse(*mod);
+    return fragment.content.ToString();
+}
+
+TEST(PassManager, Fused) {
+    PassManager passes;
+    passes.AddPass([](AstContext& ctx) {
+        return std::make_unique<DeadCodeElimination>(ctx);
+    });
+    passes.AddPass([](AstContext& ctx) {
+        return std::make_unique<MinifyLiterals>(ctx);
+    });
+
+    std::string src = "if (false) { a(true); } else { b(false); }\n"
+                      "x = undefined;\n"
+                      "function f(undefined) {\n"
+                      "  return undefined;\n"
+                      "}\n"
+                      "true.toString();\n";
+    std::string expected = "b(!1);\n"
+                           "x = void 0;\n"
+                           "function f(undefined) {\n"
+                           "  return undefined;\n"
+                           "}\n"
+                           "(!0).toString();\n";
+
+    EXPECT_EQ(PM_ParseAndCodeGen(src, passes), expected);
+}
+
+TEST(PassManager, SkipChildren) {
+    int32_t all = 0;
+    int32_t outside = 0;
+
+    PassManager passes;
+    passes.AddPass([&all](AstContext& ctx) {
+        return std::make_unique<IdentifierCounter>(all, false);
+    });
+    passes.AddPass([&outside](AstContext& ctx) {
+        return std::make_unique<IdentifierCounter>(outside, true);
+    });
+
+    PM_ParseAndCodeGen("a(b, function() { return c + d; });\n", passes);
+
+    // the other pass still walks into the function
+    EXPECT_EQ(all, 4);
+    EXPECT_EQ(outside, 2);
+}
+
+TEST(PassManager, FixedPoint) {
+    PassManager passes;
+    passes.AddPass([](AstContext& ctx) {
+        return std::make_unique<DeadCodeElimination>(ctx);
+    });
+    passes.SetFixedPoint(true);
+
+    int32_t rounds = 0;
+    EXPECT_EQ(PM_ParseAndCodeGen("if (false) a();\nb();\n", passes, &rounds), "b();\n");
+    EXPECT_EQ(rounds, 2);
+
+    EXPECT_EQ(PM_ParseAndCodeGen("b();\n", passes, &rounds), "b();\n");
+    EXPECT_EQ(rounds, 1);
+}
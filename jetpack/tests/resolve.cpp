@@ -10,6 +10,7 @@
 #include "codegen/CodeGen.h"
 #include "UniqueNameGenerator.h"
 #include "ModuleResolver.h"
+#include "utils/io/FileIO.h"
 
 using namespace jetpack;
 using namespace jetpack::parser;
@@ -30,6 +31,25 @@ TEST(MinifyNameGenerator, Next) {
     }
 }
 
+/**
+ * reserved names are never generated
+ */
+TEST(MinifyNameGenerator, Reserved) {
+    auto reserved = std::make_shared<UnresolvedNameCollector>();
+    reserved->Insert("q");
+    reserved->Insert("e");
+    reserved->Insert("window");
+
+    EXPECT_TRUE(reserved->Contains("q"));
+    EXPECT_TRUE(reserved->Contains("window"));
+    EXPECT_FALSE(reserved->Contains("w"));
+    EXPECT_FALSE(reserved->Contains(""));
+
+    auto gen = MinifyNameGenerator::Make(reserved);
+    EXPECT_EQ(*gen->Next(""), "w");
+    EXPECT_EQ(*gen->Next(""), "r");
+}
+
 inline std::string ReplaceDefault(std::string_view src) {
     auto resolver = std::make_shared<ModuleResolver>();
     auto mod = std::make_shared<ModuleFile>("memory0", -1);
@@ -47,7 +67,7 @@ inline std::string ReplaceDefault(std::string_view src) {
     CodeGen codegen(code_gen_config, fragment);
     codegen.Traverse(*mod->ast);
 
-    return fragment.content;
+    return fragment.content.ToString();
 }
 
 TEST(ModuleResolver, HandleExportDefault) {
@@ -150,7 +170,7 @@ TEST(ModuleResolver, SingleMemoryFile) {
     CodeGen codegen(codegen_config, fragment);
     codegen.Traverse(*entry_mod->ast);
 
-    std::cout << fragment.content << std::endl;
+    std::cout << fragment.content.ToString() << std::endl;
 }
 
 //TEST(ModuleResolver, HandleExportDefaultLiteral4) {
@@ -166,3 +186,70 @@ TEST(ModuleResolver, SingleMemoryFile) {
 //
 //    std::cout << result << std::endl;
 //}
+
+/**
+ * bundle the fixture with constant folding, return the content
+ */
+static std::string BundleFixture(const std::string& name) {
+    ghc::filesystem::path path(JETPACK_TEST_RUNNING_DIR);
+    path.append("tests/fixtures/" + name + "/index.js");
+
+    ghc::filesystem::path output_path(JETPACK_BUILD_DIR);
+    output_path.append(name + "_bundle_test.js");
+
+    auto resolver = std::make_shared<ModuleResolver>();
+    parser::Config parser_config = parser::Config::Default();
+    parser_config.constant_folding = true;
+
+    CodeGenConfig codegen_config;
+    codegen_config.sourcemap = false;
+
+    resolver->SetTraceFile(true);
+    resolver->BeginFromEntry(parser_config, path.string());
+    resolver->CodeGenAllModules(codegen_config, output_path.string());
+
+    std::string content;
+    EXPECT_EQ(io::ReadFileToStdString(output_path.string(), content), io::IOError::Ok);
+    return content;
+}
+
+TEST(ModuleResolver, InlineConstants) {
+    std::string content = BundleFixture("inline");
+
+    // the branches are eliminated across modules
+    EXPECT_EQ(content.find("debug mode"), std::string::npos);
+    EXPECT_EQ(content.find("console.log(NAME"), std::string::npos);
+    EXPECT_NE(content.find("log(6, {\n  NAME: \"jetpack\"\n}, MESSAGE, flags.VERSION, 10);"), std::string::npos);
+
+    // unused declarations are dropped, except the module imported by namespace
+    EXPECT_EQ(content.find("DEBUG"), std::string::npos);
+    EXPECT_EQ(content.find("LEVEL"), std::string::npos);
+    EXPECT_NE(content.find("const MESSAGE = 'a string too long to be inlined';"), std::string::npos);
+    EXPECT_NE(content.find("let counter = 0;"), std::string::npos);
+    EXPECT_NE(content.find("const VERSION = 2;"), std::string::npos);
+    EXPECT_NE(content.find("const SIZE = 8;"), std::string::npos);
+
+    // inlined through the re-export, and the one exported by the bundle is kept
+    EXPECT_EQ(content.find("LIMIT"), std::string::npos);
+    EXPECT_NE(content.find("const MAX = 20;"), std::string::npos);
+    EXPECT_NE(content.find("export { MAX };"), std::string::npos);
+}
+
+TEST(ModuleResolver, ShakePureDeclarations) {
+    std::string content = BundleFixture("pure");
+
+    // the unused pure declarations are dropped, and the modules only they import
+    EXPECT_EQ(content.find("unused"), std::string::npos);
+    EXPECT_EQ(content.find("Widget"), std::string::npos);
+    EXPECT_EQ(content.find("class Base"), std::string::npos);
+
+    // the module with side effects is kept
+    EXPECT_NE(content.find("console.log('helper loaded');"), std::string::npos);
+    EXPECT_NE(content.find("function used() {"), std::string::npos);
+
+    // imported or exported by the bundle through a re-export
+    EXPECT_NE(content.find("const theme = /*#__PURE__*/ createTheme();"), std::string::npos);
+    EXPECT_NE(content.find("const palette = /*#__PURE__*/ createPalette();"), std::string::npos);
+    EXPECT_NE(content.find("used(palette);"), std::string::npos);
+    EXPECT_NE(content.find("export { theme };"), std::string::npos);
+}
@@ -8,6 +8,7 @@
 #include <parser/Parser.hpp>
 
 #include "codegen/CodeGen.h"
+#include "scope/SlotAllocator.h"
 
 using namespace jetpack;
 using namespace jetpack::parser;
@@ -22,7 +23,7 @@ inline std::string GenCode(Module* mod) {
     CodeGenFragment fragment;
     CodeGen codegen(code_gen_config, fragment);
     codegen.Traverse(*mod);
-    return fragment.content;
+    return fragment.content.ToString();
 }
 
 TEST(Scope, Collect) {
@@ -249,7 +250,8 @@ TEST(Scope, RenameImport3) {
     auto first_spec = dynamic_cast<ImportSpecifier*>(import_decl->specifiers[0]);
     EXPECT_NE(import_decl, nullptr);
 
-    EXPECT_EQ(first_spec->local->name, "p");
+    EXPECT_EQ(first_spec->local->GetName(), "p");
+    EXPECT_EQ(first_spec->local->name, "a");  // original name is kept
 }
 
 TEST(Scope, RenameImportDefault) {
@@ -321,3 +323,83 @@ TEST(Scope, RenameExport2) {
 
     EXPECT_EQ(GenCode(mod), expected);
 }
+
+inline std::string AllocateAndGenCode(std::string_view src) {
+    AstContext ctx;
+    auto mod = ParseString(ctx, src);
+
+    std::vector<Identifier*> unresolved_ids;
+    mod->scope->ResolveAllSymbols(&unresolved_ids);
+
+    auto id_logger = std::make_shared<UnresolvedNameCollector>();
+    id_logger->InsertByList(unresolved_ids);
+
+    SlotAllocator allocator(id_logger);
+    allocator.RenameInnerScopes(*mod->scope);
+
+    return GenCode(mod);
+}
+
+TEST(Scope, SlotAllocatorSiblings) {
+    auto src = "function f1() { let first = 1; return first; }\n"
+               "function f2() { let second = 2; return second; }\n";
+
+    std::string expected = "function f1() {\n"
+                           "  let q = 1;\n"
+                           "  return q;\n"
+                           "}\n"
+                           "function f2() {\n"
+                           "  let q = 2;\n"
+                           "  return q;\n"
+                           "}\n";
+
+    EXPECT_EQ(AllocateAndGenCode(src), expected);
+}
+
+TEST(Scope, SlotAllocatorThrough) {
+    auto src = "function f1(outer) { function f2() { let inner = 1; return inner + outer; } return f2; }\n";
+
+    std::string expected = "function f1(w) {\n"
+                           "  function q() {\n"
+                           "    let q = 1;\n"
+                           "    return q + w;\n"
+                           "  }\n"
+                           "  return q;\n"
+                           "}\n";
+
+    EXPECT_EQ(AllocateAndGenCode(src), expected);
+}
+
+TEST(Scope, SlotAllocatorUnresolved) {
+    auto src = "function f1(param) { return q + param; }\n";
+
+    std::string expected = "function f1(w) {\n"
+                           "  return q + w;\n"
+                           "}\n";
+
+    EXPECT_EQ(AllocateAndGenCode(src), expected);
+}
+
+TEST(Scope, SlotAllocatorLabels) {
+    // the labels are not variables, the declarations after them are renamed
+    auto src = "function f1(param) { loop: for (;;) { if (param) break loop; continue loop; } function after() {} return after; }\n"
+               "function f2(p) { p: { break p; } return p; }\n";
+
+    std::string expected = "function f1(w) {\n"
+                           "  loop: for (; ; ) {\n"
+                           "    if (w) break loop;\n"
+                           "    continue loop;\n"
+                           "  }\n"
+                           "  function q() {  }\n"
+                           "  return q;\n"
+                           "}\n"
+                           "function f2(q) {\n"
+                           "  p: {\n"
+                           "    break p;\n"
+                           "  }\n"
+                           "  return q;\n"
+                           "}\n";
+
+    EXPECT_EQ(AllocateAndGenCode(src), expected);
+}
+
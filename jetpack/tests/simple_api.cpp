@@ -3,9 +3,59 @@
 //
 
 #include <gtest/gtest.h>
+#include <filesystem.hpp>
 #include "SimpleAPI.h"
+#include "utils/io/FileIO.h"
 
 TEST(SimpleAPI, FileNotExist) {
     JetpackFlags flags;
     EXPECT_NE(jetpack_bundle_module("wonderful", "ok", static_cast<int>(flags), nullptr), 0);
 }
+
+TEST(SimpleAPI, MinifyShorthandProperty) {
+    auto result = jetpack_parse_and_codegen("function f() { const abc = g(); return { abc }; }\nexport { f };\n", JETPACK_MINIFY);
+    ASSERT_NE(result, nullptr);
+    EXPECT_STREQ(result, "function w(){const q=g();return {abc:q}}export {w as f};");
+    jetpack_free_string(result);
+}
+
+TEST(SimpleAPI, NoSourcemapFile) {
+    ghc::filesystem::path entry_path(JETPACK_TEST_RUNNING_DIR);
+    entry_path.append("tests/fixtures/inline/index.js");
+
+    ghc::filesystem::path out_path(JETPACK_BUILD_DIR);
+    out_path.append("no_sourcemap_test.js");
+    ghc::filesystem::path map_path = out_path.string() + ".map";
+    ghc::filesystem::remove(map_path);
+
+    JetpackFlags flags;
+    flags |= JETPACK_TRACE_FILE;
+    EXPECT_EQ(jetpack_bundle_module(entry_path.string().c_str(), out_path.string().c_str(),
+                                    static_cast<int>(flags), nullptr), 0);
+    EXPECT_TRUE(ghc::filesystem::exists(out_path));
+    EXPECT_FALSE(ghc::filesystem::exists(map_path));
+}
+
+TEST(SimpleAPI, InvalidMangleOptions) {
+    ghc::filesystem::path entry_path(JETPACK_TEST_RUNNING_DIR);
+    entry_path.append("tests/fixtures/inline/index.js");
+
+    ghc::filesystem::path out_path(JETPACK_BUILD_DIR);
+    out_path.append("mangle_options_test.js");
+
+    jetpack::BundleOptions options;
+    options.mangle_props = "_(";
+    EXPECT_NE(jetpack::BundleModule(entry_path.string().c_str(), out_path.string().c_str(),
+                                    JETPACK_MINIFY, nullptr, options), 0);
+
+    ghc::filesystem::path cache_path(JETPACK_BUILD_DIR);
+    cache_path.append("mangle_options_cache.json");
+    std::string corrupted = "{ \"props\": ";
+    ASSERT_EQ(jetpack::io::WriteBufferToPath(cache_path.string(), corrupted.c_str(), corrupted.size()),
+              jetpack::io::IOError::Ok);
+
+    options.mangle_props = "^_";
+    options.name_cache = cache_path.string();
+    EXPECT_NE(jetpack::BundleModule(entry_path.string().c_str(), out_path.string().c_str(),
+                                    JETPACK_MINIFY, nullptr, options), 0);
+}
@@ -6,19 +6,24 @@
 #include <parser/ParserContext.h>
 #include <ThreadPool.h>
 #include <filesystem.hpp>
+#include <algorithm>
+#include <set>
 #include "sourcemap/SourceMapGenerator.h"
 #include "sourcemap/SourceMapDecoder.h"
+#include "sourcemap/InputSourceMap.h"
 #include "codegen/CodeGen.h"
 #include "ModuleResolver.h"
 #include "ModuleCompositor.h"
 #include "SimpleAPI.h"
 #include "utils/io/FileIO.h"
+#include "utils/JetJSON.h"
 
 using namespace jetpack;
 using namespace jetpack::parser;
 
-inline std::string ParseAndGenSourceMap(const std::string& content, bool print) {
+inline std::string ParseAndGenSourceMap(const std::string& content, bool print, bool lines_only = false) {
     auto resolver = std::make_shared<ModuleResolver>();
+    resolver->SetSourcesContent(!lines_only);
     Config config = Config::Default();
     resolver->BeginFromEntryString(config, content);
 
@@ -28,6 +33,7 @@ inline std::string ParseAndGenSourceMap(const std::string& content, bool print)
 
     CodeGenConfig codegen_config;
     codegen_config.sourcemap = true;
+    codegen_config.sourcemap_lines = lines_only;
     std::string bundle;
     io::StringWriter bundle_writer(bundle);
     ModuleCompositor module_compositor(bundle_writer, codegen_config);
@@ -38,7 +44,7 @@ inline std::string ParseAndGenSourceMap(const std::string& content, bool print)
         auto mod = resolver->GetEntryModule();
         CodeGen codegen(codegen_config, fragment);
         codegen.Traverse(*mod->ast);
-        module_compositor.Append(fragment);
+        module_compositor.Append(std::move(fragment));
     }
 
     auto fut = module_compositor.DumpSourcemap(sourcemap_generator);
@@ -104,6 +110,14 @@ TEST(SourceMap, Decode) {
 
     auto vec = decoding_vlq("D");
     EXPECT_EQ(vec[0], -1);
+
+    // the values begin with digits, '+' and '/'
+    for (int i = -100000; i <= 100000; i += 7) {
+        std::string vlq;
+        io::StringWriter writer(vlq);
+        SourceMapGenerator::IntToVLQ(writer, i);
+        EXPECT_EQ(SourceMapGenerator::VLQToInt(vlq.c_str(), next), i);
+    }
 }
 
 TEST(SourceMap, Simple) {
@@ -133,6 +147,55 @@ TEST(SourceMap, Simple) {
     }
 }
 
+TEST(SourceMap, LinesOnly) {
+    std::string src(""
+                "function main() {\n"
+                "    console.log('hello world');\n"
+                "    return 'a' + 'b';\n"
+                "}\n"
+    );
+    auto full_json = nlohmann::json::parse(ParseAndGenSourceMap(src, false));
+    auto lines_json = nlohmann::json::parse(ParseAndGenSourceMap(src, false, true));
+    EXPECT_TRUE(full_json.contains("sourcesContent"));
+    EXPECT_FALSE(lines_json.contains("sourcesContent"));
+
+    SourceMapDecoder full_decoder(full_json);
+    auto full_result = full_decoder.Decode();
+    SourceMapDecoder lines_decoder(lines_json);
+    auto lines_result = lines_decoder.Decode();
+
+    // the first mapping of each line is kept
+    std::vector<SourceMapDecoder::ResultMapping> expect_mappings;
+    for (const auto& mapping : full_result.content) {
+        if (expect_mappings.empty() || expect_mappings.back().after_line != mapping.after_line) {
+            expect_mappings.push_back(mapping);
+        }
+    }
+    EXPECT_GT(full_result.content.size(), expect_mappings.size());
+    ASSERT_EQ(lines_result.content.size(), expect_mappings.size());
+    for (uint32_t i = 0; i < expect_mappings.size(); i++) {
+        EXPECT_EQ(lines_result.content[i], expect_mappings[i]);
+    }
+}
+
+TEST(SourceMap, EscapeSourcesContent) {
+    // the escapes are placed across the 16 bytes blocks
+    std::string src;
+    for (uint32_t i = 0; i < 3000; i++) {
+        src += std::string(i % 37, 'a');
+        src += "\"\\/\n\t\x01\x1f\x7f\xe4\xbd\xa0";
+        src += static_cast<char>(i % 32);
+    }
+
+    auto escaped = EscapeJSONString(src);
+    EXPECT_EQ(nlohmann::json::parse("\"" + escaped + "\"").get<std::string>(), src);
+
+    std::string streamed;
+    io::StringWriter writer(streamed);
+    EXPECT_EQ(EscapeJSONString(src, writer), io::IOError::Ok);
+    EXPECT_EQ(streamed, escaped);
+}
+
 TEST(SourceMap, Complex) {
     ghc::filesystem::path path(JETPACK_TEST_RUNNING_DIR);
     path.append("tests/fixtures/sourcemap/index.js");
@@ -188,3 +251,274 @@ TEST(SourceMap, Complex) {
         EXPECT_EQ(expect_mappings[i], result.content[i]);
     }
 }
+
+TEST(SourceMap, CompositorOffsets) {
+    CodeGenConfig codegen_config;
+    codegen_config.sourcemap = true;
+    std::string bundle;
+    io::StringWriter bundle_writer(bundle);
+    ModuleCompositor module_compositor(bundle_writer, codegen_config);
+
+    // large enough to be written in parallel
+    std::string expected;
+    std::vector<CodeGenFragment> fragments(4);
+    std::vector<SourceMapDecoder::ResultMapping> expect_mappings;
+    int32_t line = 1;
+    int32_t column = 0;
+    SourceLocation loc(0, Position(1, 0), Position(1, 1));
+    for (std::size_t i = 0; i < fragments.size(); i++) {
+        auto& fragment = fragments[i];
+        std::string content = "a" + std::to_string(i) + ";\n";
+        for (int j = 0; j < 100000; j++) {
+            fragment.content.Append(content);
+        }
+        fragment.content.Append("b;");
+        fragment.line = 100001;
+        fragment.column = 2;
+        fragment.names.push_back("b");
+        fragment.mapping_items.emplace_back(loc, 1, 0);
+        fragment.mapping_items.emplace_back(loc, 100001, 0, 0);
+        expected += fragment.content.ToString();
+
+        expect_mappings.push_back({ 0, 1, 0, line, column });
+        expect_mappings.push_back({ 0, 1, 0, line + 100000, 0, static_cast<int32_t>(i) });
+        line += 100000;
+        column = 4;
+
+        // the others are encoded by the generator
+        if (i % 2 == 0) {
+            SourceMapGenerator::EncodeFragment(fragment);
+        }
+
+        module_compositor.Append(fragments[i]);
+        module_compositor.Write("c;");
+        expected += "c;";
+
+        // the next one begins in the middle of the line
+        if (i % 2 == 1) {
+            module_compositor.WriteLineEnd();
+            expected += "\n";
+            line++;
+            column = 0;
+        }
+    }
+
+    EXPECT_EQ(module_compositor.Finish(), io::IOError::Ok);
+    EXPECT_EQ(bundle, expected);
+
+    std::string sourcemap;
+    io::StringWriter sourcemap_writer(sourcemap);
+    auto sourcemap_generator = std::make_shared<SourceMapGenerator>(nullptr, sourcemap_writer, "memory0");
+    module_compositor.DumpSourcemap(sourcemap_generator).wait();
+
+    auto sourcemap_json = nlohmann::json::parse(sourcemap);
+    EXPECT_EQ(sourcemap_json["names"].size(), fragments.size());
+
+    SourceMapDecoder decoder(sourcemap_json);
+    auto result = decoder.Decode();
+    ASSERT_EQ(result.content.size(), expect_mappings.size());
+    for (uint32_t i = 0; i < expect_mappings.size(); i++) {
+        EXPECT_EQ(result.content[i], expect_mappings[i]) << result.content[i].ToString();
+    }
+}
+
+TEST(SourceMap, Names) {
+    CodeGenConfig codegen_config;
+    codegen_config.sourcemap = true;
+    std::string bundle;
+    io::StringWriter bundle_writer(bundle);
+    ModuleCompositor module_compositor(bundle_writer, codegen_config);
+
+    SourceLocation loc(0, Position(1, 4), Position(1, 7));
+    std::vector<CodeGenFragment> fragments(2);
+    {
+        MappingCollector collector(fragments[0]);
+        collector.AddMapping("foo", loc, 0);
+        collector.AddMapping("bar", loc, 2);
+        collector.AddMapping("foo", loc, 4);
+        fragments[0].content.Append("a;b;a;");
+        fragments[0].column = 6;
+    }
+    {
+        MappingCollector collector(fragments[1]);
+        collector.AddMapping("bar", loc, 0);
+        collector.AddMapping(loc, 2);
+        fragments[1].content.Append("b;1;");
+        fragments[1].column = 4;
+    }
+
+    // interned in the fragment
+    EXPECT_EQ(fragments[0].names.size(), 2);
+
+    for (auto& fragment : fragments) {
+        module_compositor.Append(fragment);
+    }
+
+    std::string sourcemap;
+    io::StringWriter sourcemap_writer(sourcemap);
+    auto sourcemap_generator = std::make_shared<SourceMapGenerator>(nullptr, sourcemap_writer, "memory0");
+    module_compositor.DumpSourcemap(sourcemap_generator).wait();
+
+    auto sourcemap_json = nlohmann::json::parse(sourcemap);
+    // the tables of the fragments are concatenated
+    EXPECT_EQ(sourcemap_json["names"], nlohmann::json::array({ "foo", "bar", "bar" }));
+
+    SourceMapDecoder decoder(sourcemap_json);
+    auto result = decoder.Decode();
+
+    std::vector<int32_t> expect_names { 0, 1, 0, 2, -1 };
+    ASSERT_EQ(result.content.size(), expect_names.size());
+    for (uint32_t i = 0; i < expect_names.size(); i++) {
+        EXPECT_EQ(result.content[i].name_index, expect_names[i]);
+    }
+    EXPECT_EQ(result.content[3].after_column, 6);
+}
+
+TEST(SourceMap, InputSourceMapURL) {
+    EXPECT_EQ(InputSourceMap::FindURL("a();\n//# sourceMappingURL=a.js.map\n"), "a.js.map");
+    EXPECT_EQ(InputSourceMap::FindURL("a();\n/*# sourceMappingURL=a.js.map */"), "a.js.map");
+    EXPECT_FALSE(InputSourceMap::FindURL("a();\n//# sourceMappingURL=a.js.map\nb();").has_value());
+    EXPECT_FALSE(InputSourceMap::FindURL("let s = 'sourceMappingURL=a.js.map';").has_value());
+
+    auto json = InputSourceMap::DecodeDataURL("data:application/json;charset=utf-8;base64,eyJ2ZXJzaW9uIjozfQ==");
+    ASSERT_TRUE(json.has_value());
+    EXPECT_EQ(*json, "{\"version\":3}");
+}
+
+TEST(SourceMap, InputSourceMap) {
+    ghc::filesystem::path path(JETPACK_TEST_RUNNING_DIR);
+    path.append("tests/fixtures/input_sourcemap/index.js");
+    auto entry_path = path.string();
+
+    ghc::filesystem::path output_path(JETPACK_BUILD_DIR);
+    output_path.append("input_sourcemap_bundle_test.js");
+    std::string output_str = output_path.string();
+
+    JetpackFlags flags;
+    flags |= JETPACK_SOURCEMAP;
+    flags |= JETPACK_TRACE_FILE;
+    EXPECT_EQ(jetpack_bundle_module(entry_path.c_str(), output_str.c_str(), static_cast<int>(flags), nullptr), 0);
+
+    std::string sourcemap_content;
+    EXPECT_EQ(io::ReadFileToStdString(output_str + ".map", sourcemap_content), io::IOError::Ok);
+    auto sourcemap_json = nlohmann::json::parse(sourcemap_content);
+
+    // add.js is replaced by the typescript source
+    ASSERT_EQ(sourcemap_json["sources"].size(), 2);
+    // relative to the map of add.js
+    EXPECT_EQ(sourcemap_json["sources"][1], "src/add.ts");
+
+    ghc::filesystem::path ts_path(JETPACK_TEST_RUNNING_DIR);
+    ts_path.append("tests/fixtures/input_sourcemap/src/add.ts");
+    std::string ts_content;
+    EXPECT_EQ(io::ReadFileToStdString(ts_path.string(), ts_content), io::IOError::Ok);
+    EXPECT_EQ(sourcemap_json["sourcesContent"][1], ts_content);
+
+    // the positions of the input map, in add.ts
+    std::set<std::pair<int32_t, int32_t>> ts_positions {
+            { 2, 0 }, { 2, 16 }, { 2, 20 }, { 2, 31 },
+            { 3, 4 }, { 3, 11 }, { 3, 15 },
+            { 4, 0 },
+    };
+
+    SourceMapDecoder decoder(sourcemap_json);
+    auto result = decoder.Decode();
+    uint32_t ts_count = 0;
+    for (const auto& mapping : result.content) {
+        if (mapping.source_index != 1) {
+            continue;
+        }
+        ts_count++;
+        EXPECT_EQ(ts_positions.count({ mapping.before_line, mapping.before_column }), 1) << mapping.ToString();
+    }
+    EXPECT_GT(ts_count, 0);
+
+    // the names of the input map
+    const auto& names = sourcemap_json["names"];
+    EXPECT_NE(std::find(names.begin(), names.end(), "a"), names.end());
+    EXPECT_NE(std::find(names.begin(), names.end(), "b"), names.end());
+}
+
+TEST(SourceMap, DecodeInPlace) {
+    std::string src(""
+                "function main() {\n"
+                "    console.log('hello world');\n"
+                "    return 'a' + 'b';\n"
+                "}\n"
+    );
+    auto sourcemap = ParseAndGenSourceMap(src, false);
+    auto sourcemap_json = nlohmann::json::parse(sourcemap);
+
+    SourceMapDecoder json_decoder(sourcemap_json);
+    auto expect_result = json_decoder.Decode();
+    SourceMapDecoder decoder(sourcemap);
+    auto result = decoder.Decode();
+
+    EXPECT_FALSE(decoder.Failed());
+    EXPECT_EQ(result.sources, expect_result.sources);
+    EXPECT_EQ(result.names, expect_result.names);
+    EXPECT_EQ(result.line_offsets, expect_result.line_offsets);
+    ASSERT_EQ(result.content.size(), expect_result.content.size());
+    for (uint32_t i = 0; i < result.content.size(); i++) {
+        EXPECT_EQ(result.content[i], expect_result.content[i]);
+    }
+}
+
+TEST(SourceMap, OriginalPositionFor) {
+    // the sourcesContent is skipped, the segments of the 2nd line are not ordered
+    std::string sourcemap(R"({
+  "version": 3,
+  "sourcesContent": ["let s = \"}]\\\"\";", null],
+  "sources": ["a.ts", "b\/c.ts"],
+  "names": ["foo", "bar"],
+  "x_extension": { "nested": [1, { "a": "]" }], "flag": true },
+  "mappings": "AAAAA,IAACC;UCCC,NDDF,U"
+})");
+
+    SourceMapDecoder decoder(sourcemap);
+    auto result = decoder.Decode();
+    ASSERT_FALSE(decoder.Failed());
+    EXPECT_EQ(result.sources, std::vector<std::string>({ "a.ts", "b/c.ts" }));
+    EXPECT_EQ(result.names, std::vector<std::string>({ "foo", "bar" }));
+    EXPECT_TRUE(result.sources_content.empty());
+
+    auto position = result.OriginalPositionFor(1, 0);
+    ASSERT_TRUE(position.has_value());
+    EXPECT_EQ(position->source, "a.ts");
+    EXPECT_EQ(position->line, 1);
+    EXPECT_EQ(position->column, 0);
+    EXPECT_EQ(position->name, "foo");
+
+    // the greatest lower bound on the line
+    position = result.OriginalPositionFor(1, 7);
+    ASSERT_TRUE(position.has_value());
+    EXPECT_EQ(position->column, 1);
+    EXPECT_EQ(position->name, "bar");
+
+    position = result.OriginalPositionFor(2, 5);
+    ASSERT_TRUE(position.has_value());
+    EXPECT_EQ(position->source, "a.ts");
+    EXPECT_EQ(position->column, 0);
+    EXPECT_TRUE(position->name.empty());
+
+    position = result.OriginalPositionFor(2, 10);
+    ASSERT_TRUE(position.has_value());
+    EXPECT_EQ(position->source, "b/c.ts");
+    EXPECT_EQ(position->line, 2);
+
+    // the segment of only the column ends the range
+    EXPECT_FALSE(result.OriginalPositionFor(2, 14).has_value());
+    EXPECT_FALSE(result.OriginalPositionFor(2, 3).has_value());
+    EXPECT_FALSE(result.OriginalPositionFor(3, 0).has_value());
+
+    SourceMapDecoder content_decoder(sourcemap, true);
+    auto content_result = content_decoder.Decode();
+    ASSERT_EQ(content_result.sources_content.size(), 2);
+    EXPECT_EQ(content_result.sources_content[0], "let s = \"}]\\\"\";");
+    EXPECT_FALSE(content_result.sources_content[1].has_value());
+
+    SourceMapDecoder broken_decoder(R"({"sources": [], "mappings": "AA"})");
+    broken_decoder.Decode();
+    EXPECT_TRUE(broken_decoder.Failed());
+}
+